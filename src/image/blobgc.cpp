@@ -0,0 +1,342 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+#include "blobgc.hpp"
+#include "utils/exception.hpp"
+
+namespace aos::common::image {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+fs::path GetBlobPath(const fs::path& blobsDir, const std::string& digest)
+{
+    auto pos = digest.find(':');
+
+    return blobsDir / digest.substr(0, pos) / digest.substr(pos + 1);
+}
+
+uint64_t GetSize(const fs::path& path)
+{
+    std::error_code ec;
+
+    if (!fs::is_directory(path, ec)) {
+        auto size = fs::file_size(path, ec);
+
+        return ec ? 0 : size;
+    }
+
+    uint64_t size = 0;
+
+    for (fs::recursive_directory_iterator it(path, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->is_regular_file(ec)) {
+            size += it->file_size(ec);
+        }
+    }
+
+    return size;
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+BlobGC::BlobGC(fs::path blobsDir, BlobReferencesFunc referencesFunc, BlobRemoveFunc removeFunc, size_t maxParallel)
+    : mBlobsDir(std::move(blobsDir))
+    , mReferencesFunc(std::move(referencesFunc))
+    , mRemoveFunc(std::move(removeFunc))
+    , mMaxParallel(maxParallel != 0 ? maxParallel : std::max(std::thread::hardware_concurrency(), 1u))
+{
+}
+
+void BlobGC::Pin(const std::string& digest)
+{
+    std::unique_lock lock {mPinMutex};
+
+    mPinCondVar.wait(lock, [&]() { return mRemoving != digest; });
+
+    mPins[digest]++;
+}
+
+void BlobGC::Unpin(const std::string& digest)
+{
+    std::lock_guard lock {mPinMutex};
+
+    if (auto it = mPins.find(digest); it != mPins.end() && --it->second == 0) {
+        mPins.erase(it);
+    }
+}
+
+int BlobGC::Mark(const std::vector<std::string>& roots)
+{
+    mMarked.clear();
+    mPending.clear();
+    mStats = BlobGCStats {};
+
+    // Blobs written after this point are kept: they may belong to update in progress.
+    mMarkTime = fs::file_time_type::clock::now();
+
+    std::mutex              mutex;
+    std::condition_variable condVar;
+    std::deque<std::string> queue;
+    size_t                  active    = 0;
+    int                     markError = 0;
+
+    auto addRoot = [&](const std::string& root) {
+        if (mMarked.insert(root).second) {
+            queue.push_back(root);
+        }
+    };
+
+    for (const auto& root : roots) {
+        addRoot(root);
+    }
+
+    {
+        std::lock_guard lock {mPinMutex};
+
+        for (const auto& [digest, count] : mPins) {
+            std::error_code ec;
+
+            // Blob not downloaded yet has no references to traverse.
+            if (mMarked.insert(digest).second && fs::exists(GetBlobPath(mBlobsDir, digest), ec)) {
+                queue.push_back(digest);
+            }
+        }
+    }
+
+    auto markDigests = [&]() {
+        std::unique_lock lock {mutex};
+
+        while (true) {
+            condVar.wait(lock, [&]() { return !queue.empty() || active == 0 || markError != 0; });
+
+            if (queue.empty() || markError != 0) {
+                break;
+            }
+
+            auto digest = std::move(queue.front());
+
+            queue.pop_front();
+            active++;
+
+            lock.unlock();
+
+            std::vector<std::string> references;
+            int                      err = 0;
+
+            try {
+                err = mReferencesFunc(digest, references);
+            } catch (...) {
+                err = utils::GetExceptionError(std::current_exception());
+            }
+
+            lock.lock();
+
+            active--;
+
+            if (err != 0 && markError == 0) {
+                markError = err;
+            }
+
+            for (auto& reference : references) {
+                if (mMarked.insert(reference).second) {
+                    queue.push_back(std::move(reference));
+                }
+            }
+
+            condVar.notify_all();
+        }
+    };
+
+    // Exception must not leave worker thread: it would terminate the process.
+    auto worker = [&]() {
+        try {
+            markDigests();
+        } catch (...) {
+            std::lock_guard lock {mutex};
+
+            if (markError == 0) {
+                markError = utils::GetExceptionError(std::current_exception());
+            }
+
+            condVar.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    // Current thread is one of the workers: marking proceeds with fewer threads if thread creation fails.
+    for (size_t i = 1; i < mMaxParallel; i++) {
+        try {
+            threads.emplace_back(worker);
+        } catch (const std::system_error&) {
+            break;
+        }
+    }
+
+    worker();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (markError != 0) {
+        // Incomplete reference set: sweeping would remove blobs in use.
+        mMarked.clear();
+
+        return markError;
+    }
+
+    mStats.mMarked = mMarked.size();
+
+    std::error_code ec;
+
+    for (fs::directory_iterator algIt(mBlobsDir, ec), end; !ec && algIt != end; algIt.increment(ec)) {
+        if (!algIt->is_directory(ec)) {
+            continue;
+        }
+
+        auto algorithm = algIt->path().filename().string();
+
+        for (fs::directory_iterator it(algIt->path(), ec); !ec && it != end; it.increment(ec)) {
+            mPending.push_back(algorithm + ":" + it->path().filename().string());
+        }
+    }
+
+    if (ec) {
+        mPending.clear();
+
+        return ec.value();
+    }
+
+    return 0;
+}
+
+int BlobGC::Sweep(std::chrono::milliseconds budget, bool& done)
+{
+    auto deadline = std::chrono::steady_clock::now() + budget;
+
+    std::vector<std::string> candidates;
+
+    {
+        std::lock_guard lock {mPinMutex};
+
+        for (; !mPending.empty(); mPending.pop_back()) {
+            auto& digest = mPending.back();
+
+            mStats.mScanned++;
+
+            // Pinned after mark: blob belongs to update in progress.
+            if (mMarked.count(digest) == 0 && mPins.count(digest) == 0) {
+                candidates.push_back(std::move(digest));
+            }
+        }
+    }
+
+    // At least one blob is processed per call, so sweep always progresses.
+    for (size_t i = 0; i < candidates.size(); i++) {
+        if (i != 0 && std::chrono::steady_clock::now() >= deadline) {
+            mPending.insert(mPending.end(), std::make_move_iterator(candidates.begin() + i),
+                std::make_move_iterator(candidates.end()));
+            done = false;
+
+            return 0;
+        }
+
+        const auto& digest = candidates[i];
+
+        {
+            std::lock_guard lock {mPinMutex};
+
+            if (mPins.count(digest) != 0) {
+                continue;
+            }
+
+            mRemoving = digest;
+        }
+
+        auto err = RemoveBlob(digest);
+
+        {
+            std::lock_guard lock {mPinMutex};
+
+            mRemoving.clear();
+        }
+
+        mPinCondVar.notify_all();
+
+        if (err != 0) {
+            mPending.insert(mPending.end(), std::make_move_iterator(candidates.begin() + i + 1),
+                std::make_move_iterator(candidates.end()));
+            done = false;
+
+            return err;
+        }
+    }
+
+    done = true;
+
+    return 0;
+}
+
+/***********************************************************************************************************************
+ * Private
+ **********************************************************************************************************************/
+
+int BlobGC::RemoveBlob(const std::string& digest)
+{
+    auto path = GetBlobPath(mBlobsDir, digest);
+
+    std::error_code ec;
+
+    auto writeTime = fs::last_write_time(path, ec);
+    if (ec || writeTime >= mMarkTime) {
+        return 0;
+    }
+
+    auto size = GetSize(path);
+
+    int err = 0;
+
+    // Exception must not leave the blob claimed: its Pin would wait forever.
+    try {
+        if (mRemoveFunc) {
+            err = mRemoveFunc(path);
+        } else if (fs::remove_all(path, ec); ec) {
+            err = ec.value();
+        }
+    } catch (...) {
+        err = utils::GetExceptionError(std::current_exception());
+    }
+
+    if (err != 0) {
+        return err;
+    }
+
+    mStats.mRemoved++;
+    mStats.mRemovedBytes += size;
+
+    return 0;
+}
+
+} // namespace aos::common::image
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef BLOBGC_HPP_
+#define BLOBGC_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace aos::common::image {
+
+/**
+ * Returns digests referenced by blob: manifest references config and layers, index references manifests. Leaf blobs
+ * return no references. Called concurrently from mark workers.
+ *
+ * Returns 0 on success or errno value on failure.
+ */
+using BlobReferencesFunc = std::function<int(const std::string& digest, std::vector<std::string>& references)>;
+
+/**
+ * Removes unreferenced blob, e.g. by passing it to background remover.
+ *
+ * Pin of the blob waits only for the call itself: background remover must move the blob out of blobs directory, e.g.
+ * rename it into trash directory, before returning. Otherwise blob pinned right after the call may still be removed.
+ *
+ * Returns 0 on success or errno value on failure.
+ */
+using BlobRemoveFunc = std::function<int(const std::filesystem::path& path)>;
+
+/**
+ * Blob garbage collector statistics.
+ */
+struct BlobGCStats {
+    size_t   mMarked       = 0;
+    size_t   mScanned      = 0;
+    size_t   mRemoved      = 0;
+    uint64_t mRemovedBytes = 0;
+};
+
+/**
+ * Mark-and-sweep garbage collector for OCI layout blob storage: <blobs dir>/<algorithm>/<encoded digest>.
+ *
+ * Mark phase expands root digests to the full reference set using a pool of workers. Sweep phase is incremental:
+ * each Sweep call processes blobs until its time budget is exhausted, so collection can be interleaved with update
+ * processing.
+ *
+ * Blobs of an update in progress are not reachable from roots yet: the update must pin each blob before downloading or
+ * reusing it and unpin it once the blob is referenced by a root or abandoned. Pinned blobs are marked together with
+ * their references and are skipped by sweep, including blobs pinned while sweep is in progress: Pin of the blob being
+ * removed waits until remove function returns, see BlobRemoveFunc. Pinned blobs which are not downloaded yet are marked
+ * without their references: the update pins the references as well. As an extra safeguard blobs modified after mark
+ * start are kept.
+ */
+class BlobGC {
+public:
+    /**
+     * Creates blob garbage collector.
+     *
+     * @param blobsDir blobs directory.
+     * @param referencesFunc blob references function.
+     * @param removeFunc blob remove function, blob is removed synchronously if not set.
+     * @param maxParallel max number of mark workers, 0 means number of CPUs.
+     */
+    BlobGC(std::filesystem::path blobsDir, BlobReferencesFunc referencesFunc, BlobRemoveFunc removeFunc = {},
+        size_t maxParallel = 0);
+
+    /**
+     * Pins blob: protects it and its references from collection. Pins are counted.
+     *
+     * Thread safe. Blob removed by sweep before pinning is absent after Pin returns: if sweep is removing the blob,
+     * Pin waits for the removal.
+     *
+     * @param digest blob digest.
+     */
+    void Pin(const std::string& digest);
+
+    /**
+     * Unpins blob.
+     *
+     * Thread safe.
+     *
+     * @param digest blob digest.
+     */
+    void Unpin(const std::string& digest);
+
+    /**
+     * Builds reference set from roots and pinned blobs and prepares sweep.
+     *
+     * @param roots root digests: manifests or indexes of all images in use.
+     * @return int.
+     */
+    int Mark(const std::vector<std::string>& roots);
+
+    /**
+     * Removes unreferenced blobs within time budget.
+     *
+     * @param budget time budget.
+     * @param[out] done true if sweep is finished.
+     * @return int.
+     */
+    int Sweep(std::chrono::milliseconds budget, bool& done);
+
+    /**
+     * Returns statistics of the current collection cycle.
+     *
+     * @return const BlobGCStats&.
+     */
+    const BlobGCStats& GetStats() const { return mStats; }
+
+private:
+    int RemoveBlob(const std::string& digest);
+
+    std::filesystem::path           mBlobsDir;
+    BlobReferencesFunc              mReferencesFunc;
+    BlobRemoveFunc                  mRemoveFunc;
+    size_t                          mMaxParallel;
+    std::unordered_set<std::string> mMarked;
+    std::vector<std::string>        mPending;
+    std::filesystem::file_time_type mMarkTime;
+    BlobGCStats                     mStats;
+    std::mutex                              mPinMutex;
+    std::condition_variable                 mPinCondVar;
+    std::unordered_map<std::string, size_t> mPins;
+    // Blob being removed by sweep: Pin of it waits for the removal to complete.
+    std::string mRemoving;
+};
+
+} // namespace aos::common::image
+
+#endif
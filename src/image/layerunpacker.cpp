@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <exception>
+#include <filesystem>
+#include <system_error>
+#include <thread>
+
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <sys/xattr.h>
+
+#include "layerunpacker.hpp"
+#include "utils/exception.hpp"
+
+namespace aos::common::image {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/***********************************************************************************************************************
+ * Consts
+ **********************************************************************************************************************/
+
+constexpr std::string_view cWhiteoutPrefix = ".wh.";
+constexpr std::string_view cOpaqueWhiteout = ".wh..wh..opq";
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+int SetOpaque(const fs::path& dir, const std::string& opaqueXattr)
+{
+    if (setxattr(dir.c_str(), opaqueXattr.c_str(), "y", 1, 0) != 0) {
+        return errno;
+    }
+
+    return 0;
+}
+
+int CreateWhiteout(const fs::path& path, const std::string& opaqueXattr)
+{
+    struct stat st {};
+
+    if (lstat(path.c_str(), &st) != 0) {
+        if (errno != ENOENT) {
+            return errno;
+        }
+
+        if (mknod(path.c_str(), S_IFCHR | 0, makedev(0, 0)) != 0) {
+            return errno;
+        }
+
+        return 0;
+    }
+
+    // OCI whiteout applies to lower layers only: entry added by the same layer is kept. It hides lower entry by
+    // itself, except directory which would be merged with lower one.
+    if (S_ISDIR(st.st_mode)) {
+        return SetOpaque(path, opaqueXattr);
+    }
+
+    return 0;
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+int ConvertWhiteouts(const std::string& layerDir, const std::string& opaqueXattr)
+{
+    std::vector<fs::path> whiteouts;
+    std::error_code       ec;
+
+    // Collect first: modifying directory while iterating is unspecified.
+    for (fs::recursive_directory_iterator it(layerDir, ec), end; !ec && it != end; it.increment(ec)) {
+        auto name = it->path().filename().native();
+
+        if (name.compare(0, cWhiteoutPrefix.size(), cWhiteoutPrefix) == 0) {
+            whiteouts.push_back(it->path());
+        }
+    }
+
+    if (ec) {
+        return ec.value();
+    }
+
+    for (const auto& whiteout : whiteouts) {
+        auto name   = whiteout.filename().native();
+        auto parent = whiteout.parent_path();
+
+        // Whiteout which is already gone is not an error.
+        if (!fs::remove(whiteout, ec) && ec) {
+            return ec.value();
+        }
+
+        auto err = name == cOpaqueWhiteout ? SetOpaque(parent, opaqueXattr)
+                                           : CreateWhiteout(parent / name.substr(cWhiteoutPrefix.size()), opaqueXattr);
+        if (err != 0) {
+            return err;
+        }
+    }
+
+    return 0;
+}
+
+LayerUnpacker::LayerUnpacker(LayerUnpackFunc unpackFunc, size_t maxParallel, std::string opaqueXattr)
+    : mUnpackFunc(std::move(unpackFunc))
+    , mMaxParallel(maxParallel != 0 ? maxParallel : std::max(std::thread::hardware_concurrency(), 1u))
+    , mOpaqueXattr(std::move(opaqueXattr))
+{
+}
+
+int LayerUnpacker::Unpack(const std::vector<LayerUnpackInfo>& layers, const LayerProgressFunc& progress)
+{
+    std::atomic_size_t next {0};
+    std::atomic_int    firstError {0};
+
+    auto notify = [&progress](size_t index, LayerUnpackState state, int error) {
+        if (!progress) {
+            return;
+        }
+
+        try {
+            progress(index, state, error);
+        } catch (...) {
+            // Progress is informational: callback failure does not fail unpacking.
+        }
+    };
+
+    auto worker = [&]() {
+        for (auto index = next++; index < layers.size() && firstError == 0; index = next++) {
+            const auto& layer = layers[index];
+
+            auto err = 0;
+
+            // Exception must not leave worker thread: it would terminate the process.
+            notify(index, LayerUnpackState::eStarted, 0);
+
+            try {
+                if (err = mUnpackFunc(layer.mArchivePath, layer.mDestination); err == 0) {
+                    err = ConvertWhiteouts(layer.mDestination, mOpaqueXattr);
+                }
+            } catch (...) {
+                err = utils::GetExceptionError(std::current_exception());
+            }
+
+            if (err != 0) {
+                int expected = 0;
+
+                firstError.compare_exchange_strong(expected, err);
+                notify(index, LayerUnpackState::eFailed, err);
+
+                continue;
+            }
+
+            notify(index, LayerUnpackState::eUnpacked, 0);
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    // Current thread is one of the workers: unpacking proceeds with fewer threads if thread creation fails.
+    for (size_t i = 1; i < std::min(mMaxParallel, layers.size()); i++) {
+        try {
+            threads.emplace_back(worker);
+        } catch (const std::system_error&) {
+            break;
+        }
+    }
+
+    worker();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return firstError;
+}
+
+} // namespace aos::common::image
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LAYERUNPACKER_HPP_
+#define LAYERUNPACKER_HPP_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace aos::common::image {
+
+/**
+ * Layer to unpack.
+ */
+struct LayerUnpackInfo {
+    std::string mArchivePath;
+    std::string mDestination;
+};
+
+/**
+ * Layer unpack state.
+ */
+enum class LayerUnpackState { eStarted, eUnpacked, eFailed };
+
+/**
+ * Unpacks single layer archive into destination directory.
+ *
+ * Returns 0 on success or errno value on failure.
+ */
+using LayerUnpackFunc = std::function<int(const std::string& archivePath, const std::string& destination)>;
+
+/**
+ * Layer progress callback: layer index, state and error. Called from unpack worker threads, exceptions are ignored.
+ */
+using LayerProgressFunc = std::function<void(size_t index, LayerUnpackState state, int error)>;
+
+/**
+ * Unpacks image layers concurrently.
+ *
+ * Each layer is unpacked into own directory to be used as overlayfs lower dir, so layers don't depend on each other.
+ * After unpacking, OCI whiteouts of the layer are converted to overlayfs format: ".wh.<name>" files are replaced by
+ * 0/0 character devices and ".wh..wh..opq" markers by opaque directory xattr. Entries added by the same layer are
+ * kept, as OCI whiteouts apply to lower layers only. Unpack function exceptions are reported as layer errors.
+ */
+class LayerUnpacker {
+public:
+    /**
+     * Creates layer unpacker.
+     *
+     * @param unpackFunc single layer unpack function.
+     * @param maxParallel max number of layers unpacked at once, 0 means number of CPUs.
+     * @param opaqueXattr opaque dir xattr: "trusted.overlay.opaque" or "user.overlay.opaque" for userxattr mounts.
+     */
+    explicit LayerUnpacker(
+        LayerUnpackFunc unpackFunc, size_t maxParallel = 0, std::string opaqueXattr = "trusted.overlay.opaque");
+
+    /**
+     * Unpacks layers.
+     *
+     * No new layers are started after first failure, already started layers are finished.
+     *
+     * @param layers layers.
+     * @param progress optional progress callback.
+     * @return int 0 on success or error of first failed layer.
+     */
+    int Unpack(const std::vector<LayerUnpackInfo>& layers, const LayerProgressFunc& progress = {});
+
+private:
+    LayerUnpackFunc mUnpackFunc;
+    size_t          mMaxParallel;
+    std::string     mOpaqueXattr;
+};
+
+/**
+ * Converts OCI whiteouts in unpacked layer directory to overlayfs whiteouts.
+ *
+ * @param layerDir unpacked layer directory.
+ * @param opaqueXattr opaque dir xattr name.
+ * @return int 0 on success or errno value on failure.
+ */
+int ConvertWhiteouts(const std::string& layerDir, const std::string& opaqueXattr = "trusted.overlay.opaque");
+
+} // namespace aos::common::image
+
+#endif
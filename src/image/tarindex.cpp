@@ -0,0 +1,606 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <optional>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tarindex.hpp"
+#include "utils/atomicfile.hpp"
+
+namespace aos::common::image {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Consts
+ **********************************************************************************************************************/
+
+constexpr uint64_t         cBlockSize      = 512;
+constexpr uint64_t         cMaxMemberSize  = std::numeric_limits<uint64_t>::max() - (cBlockSize - 1);
+constexpr size_t           cCopyBufferSize = 64 * 1024;
+constexpr size_t           cMaxHardLinks   = 16;
+constexpr std::string_view cIndexSuffix    = ".idx";
+constexpr std::string_view cIndexSignature = "aostarindex 1";
+constexpr std::string_view cUstarMagic {"ustar\0", 6};
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+class FileCloser {
+public:
+    explicit FileCloser(int fd)
+        : mFD(fd)
+    {
+    }
+
+    ~FileCloser()
+    {
+        if (mFD >= 0) {
+            close(mFD);
+        }
+    }
+
+    FileCloser(const FileCloser&)            = delete;
+    FileCloser& operator=(const FileCloser&) = delete;
+
+private:
+    int mFD;
+};
+
+int ReadAt(int fd, char* buffer, size_t size, uint64_t offset)
+{
+    while (size > 0) {
+        auto n = pread(fd, buffer, size, static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return errno;
+        }
+
+        if (n == 0) {
+            return EIO;
+        }
+
+        buffer += n;
+        size -= static_cast<size_t>(n);
+        offset += static_cast<uint64_t>(n);
+    }
+
+    return 0;
+}
+
+int WriteAll(int fd, const char* buffer, size_t size)
+{
+    while (size > 0) {
+        auto n = write(fd, buffer, size);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return errno;
+        }
+
+        buffer += n;
+        size -= static_cast<size_t>(n);
+    }
+
+    return 0;
+}
+
+uint64_t RoundUp(uint64_t size)
+{
+    return (size + cBlockSize - 1) / cBlockSize * cBlockSize;
+}
+
+std::string_view GetField(const char* header, size_t offset, size_t size)
+{
+    std::string_view field(header + offset, size);
+
+    return field.substr(0, field.find('\0'));
+}
+
+bool ParseNumeric(const char* field, size_t size, uint64_t& value)
+{
+    value = 0;
+
+    // GNU base-256 encoding for big values.
+    if (static_cast<unsigned char>(field[0]) & 0x80) {
+        value = static_cast<unsigned char>(field[0]) & 0x7f;
+
+        for (size_t i = 1; i < size; i++) {
+            value = (value << 8) | static_cast<unsigned char>(field[i]);
+        }
+
+        return true;
+    }
+
+    size_t i = 0;
+
+    while (i < size && field[i] == ' ') {
+        i++;
+    }
+
+    for (; i < size && field[i] >= '0' && field[i] <= '7'; i++) {
+        value = (value << 3) | static_cast<uint64_t>(field[i] - '0');
+    }
+
+    return i == size || field[i] == '\0' || field[i] == ' ';
+}
+
+bool VerifyChecksum(const char* header)
+{
+    uint64_t expected = 0;
+
+    if (!ParseNumeric(header + 148, 8, expected)) {
+        return false;
+    }
+
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < cBlockSize; i++) {
+        sum += (i >= 148 && i < 156) ? ' ' : static_cast<unsigned char>(header[i]);
+    }
+
+    return sum == expected;
+}
+
+bool IsZeroBlock(const char* header)
+{
+    for (size_t i = 0; i < cBlockSize; i++) {
+        if (header[i] != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::string NormalizeName(std::string_view name)
+{
+    while (name.substr(0, 2) == "./") {
+        name.remove_prefix(2);
+    }
+
+    while (name.size() > 1 && name.back() == '/') {
+        name.remove_suffix(1);
+    }
+
+    return std::string(name);
+}
+
+struct PaxRecords {
+    std::optional<std::string> mPath;
+    std::optional<std::string> mLinkPath;
+    std::optional<uint64_t>    mSize;
+};
+
+void ParsePaxRecords(std::string_view data, PaxRecords& records)
+{
+    // Record format: "<length> <key>=<value>\n", length includes itself.
+    while (!data.empty()) {
+        auto space = data.find(' ');
+        if (space == std::string_view::npos) {
+            return;
+        }
+
+        auto length = strtoull(std::string(data.substr(0, space)).c_str(), nullptr, 10);
+        if (length <= space + 1 || length > data.size()) {
+            return;
+        }
+
+        auto record = data.substr(space + 1, length - space - 2);
+        auto eq     = record.find('=');
+
+        data.remove_prefix(length);
+
+        if (eq == std::string_view::npos) {
+            continue;
+        }
+
+        auto key   = record.substr(0, eq);
+        auto value = record.substr(eq + 1);
+
+        if (key == "path") {
+            records.mPath = std::string(value);
+        } else if (key == "linkpath") {
+            records.mLinkPath = std::string(value);
+        } else if (key == "size") {
+            records.mSize = strtoull(std::string(value).c_str(), nullptr, 10);
+        }
+    }
+}
+
+bool HasData(char type)
+{
+    // Hard links and special files have no data even if size is set.
+    return type != '1' && type != '2' && type != '3' && type != '4' && type != '5';
+}
+
+bool IsRegular(char type)
+{
+    return type == '0' || type == '7';
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+int TarIndex::Load(const std::string& archivePath)
+{
+    mArchivePath = archivePath;
+
+    uint64_t archiveSize  = 0;
+    int64_t  archiveMTime = 0;
+
+    if (auto err = GetArchiveStat(archiveSize, archiveMTime); err != 0) {
+        return err;
+    }
+
+    if (ReadIndex(archiveSize, archiveMTime) == 0) {
+        return 0;
+    }
+
+    if (auto err = Build(archivePath); err != 0) {
+        return err;
+    }
+
+    return Save();
+}
+
+int TarIndex::Build(const std::string& archivePath)
+{
+    mArchivePath = archivePath;
+    mMembers.clear();
+    mLookup.clear();
+
+    if (auto err = GetArchiveStat(mArchiveSize, mArchiveMTime); err != 0) {
+        return err;
+    }
+
+    auto fd = open(archivePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return errno;
+    }
+
+    FileCloser closer(fd);
+
+    char        header[cBlockSize];
+    uint64_t    offset = 0;
+    std::string longName, longLink;
+    PaxRecords  pax;
+
+    while (offset + cBlockSize <= mArchiveSize) {
+        if (auto err = ReadAt(fd, header, cBlockSize, offset); err != 0) {
+            return err;
+        }
+
+        if (IsZeroBlock(header)) {
+            break;
+        }
+
+        if (!VerifyChecksum(header)) {
+            return EINVAL;
+        }
+
+        uint64_t size = 0;
+
+        if (!ParseNumeric(header + 124, 12, size)) {
+            return EINVAL;
+        }
+
+        auto type       = header[156] == '\0' ? '0' : header[156];
+        auto dataOffset = offset + cBlockSize;
+
+        // PAX extended header applies to the next member only, not to global or other extension headers.
+        if (pax.mSize && type != 'x' && type != 'g' && type != 'L' && type != 'K') {
+            size = *pax.mSize;
+        }
+
+        // Size comes from base-256 or PAX field and may be up to 2^64 - 1: compare without wrap, and reject sizes
+        // which RoundUp can't round.
+        if (dataOffset > mArchiveSize || size > mArchiveSize - dataOffset || size > cMaxMemberSize) {
+            return EINVAL;
+        }
+
+        switch (type) {
+        case 'L':
+        case 'K':
+        case 'x': {
+            std::string data(size, '\0');
+
+            if (auto err = ReadAt(fd, data.data(), size, dataOffset); err != 0) {
+                return err;
+            }
+
+            if (type == 'x') {
+                ParsePaxRecords(data, pax);
+            } else {
+                (type == 'L' ? longName : longLink) = data.substr(0, data.find('\0'));
+            }
+
+            break;
+        }
+
+        case 'g':
+            break;
+
+        default: {
+            TarMember member;
+
+            if (pax.mPath) {
+                member.mName = *pax.mPath;
+            } else if (!longName.empty()) {
+                member.mName = longName;
+            } else {
+                auto name   = GetField(header, 0, 100);
+                auto prefix = GetField(header, 345, 155);
+
+                // Prefix field is valid only for ustar archives: GNU magic "ustar " stores times at its offset.
+                member.mName = (std::string_view(header + 257, 6) == cUstarMagic && !prefix.empty())
+                    ? std::string(prefix) + "/" + std::string(name)
+                    : std::string(name);
+            }
+
+            member.mLinkName = pax.mLinkPath ? *pax.mLinkPath
+                                             : (!longLink.empty() ? longLink : std::string(GetField(header, 157, 100)));
+            member.mName     = NormalizeName(member.mName);
+            member.mOffset   = dataOffset;
+            member.mSize     = size;
+            member.mType     = type;
+
+            if (type == '1') {
+                member.mLinkName = NormalizeName(member.mLinkName);
+            }
+
+            mMembers.push_back(std::move(member));
+
+            longName.clear();
+            longLink.clear();
+            pax = PaxRecords {};
+        }
+        }
+
+        offset = dataOffset + (HasData(type) ? RoundUp(size) : 0);
+    }
+
+    BuildLookup();
+
+    return 0;
+}
+
+int TarIndex::Save() const
+{
+    std::string data;
+
+    data.append(cIndexSignature)
+        .append(" ")
+        .append(std::to_string(mArchiveSize))
+        .append(" ")
+        .append(std::to_string(mArchiveMTime))
+        .append("\n");
+
+    for (const auto& member : mMembers) {
+        data.append(std::to_string(member.mOffset))
+            .append(" ")
+            .append(std::to_string(member.mSize))
+            .append(" ")
+            .append(1, member.mType)
+            .append(" ")
+            .append(std::to_string(member.mName.size()))
+            .append(" ")
+            .append(std::to_string(member.mLinkName.size()))
+            .append(" ")
+            .append(member.mName)
+            .append(member.mLinkName)
+            .append("\n");
+    }
+
+    // Atomic replace: readers, also other processes, see either old or new index.
+    return utils::WriteFileAtomically(mArchivePath + std::string(cIndexSuffix), data);
+}
+
+const TarMember* TarIndex::Find(std::string_view name) const
+{
+    auto it = mLookup.find(NormalizeName(name));
+    if (it == mLookup.end()) {
+        return nullptr;
+    }
+
+    return &mMembers[it->second];
+}
+
+int TarIndex::ExtractFile(std::string_view name, std::string& content) const
+{
+    auto member = FindRegular(name);
+    if (member == nullptr) {
+        return ENOENT;
+    }
+
+    auto fd = open(mArchivePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return errno;
+    }
+
+    FileCloser closer(fd);
+
+    content.resize(member->mSize);
+
+    return ReadAt(fd, content.data(), content.size(), member->mOffset);
+}
+
+int TarIndex::ExtractFile(std::string_view name, const std::string& dstPath) const
+{
+    auto member = FindRegular(name);
+    if (member == nullptr) {
+        return ENOENT;
+    }
+
+    auto srcFD = open(mArchivePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (srcFD < 0) {
+        return errno;
+    }
+
+    FileCloser srcCloser(srcFD);
+
+    auto dstFD = open(dstPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (dstFD < 0) {
+        return errno;
+    }
+
+    FileCloser dstCloser(dstFD);
+
+    std::vector<char> buffer(std::min<uint64_t>(member->mSize, cCopyBufferSize));
+
+    for (uint64_t copied = 0; copied < member->mSize;) {
+        auto chunk = std::min<uint64_t>(member->mSize - copied, buffer.size());
+
+        if (auto err = ReadAt(srcFD, buffer.data(), chunk, member->mOffset + copied); err != 0) {
+            return err;
+        }
+
+        if (auto err = WriteAll(dstFD, buffer.data(), chunk); err != 0) {
+            return err;
+        }
+
+        copied += chunk;
+    }
+
+    return 0;
+}
+
+/***********************************************************************************************************************
+ * Private
+ **********************************************************************************************************************/
+
+int TarIndex::ReadIndex(uint64_t archiveSize, int64_t archiveMTime)
+{
+    auto indexPath = mArchivePath + std::string(cIndexSuffix);
+
+    auto fd = open(indexPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return errno;
+    }
+
+    FileCloser  closer(fd);
+    struct stat st {};
+
+    if (fstat(fd, &st) != 0) {
+        return errno;
+    }
+
+    std::string data(static_cast<size_t>(st.st_size), '\0');
+
+    if (auto err = ReadAt(fd, data.data(), data.size(), 0); err != 0) {
+        return err;
+    }
+
+    // Header: "<signature> <archive size> <archive mtime>\n".
+    uint64_t  size  = 0;
+    long long mtime = 0;
+    int       pos   = 0;
+
+    if (data.compare(0, cIndexSignature.size(), cIndexSignature) != 0
+        || sscanf(data.c_str() + cIndexSignature.size(), " %" SCNu64 " %lld\n%n", &size, &mtime, &pos) != 2
+        || pos == 0) {
+        return EINVAL;
+    }
+
+    // Stale index: archive was modified after index was built.
+    if (size != archiveSize || mtime != archiveMTime) {
+        return ESTALE;
+    }
+
+    std::vector<TarMember> members;
+    std::string_view       entries(data);
+
+    entries.remove_prefix(cIndexSignature.size() + static_cast<size_t>(pos));
+
+    // Entry: "<offset> <size> <type> <name length> <link length> <name><link>\n".
+    while (!entries.empty()) {
+        TarMember member;
+        size_t    nameLen = 0, linkLen = 0;
+        int       namePos = 0;
+
+        auto line = std::string(entries.substr(0, entries.find('\n')));
+
+        // No whitespace directive before %n: it would skip leading spaces of the name.
+        if (sscanf(line.c_str(), "%" SCNu64 " %" SCNu64 " %c %zu %zu%n", &member.mOffset, &member.mSize,
+                &member.mType, &nameLen, &linkLen, &namePos)
+                != 5
+            || line[namePos] != ' ' || static_cast<size_t>(++namePos) + nameLen + linkLen >= entries.size()) {
+            return EINVAL;
+        }
+
+        member.mName     = entries.substr(namePos, nameLen);
+        member.mLinkName = entries.substr(namePos + nameLen, linkLen);
+
+        members.push_back(std::move(member));
+        entries.remove_prefix(static_cast<size_t>(namePos) + nameLen + linkLen + 1);
+    }
+
+    mMembers      = std::move(members);
+    mArchiveSize  = archiveSize;
+    mArchiveMTime = archiveMTime;
+
+    BuildLookup();
+
+    return 0;
+}
+
+const TarMember* TarIndex::FindRegular(std::string_view name) const
+{
+    auto member = Find(name);
+
+    // Hard link data is stored with link target.
+    for (size_t i = 0; member != nullptr && member->mType == '1' && i < cMaxHardLinks; i++) {
+        member = Find(member->mLinkName);
+    }
+
+    return member != nullptr && IsRegular(member->mType) ? member : nullptr;
+}
+
+int TarIndex::GetArchiveStat(uint64_t& size, int64_t& mtime) const
+{
+    struct stat st {};
+
+    if (stat(mArchivePath.c_str(), &st) != 0) {
+        return errno;
+    }
+
+    size  = static_cast<uint64_t>(st.st_size);
+    mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+
+    return 0;
+}
+
+void TarIndex::BuildLookup()
+{
+    mLookup.clear();
+
+    // Later entries override earlier ones as on extraction.
+    for (size_t i = 0; i < mMembers.size(); i++) {
+        mLookup[mMembers[i].mName] = i;
+    }
+}
+
+} // namespace aos::common::image
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TARINDEX_HPP_
+#define TARINDEX_HPP_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace aos::common::image {
+
+/**
+ * Tar archive member.
+ */
+struct TarMember {
+    std::string mName;
+    std::string mLinkName;
+    uint64_t    mOffset = 0;
+    uint64_t    mSize   = 0;
+    char        mType   = '0';
+};
+
+/**
+ * Tar archive member index.
+ *
+ * Index is built by reading member headers only and is persisted next to the archive as "<archive>.idx" together with
+ * archive size and modification time to detect stale index. Single member extraction reads only member data.
+ * Supports ustar, GNU long names and PAX path/size records. Compressed archives are not supported.
+ *
+ * Methods return 0 on success or errno value on failure.
+ */
+class TarIndex {
+public:
+    /**
+     * Loads persisted index or builds and persists new one if missing or stale.
+     *
+     * @param archivePath archive path.
+     * @return int.
+     */
+    int Load(const std::string& archivePath);
+
+    /**
+     * Builds index by scanning archive headers.
+     *
+     * @param archivePath archive path.
+     * @return int.
+     */
+    int Build(const std::string& archivePath);
+
+    /**
+     * Persists index next to the archive.
+     *
+     * @return int.
+     */
+    int Save() const;
+
+    /**
+     * Finds member by name.
+     *
+     * @param name member name, leading "./" is ignored.
+     * @return const TarMember* nullptr if not found.
+     */
+    const TarMember* Find(std::string_view name) const;
+
+    /**
+     * Extracts regular file member content.
+     *
+     * @param name member name.
+     * @param[out] content file content.
+     * @return int.
+     */
+    int ExtractFile(std::string_view name, std::string& content) const;
+
+    /**
+     * Extracts regular file member to file.
+     *
+     * @param name member name.
+     * @param dstPath destination file path.
+     * @return int.
+     */
+    int ExtractFile(std::string_view name, const std::string& dstPath) const;
+
+    /**
+     * Returns archive members in archive order.
+     *
+     * @return const std::vector<TarMember>&.
+     */
+    const std::vector<TarMember>& GetMembers() const { return mMembers; }
+
+private:
+    int              ReadIndex(uint64_t archiveSize, int64_t archiveMTime);
+    const TarMember* FindRegular(std::string_view name) const;
+    int              GetArchiveStat(uint64_t& size, int64_t& mtime) const;
+    void             BuildLookup();
+
+    std::string                             mArchivePath;
+    uint64_t                                mArchiveSize  = 0;
+    int64_t                                 mArchiveMTime = 0;
+    std::vector<TarMember>                  mMembers;
+    std::unordered_map<std::string, size_t> mLookup;
+};
+
+} // namespace aos::common::image
+
+#endif
@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <map>
+#include <stdexcept>
+#include <thread>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "image/blobgc.hpp"
+
+using namespace testing;
+
+namespace aos::common::image {
+
+namespace fs = std::filesystem;
+
+/***********************************************************************************************************************
+ * Suite
+ **********************************************************************************************************************/
+
+class BlobGCTest : public Test {
+protected:
+    void SetUp() override
+    {
+        mDir = fs::temp_directory_path() / ("blobgc_test_" + std::to_string(getpid()));
+
+        fs::remove_all(mDir);
+        fs::create_directories(mDir / "sha256");
+    }
+
+    void TearDown() override { fs::remove_all(mDir); }
+
+    void CreateBlob(const std::string& digest, const std::vector<std::string>& references = {})
+    {
+        auto path = mDir / "sha256" / digest.substr(digest.find(':') + 1);
+
+        std::ofstream(path) << digest;
+
+        // Blobs are written before collection starts.
+        fs::last_write_time(path, fs::file_time_type::clock::now() - std::chrono::hours(1));
+
+        mReferences[digest] = references;
+    }
+
+    bool BlobExists(const std::string& digest) const
+    {
+        return fs::exists(mDir / "sha256" / digest.substr(digest.find(':') + 1));
+    }
+
+    int GetReferences(const std::string& digest, std::vector<std::string>& references) const
+    {
+        auto it = mReferences.find(digest);
+        if (it == mReferences.end()) {
+            return ENOENT;
+        }
+
+        references = it->second;
+
+        return 0;
+    }
+
+    int Collect(BlobGC& gc, const std::vector<std::string>& roots)
+    {
+        if (auto err = gc.Mark(roots); err != 0) {
+            return err;
+        }
+
+        for (auto done = false; !done;) {
+            if (auto err = gc.Sweep(std::chrono::milliseconds(10), done); err != 0) {
+                return err;
+            }
+        }
+
+        return 0;
+    }
+
+    fs::path                                        mDir;
+    std::map<std::string, std::vector<std::string>> mReferences;
+};
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST_F(BlobGCTest, RemovesUnreferencedBlobs)
+{
+    CreateBlob("sha256:index", {"sha256:manifest"});
+    CreateBlob("sha256:manifest", {"sha256:config", "sha256:layer1"});
+    CreateBlob("sha256:config");
+    CreateBlob("sha256:layer1");
+    CreateBlob("sha256:old");
+
+    BlobGC gc(mDir, [this](const std::string& digest, std::vector<std::string>& references) {
+        return GetReferences(digest, references);
+    });
+
+    ASSERT_EQ(Collect(gc, {"sha256:index"}), 0);
+
+    EXPECT_EQ(gc.GetStats().mMarked, 4);
+    EXPECT_EQ(gc.GetStats().mRemoved, 1);
+    EXPECT_FALSE(BlobExists("sha256:old"));
+    EXPECT_TRUE(BlobExists("sha256:layer1"));
+}
+
+TEST_F(BlobGCTest, KeepsPinnedBlobs)
+{
+    CreateBlob("sha256:manifest", {"sha256:layer1"});
+    CreateBlob("sha256:layer1");
+    // Update in progress: layers are downloaded before its manifest.
+    CreateBlob("sha256:newmanifest", {"sha256:layer2"});
+    CreateBlob("sha256:layer2");
+    CreateBlob("sha256:layer3");
+    CreateBlob("sha256:unpinned");
+
+    BlobGC gc(mDir, [this](const std::string& digest, std::vector<std::string>& references) {
+        return GetReferences(digest, references);
+    });
+
+    gc.Pin("sha256:newmanifest");
+    gc.Pin("sha256:layer3");
+    gc.Pin("sha256:layer3");
+    gc.Pin("sha256:unpinned");
+
+    ASSERT_EQ(gc.Mark({"sha256:manifest"}), 0);
+
+    gc.Unpin("sha256:layer3");
+    gc.Unpin("sha256:unpinned");
+    // Pinned after mark.
+    gc.Pin("sha256:layer1");
+
+    for (auto done = false; !done;) {
+        ASSERT_EQ(gc.Sweep(std::chrono::milliseconds(10), done), 0);
+    }
+
+    EXPECT_TRUE(BlobExists("sha256:newmanifest"));
+    EXPECT_TRUE(BlobExists("sha256:layer2"));
+    EXPECT_TRUE(BlobExists("sha256:layer3"));
+    // Marked as pinned blob at mark start.
+    EXPECT_TRUE(BlobExists("sha256:unpinned"));
+
+    gc.Unpin("sha256:layer3");
+    gc.Unpin("sha256:newmanifest");
+
+    ASSERT_EQ(Collect(gc, {"sha256:manifest"}), 0);
+
+    EXPECT_FALSE(BlobExists("sha256:newmanifest"));
+    EXPECT_FALSE(BlobExists("sha256:layer3"));
+    EXPECT_FALSE(BlobExists("sha256:unpinned"));
+    EXPECT_TRUE(BlobExists("sha256:layer1"));
+}
+
+TEST_F(BlobGCTest, PinnedBlobNotDownloaded)
+{
+    CreateBlob("sha256:manifest");
+    CreateBlob("sha256:old");
+
+    BlobGC gc(mDir, [this](const std::string& digest, std::vector<std::string>& references) {
+        return GetReferences(digest, references);
+    });
+
+    // References of blob being downloaded are unknown: it must not fail mark.
+    gc.Pin("sha256:downloading");
+
+    ASSERT_EQ(Collect(gc, {"sha256:manifest"}), 0);
+
+    EXPECT_EQ(gc.GetStats().mMarked, 2);
+    EXPECT_FALSE(BlobExists("sha256:old"));
+}
+
+TEST_F(BlobGCTest, PinWaitsForRemoval)
+{
+    CreateBlob("sha256:manifest");
+    CreateBlob("sha256:old");
+
+    std::promise<void> removeStarted, removeReleased;
+    auto               released = removeReleased.get_future().share();
+
+    BlobGC gc(
+        mDir,
+        [this](const std::string& digest, std::vector<std::string>& references) {
+            return GetReferences(digest, references);
+        },
+        [&](const fs::path& path) {
+            removeStarted.set_value();
+            released.wait();
+            fs::remove(path);
+
+            return 0;
+        });
+
+    ASSERT_EQ(gc.Mark({"sha256:manifest"}), 0);
+
+    auto sweep = std::async(std::launch::async, [&]() {
+        auto done = false;
+
+        return gc.Sweep(std::chrono::seconds(10), done);
+    });
+
+    removeStarted.get_future().wait();
+
+    // Other blobs are pinned while removal is in progress.
+    auto pinOther = std::async(std::launch::async, [&]() { gc.Pin("sha256:other"); });
+
+    ASSERT_EQ(pinOther.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+
+    auto pinRemoved = std::async(std::launch::async, [&]() {
+        gc.Pin("sha256:old");
+
+        return BlobExists("sha256:old");
+    });
+
+    EXPECT_EQ(pinRemoved.wait_for(std::chrono::milliseconds(100)), std::future_status::timeout);
+
+    removeReleased.set_value();
+
+    EXPECT_EQ(sweep.get(), 0);
+    EXPECT_FALSE(pinRemoved.get());
+    EXPECT_EQ(gc.GetStats().mRemoved, 1);
+}
+
+TEST_F(BlobGCTest, KeepsRecentBlobs)
+{
+    CreateBlob("sha256:manifest");
+
+    BlobGC gc(mDir, [this](const std::string& digest, std::vector<std::string>& references) {
+        return GetReferences(digest, references);
+    });
+
+    ASSERT_EQ(gc.Mark({"sha256:manifest"}), 0);
+
+    std::ofstream(mDir / "sha256" / "new") << "new";
+
+    auto done = false;
+
+    ASSERT_EQ(gc.Sweep(std::chrono::milliseconds(10), done), 0);
+    EXPECT_TRUE(done);
+    EXPECT_TRUE(BlobExists("sha256:new"));
+}
+
+TEST_F(BlobGCTest, MarkErrors)
+{
+    CreateBlob("sha256:manifest", {"sha256:missing"});
+    CreateBlob("sha256:other");
+
+    BlobGC gc(
+        mDir,
+        [this](const std::string& digest, std::vector<std::string>& references) {
+            return GetReferences(digest, references);
+        },
+        {}, 4);
+
+    EXPECT_EQ(Collect(gc, {"sha256:manifest"}), ENOENT);
+    EXPECT_TRUE(BlobExists("sha256:other"));
+
+    BlobGC throwing(
+        mDir,
+        [](const std::string&, std::vector<std::string>&) -> int { throw std::runtime_error("references failed"); },
+        {}, 4);
+
+    EXPECT_EQ(Collect(throwing, {"sha256:manifest"}), EFAULT);
+    EXPECT_TRUE(BlobExists("sha256:other"));
+}
+
+} // namespace aos::common::image
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include <sys/stat.h>
+#include <sys/xattr.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "image/layerunpacker.hpp"
+
+using namespace testing;
+
+namespace aos::common::image {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/***********************************************************************************************************************
+ * Consts
+ **********************************************************************************************************************/
+
+constexpr auto cOpaqueXattr = "user.overlay.opaque";
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+void CreateFile(const fs::path& path)
+{
+    fs::create_directories(path.parent_path());
+    std::ofstream(path) << "data";
+}
+
+bool IsWhiteout(const fs::path& path)
+{
+    struct stat st {};
+
+    return lstat(path.c_str(), &st) == 0 && S_ISCHR(st.st_mode) && st.st_rdev == 0;
+}
+
+bool IsOpaque(const fs::path& path)
+{
+    char value[2] {};
+
+    return getxattr(path.c_str(), cOpaqueXattr, value, sizeof(value)) == 1 && value[0] == 'y';
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Suite
+ **********************************************************************************************************************/
+
+class LayerUnpackerTest : public Test {
+protected:
+    void SetUp() override
+    {
+        mDir = fs::temp_directory_path() / ("layerunpacker_test_" + std::to_string(getpid()));
+
+        fs::remove_all(mDir);
+        fs::create_directories(mDir);
+    }
+
+    void TearDown() override { fs::remove_all(mDir); }
+
+    fs::path mDir;
+};
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST_F(LayerUnpackerTest, ConvertWhiteouts)
+{
+    if (geteuid() != 0) {
+        GTEST_SKIP() << "whiteout devices require CAP_MKNOD";
+    }
+
+    CreateFile(mDir / "etc" / ".wh.removed");
+    CreateFile(mDir / "opaque" / ".wh..wh..opq");
+    CreateFile(mDir / "opaque" / "kept");
+
+    ASSERT_EQ(ConvertWhiteouts(mDir.string(), cOpaqueXattr), 0);
+
+    EXPECT_TRUE(IsWhiteout(mDir / "etc" / "removed"));
+    EXPECT_FALSE(fs::exists(mDir / "etc" / ".wh.removed"));
+    EXPECT_TRUE(IsOpaque(mDir / "opaque"));
+    EXPECT_TRUE(fs::exists(mDir / "opaque" / "kept"));
+}
+
+TEST_F(LayerUnpackerTest, ConvertWhiteoutsKeepsSameLayerEntries)
+{
+    if (geteuid() != 0) {
+        GTEST_SKIP() << "whiteout devices require CAP_MKNOD";
+    }
+
+    // Directory replaced in the same layer: lower content is hidden, new content is kept.
+    CreateFile(mDir / ".wh.dir");
+    CreateFile(mDir / "dir" / "new");
+    // Nested whiteout inside whited out directory.
+    CreateFile(mDir / "dir" / ".wh.old");
+    // File replaced in the same layer.
+    CreateFile(mDir / ".wh.file");
+    CreateFile(mDir / "file");
+
+    ASSERT_EQ(ConvertWhiteouts(mDir.string(), cOpaqueXattr), 0);
+
+    EXPECT_TRUE(fs::is_regular_file(mDir / "dir" / "new"));
+    EXPECT_TRUE(IsOpaque(mDir / "dir"));
+    EXPECT_TRUE(IsWhiteout(mDir / "dir" / "old"));
+    EXPECT_TRUE(fs::is_regular_file(mDir / "file"));
+}
+
+TEST_F(LayerUnpackerTest, UnpackReportsErrors)
+{
+    std::vector<LayerUnpackInfo> layers;
+
+    for (auto i = 0; i < 4; i++) {
+        auto destination = mDir / std::to_string(i);
+
+        fs::create_directories(destination);
+        layers.push_back({std::to_string(i), destination.string()});
+    }
+
+    LayerUnpacker unpacker(
+        [](const std::string& archivePath, const std::string&) {
+            if (archivePath == "2") {
+                throw std::runtime_error("unpack failed");
+            }
+
+            return 0;
+        },
+        2, cOpaqueXattr);
+
+    std::vector<LayerUnpackState> states(layers.size(), LayerUnpackState::eStarted);
+
+    EXPECT_EQ(unpacker.Unpack(layers, [&](size_t index, LayerUnpackState state, int) { states[index] = state; }),
+        EFAULT);
+    EXPECT_EQ(states[2], LayerUnpackState::eFailed);
+
+    LayerUnpacker failing([](const std::string&, const std::string&) { return EIO; }, 2, cOpaqueXattr);
+
+    EXPECT_EQ(failing.Unpack(layers), EIO);
+}
+
+} // namespace aos::common::image
@@ -0,0 +1,310 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "image/tarindex.hpp"
+
+using namespace testing;
+
+namespace aos::common::image {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+class TarBuilder {
+public:
+    enum class Format { eUstar, eGNU };
+
+    void AddMember(const std::string& name, char type, const std::string& data, const std::string& prefix = {},
+        Format format = Format::eUstar, const std::string& linkName = {})
+    {
+        char header[512] {};
+
+        memcpy(header, name.data(), std::min<size_t>(name.size(), 100));
+        snprintf(header + 100, 8, "%07o", 0644);
+        snprintf(header + 124, 12, "%011zo", data.size());
+        header[156] = type;
+        memcpy(header + 157, linkName.data(), std::min<size_t>(linkName.size(), 100));
+
+        if (format == Format::eUstar) {
+            memcpy(header + 257, "ustar\0" "00", 8);
+            memcpy(header + 345, prefix.data(), std::min<size_t>(prefix.size(), 155));
+        } else {
+            // GNU magic: atime and ctime follow at offset 345.
+            memcpy(header + 257, "ustar  \0", 8);
+            snprintf(header + 345, 12, "%011o", 012345670);
+            snprintf(header + 357, 12, "%011o", 012345670);
+        }
+
+        AppendHeader(header);
+        mData.append(data);
+        mData.append((512 - data.size() % 512) % 512, '\0');
+    }
+
+    // Adds header only, with size in GNU base-256 encoding.
+    void AddBase256Member(const std::string& name, uint64_t size)
+    {
+        char header[512] {};
+
+        memcpy(header, name.data(), std::min<size_t>(name.size(), 100));
+        snprintf(header + 100, 8, "%07o", 0644);
+        header[124] = static_cast<char>(0x80);
+
+        for (int i = 0; i < 8; i++) {
+            header[135 - i] = static_cast<char>(size >> (i * 8));
+        }
+
+        header[156] = '0';
+        memcpy(header + 257, "ustar  \0", 8);
+
+        AppendHeader(header);
+    }
+
+    void AddPax(char type, const std::string& key, const std::string& value)
+    {
+        auto record = " " + key + "=" + value + "\n";
+        auto length = record.size() + 1;
+
+        // Length includes its own digits.
+        while (std::to_string(length).size() + record.size() != length) {
+            length++;
+        }
+
+        AddMember("PaxHeader", type, std::to_string(length) + record);
+    }
+
+    void Write(const fs::path& path)
+    {
+        std::ofstream(path, std::ios::binary) << mData << std::string(1024, '\0');
+    }
+
+private:
+    void AppendHeader(char (&header)[512])
+    {
+        unsigned sum = 0;
+
+        memset(header + 148, ' ', 8);
+
+        for (auto chr : header) {
+            sum += static_cast<unsigned char>(chr);
+        }
+
+        snprintf(header + 148, 8, "%06o", sum);
+
+        mData.append(header, sizeof(header));
+    }
+
+    std::string mData;
+};
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Suite
+ **********************************************************************************************************************/
+
+class TarIndexTest : public Test {
+protected:
+    void SetUp() override
+    {
+        mDir = fs::temp_directory_path() / ("tarindex_test_" + std::to_string(getpid()));
+
+        fs::remove_all(mDir);
+        fs::create_directories(mDir);
+
+        mArchivePath = (mDir / "layer.tar").string();
+    }
+
+    void TearDown() override { fs::remove_all(mDir); }
+
+    fs::path    mDir;
+    std::string mArchivePath;
+};
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST_F(TarIndexTest, BuildAndExtract)
+{
+    TarBuilder builder;
+
+    builder.AddMember("./etc/", '5', "");
+    builder.AddMember("./etc/hosts", '0', "127.0.0.1 localhost\n");
+    builder.AddMember("hosts.link", '1', "", {}, TarBuilder::Format::eUstar, "./etc/hosts");
+    builder.AddMember("passwd", '0', "root", "usr/share");
+    builder.Write(mArchivePath);
+
+    TarIndex index;
+
+    ASSERT_EQ(index.Build(mArchivePath), 0);
+    ASSERT_EQ(index.GetMembers().size(), 4);
+    EXPECT_EQ(index.GetMembers()[0].mName, "etc");
+    EXPECT_EQ(index.GetMembers()[3].mName, "usr/share/passwd");
+
+    std::string content;
+
+    ASSERT_EQ(index.ExtractFile("etc/hosts", content), 0);
+    EXPECT_EQ(content, "127.0.0.1 localhost\n");
+
+    ASSERT_EQ(index.ExtractFile("hosts.link", content), 0);
+    EXPECT_EQ(content, "127.0.0.1 localhost\n");
+
+    ASSERT_EQ(index.ExtractFile("./usr/share/passwd", content), 0);
+    EXPECT_EQ(content, "root");
+
+    EXPECT_EQ(index.ExtractFile("etc", content), ENOENT);
+    EXPECT_EQ(index.ExtractFile("missing", content), ENOENT);
+
+    const auto dstPath = (mDir / "hosts").string();
+
+    ASSERT_EQ(index.ExtractFile("etc/hosts", dstPath), 0);
+    EXPECT_EQ(fs::file_size(dstPath), 20);
+}
+
+TEST_F(TarIndexTest, GNUHeaderHasNoPrefix)
+{
+    TarBuilder builder;
+
+    builder.AddMember("bin/sh", '0', "#!", {}, TarBuilder::Format::eGNU);
+    builder.Write(mArchivePath);
+
+    TarIndex index;
+
+    ASSERT_EQ(index.Build(mArchivePath), 0);
+    ASSERT_EQ(index.GetMembers().size(), 1);
+    EXPECT_EQ(index.GetMembers()[0].mName, "bin/sh");
+}
+
+TEST_F(TarIndexTest, PaxRecords)
+{
+    TarBuilder  builder;
+    std::string longName(150, 'n');
+
+    builder.AddPax('g', "comment", "global");
+    builder.AddPax('x', "path", longName);
+    builder.AddMember("short", '0', "data");
+    // Extended size record must not be applied to global header.
+    builder.AddPax('x', "size", "600");
+    builder.AddPax('g', "comment", "global");
+    builder.AddMember("sized", '0', std::string(600, 's'));
+    builder.AddMember("last", '0', "tail");
+    builder.Write(mArchivePath);
+
+    TarIndex index;
+
+    ASSERT_EQ(index.Build(mArchivePath), 0);
+    ASSERT_EQ(index.GetMembers().size(), 3);
+    EXPECT_EQ(index.GetMembers()[0].mName, longName);
+
+    std::string content;
+
+    ASSERT_EQ(index.ExtractFile("sized", content), 0);
+    EXPECT_EQ(content, std::string(600, 's'));
+    ASSERT_EQ(index.ExtractFile("last", content), 0);
+    EXPECT_EQ(content, "tail");
+}
+
+TEST_F(TarIndexTest, GNULongName)
+{
+    TarBuilder  builder;
+    std::string longName(200, 'l');
+
+    builder.AddMember("././@LongLink", 'L', longName + '\0');
+    builder.AddMember("truncated", '0', "data");
+    builder.Write(mArchivePath);
+
+    TarIndex index;
+
+    ASSERT_EQ(index.Build(mArchivePath), 0);
+    ASSERT_NE(index.Find(longName), nullptr);
+}
+
+TEST_F(TarIndexTest, PersistedIndex)
+{
+    TarBuilder builder;
+
+    builder.AddMember(" leading space", '0', "1");
+    builder.AddMember("name with\nnewline", '0', "22");
+    builder.Write(mArchivePath);
+
+    TarIndex built;
+
+    ASSERT_EQ(built.Load(mArchivePath), 0);
+    EXPECT_TRUE(fs::exists(mArchivePath + ".idx"));
+
+    // Reads persisted index: corrupt archive data would fail the scan.
+    TarIndex loaded;
+
+    ASSERT_EQ(loaded.Load(mArchivePath), 0);
+    ASSERT_EQ(loaded.GetMembers().size(), 2);
+    EXPECT_EQ(loaded.GetMembers()[0].mName, " leading space");
+    EXPECT_EQ(loaded.GetMembers()[1].mName, "name with\nnewline");
+
+    std::string content;
+
+    ASSERT_EQ(loaded.ExtractFile("name with\nnewline", content), 0);
+    EXPECT_EQ(content, "22");
+
+    for (const auto& entry : fs::directory_iterator(mDir)) {
+        EXPECT_EQ(entry.path().string().find(".idx."), std::string::npos) << entry.path();
+    }
+}
+
+TEST_F(TarIndexTest, InvalidArchive)
+{
+    std::ofstream(mArchivePath) << std::string(512, 'x');
+
+    TarIndex index;
+
+    EXPECT_EQ(index.Build(mArchivePath), EINVAL);
+    EXPECT_EQ(index.Build((mDir / "missing.tar").string()), ENOENT);
+}
+
+TEST_F(TarIndexTest, HugeMemberSize)
+{
+    // Both sizes wrap archive bounds check, the last one also wraps block rounding.
+    for (auto size : {UINT64_C(0xFFFFFFFFFFFFFE00), std::numeric_limits<uint64_t>::max()}) {
+        TarBuilder builder;
+
+        builder.AddBase256Member("huge", size);
+        builder.AddMember("next", '0', "data");
+        builder.Write(mArchivePath);
+
+        TarIndex index;
+
+        EXPECT_EQ(index.Build(mArchivePath), EINVAL) << size;
+    }
+
+    TarBuilder builder;
+
+    builder.AddPax('x', "size", std::to_string(UINT64_C(0xFFFFFFFFFFFFFE00)));
+    builder.AddMember("huge", '0', "data");
+    builder.Write(mArchivePath);
+
+    TarIndex index;
+
+    EXPECT_EQ(index.Build(mArchivePath), EINVAL);
+}
+
+} // namespace aos::common::image
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "image/warmuptrace.hpp"
+
+using namespace testing;
+
+namespace aos::common::image {
+
+namespace fs = std::filesystem;
+
+/***********************************************************************************************************************
+ * Suite
+ **********************************************************************************************************************/
+
+class WarmupTraceTest : public Test {
+protected:
+    void SetUp() override
+    {
+        mDir = fs::temp_directory_path() / ("warmuptrace_test_" + std::to_string(getpid()));
+
+        fs::remove_all(mDir);
+        fs::create_directories(mDir / "rootfs" / "bin");
+    }
+
+    void TearDown() override { fs::remove_all(mDir); }
+
+    void CreateFile(const std::string& name, size_t size)
+    {
+        std::ofstream(mDir / "rootfs" / name, std::ios::binary) << std::string(size, 'a');
+    }
+
+    void ReadFile(const std::string& name, size_t offset, size_t size)
+    {
+        std::string buffer(size, '\0');
+
+        auto fd = open((mDir / "rootfs" / name).c_str(), O_RDONLY | O_CLOEXEC);
+        ASSERT_GE(fd, 0);
+        EXPECT_EQ(pread(fd, buffer.data(), size, static_cast<off_t>(offset)), static_cast<ssize_t>(size));
+
+        close(fd);
+    }
+
+    fs::path mDir;
+};
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST_F(WarmupTraceTest, EvictBeforeRecord)
+{
+    constexpr size_t cFileSize = 4 * 1024 * 1024;
+
+    const auto rootDir = (mDir / "rootfs").string();
+
+    CreateFile("bin/app", cFileSize);
+    CreateFile("data", cFileSize);
+
+    WarmupTrace trace;
+
+    // Without eviction freshly written files are traced as a whole.
+    ASSERT_EQ(trace.Record(rootDir, 0), 0);
+    ASSERT_EQ(trace.GetFiles().size(), 2u);
+
+    ASSERT_EQ(WarmupTrace::Evict(rootDir), 0);
+    ASSERT_EQ(trace.Record(rootDir, 0), 0);
+
+    if (!trace.GetFiles().empty()) {
+        GTEST_SKIP() << "page cache eviction is not supported by " << mDir;
+    }
+
+    ReadFile("bin/app", 0, 4096);
+
+    ASSERT_EQ(trace.Record(rootDir, 0), 0);
+    ASSERT_EQ(trace.GetFiles().size(), 1u);
+
+    const auto& file = trace.GetFiles().front();
+
+    EXPECT_EQ(file.mPath, "bin/app");
+    ASSERT_FALSE(file.mRanges.empty());
+    EXPECT_EQ(file.mRanges.front().mOffset, 0u);
+
+    // Kernel may read ahead, but not the whole file.
+    uint64_t traced = 0;
+
+    for (const auto& range : file.mRanges) {
+        traced += range.mLength;
+    }
+
+    EXPECT_LT(traced, cFileSize);
+}
+
+TEST_F(WarmupTraceTest, SaveLoadReplay)
+{
+    const auto rootDir = (mDir / "rootfs").string();
+
+    CreateFile("bin/app", 64 * 1024);
+
+    WarmupTrace trace;
+
+    ASSERT_EQ(trace.Record(rootDir), 0);
+    ASSERT_EQ(trace.Save((mDir / "trace").string()), 0);
+
+    WarmupTrace loaded;
+
+    ASSERT_EQ(loaded.Load((mDir / "trace").string()), 0);
+    ASSERT_EQ(loaded.GetFiles().size(), trace.GetFiles().size());
+
+    for (size_t i = 0; i < trace.GetFiles().size(); i++) {
+        EXPECT_EQ(loaded.GetFiles()[i].mPath, trace.GetFiles()[i].mPath);
+        EXPECT_EQ(loaded.GetFiles()[i].mRanges.size(), trace.GetFiles()[i].mRanges.size());
+    }
+
+    ASSERT_EQ(WarmupTrace::Evict(rootDir), 0);
+
+    uint64_t bytes = 0;
+
+    EXPECT_EQ(loaded.Replay(rootDir, bytes), 0);
+    EXPECT_EQ(bytes, 64 * 1024u);
+}
+
+TEST_F(WarmupTraceTest, LoadRejectsInvalidTrace)
+{
+    const auto tracePath = (mDir / "trace").string();
+
+    auto load = [&](const std::string& entries) {
+        std::ofstream(tracePath) << "aoswarmup 1\n" << entries;
+
+        WarmupTrace trace;
+        auto        err = trace.Load(tracePath);
+
+        EXPECT_TRUE(err == 0 || trace.GetFiles().empty());
+
+        return err;
+    };
+
+    EXPECT_EQ(load("1 7 bin/app\n0 4096\n"), 0);
+    EXPECT_EQ(load("1 9 ./bin/app\n0 4096\n"), 0);
+
+    // Paths outside the image root.
+    EXPECT_EQ(load("1 11 /etc/passwd\n0 4096\n"), EINVAL);
+    EXPECT_EQ(load("1 13 ../etc/passwd\n0 4096\n"), EINVAL);
+    EXPECT_EQ(load("1 10 bin/../..\n0 4096\n"), EINVAL);
+    EXPECT_EQ(load("1 0 \n0 4096\n"), EINVAL);
+
+    // Counts must not allocate more than the trace holds.
+    EXPECT_EQ(load("1000000000000 7 bin/app\n0 4096\n"), EINVAL);
+    EXPECT_EQ(load("1 1000000000000 bin/app\n0 4096\n"), EINVAL);
+    EXPECT_EQ(load("2 7 bin/app\n0 4096\n"), EINVAL);
+}
+
+TEST_F(WarmupTraceTest, SaveReplacesTrace)
+{
+    const auto rootDir   = (mDir / "rootfs").string();
+    const auto tracePath = (mDir / "trace").string();
+
+    CreateFile("bin/app", 4096);
+
+    WarmupTrace trace, loaded;
+
+    ASSERT_EQ(trace.Save(tracePath), 0);
+    ASSERT_EQ(loaded.Load(tracePath), 0);
+    EXPECT_TRUE(loaded.GetFiles().empty());
+
+    ASSERT_EQ(trace.Record(rootDir), 0);
+    ASSERT_EQ(trace.Save(tracePath), 0);
+    ASSERT_EQ(loaded.Load(tracePath), 0);
+    EXPECT_EQ(loaded.GetFiles().size(), trace.GetFiles().size());
+
+    // No temporary files are left.
+    EXPECT_EQ(std::distance(fs::directory_iterator(mDir), fs::directory_iterator()), 2);
+    EXPECT_NE(trace.Save((mDir / "missing" / "trace").string()), 0);
+}
+
+} // namespace aos::common::image
@@ -0,0 +1,303 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <climits>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "warmuptrace.hpp"
+#include "utils/atomicfile.hpp"
+
+namespace aos::common::image {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/***********************************************************************************************************************
+ * Consts
+ **********************************************************************************************************************/
+
+constexpr auto cTraceSignature = "aoswarmup 1";
+// Range per page of 4 GiB file: bounds memory allocated for corrupted trace.
+constexpr size_t cMaxRanges = 1024 * 1024;
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+using FilePtr = std::unique_ptr<FILE, decltype(&fclose)>;
+
+int RecordFile(const fs::path& path, uint64_t pageSize, uint64_t maxGap, std::vector<WarmupRange>& ranges)
+{
+    auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NOATIME);
+    if (fd < 0 && errno == EPERM) {
+        // O_NOATIME is allowed for file owner only.
+        fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    }
+
+    if (fd < 0) {
+        return errno;
+    }
+
+    struct stat st {};
+
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        auto err = st.st_size == 0 ? 0 : errno;
+
+        close(fd);
+
+        return err;
+    }
+
+    auto size = static_cast<uint64_t>(st.st_size);
+
+    // Mapping doesn't read file: mincore reports page cache state only.
+    auto addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+
+    close(fd);
+
+    if (addr == MAP_FAILED) {
+        return errno;
+    }
+
+    std::vector<unsigned char> resident((size + pageSize - 1) / pageSize);
+
+    auto err = mincore(addr, size, resident.data()) != 0 ? errno : 0;
+
+    munmap(addr, size);
+
+    if (err != 0) {
+        return err;
+    }
+
+    for (uint64_t page = 0; page < resident.size(); page++) {
+        if (!(resident[page] & 1)) {
+            continue;
+        }
+
+        auto offset = page * pageSize;
+
+        if (!ranges.empty() && offset - (ranges.back().mOffset + ranges.back().mLength) <= maxGap) {
+            ranges.back().mLength = offset + pageSize - ranges.back().mOffset;
+        } else {
+            ranges.push_back({offset, pageSize});
+        }
+    }
+
+    if (!ranges.empty() && ranges.back().mOffset + ranges.back().mLength > size) {
+        ranges.back().mLength = size - ranges.back().mOffset;
+    }
+
+    return 0;
+}
+
+// Trace is replayed under image root: reject paths which leave it.
+bool IsRelativePath(const std::string& path)
+{
+    if (path.empty() || path.find('\0') != std::string::npos) {
+        return false;
+    }
+
+    fs::path tracedPath(path);
+
+    return tracedPath.is_relative()
+        && std::none_of(tracedPath.begin(), tracedPath.end(), [](const fs::path& part) { return part == ".."; });
+}
+
+int EvictFile(const fs::path& path)
+{
+    // Write access is not needed: fdatasync works on read only descriptor.
+    auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NOATIME);
+    if (fd < 0 && errno == EPERM) {
+        fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    }
+
+    if (fd < 0) {
+        return errno;
+    }
+
+    auto err = 0;
+
+    if (fdatasync(fd) != 0) {
+        err = errno;
+    } else {
+        err = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    }
+
+    close(fd);
+
+    return err;
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+int WarmupTrace::Evict(const std::string& rootDir)
+{
+    std::error_code ec;
+
+    for (fs::recursive_directory_iterator it(rootDir, fs::directory_options::none, ec), end; !ec && it != end;
+         it.increment(ec)) {
+        if (!it->is_regular_file(ec) || it->is_symlink(ec)) {
+            continue;
+        }
+
+        if (auto err = EvictFile(it->path()); err != 0) {
+            return err;
+        }
+    }
+
+    return ec ? ec.value() : 0;
+}
+
+int WarmupTrace::Record(const std::string& rootDir, uint64_t maxGap)
+{
+    mFiles.clear();
+
+    auto pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+
+    std::error_code ec;
+
+    for (fs::recursive_directory_iterator it(rootDir, fs::directory_options::none, ec), end; !ec && it != end;
+         it.increment(ec)) {
+        if (!it->is_regular_file(ec) || it->is_symlink(ec)) {
+            continue;
+        }
+
+        WarmupFile file {fs::relative(it->path(), rootDir, ec).string(), {}};
+
+        // Unreadable files are not traced.
+        if (RecordFile(it->path(), pageSize, maxGap, file.mRanges) != 0 || file.mRanges.empty()) {
+            continue;
+        }
+
+        mFiles.push_back(std::move(file));
+    }
+
+    return ec ? ec.value() : 0;
+}
+
+int WarmupTrace::Save(const std::string& path) const
+{
+    // Format: signature line, then per file "<range count> <path length> <path>\n" followed by "<offset> <length>\n"
+    // range lines.
+    std::string data = std::string(cTraceSignature) + "\n";
+
+    for (const auto& traced : mFiles) {
+        data.append(std::to_string(traced.mRanges.size()))
+            .append(" ")
+            .append(std::to_string(traced.mPath.size()))
+            .append(" ")
+            .append(traced.mPath)
+            .append("\n");
+
+        for (const auto& range : traced.mRanges) {
+            data.append(std::to_string(range.mOffset)).append(" ").append(std::to_string(range.mLength)).append("\n");
+        }
+    }
+
+    return utils::WriteFileAtomically(path, data);
+}
+
+int WarmupTrace::Load(const std::string& path)
+{
+    mFiles.clear();
+
+    FilePtr file(fopen(path.c_str(), "re"), &fclose);
+
+    if (!file) {
+        return errno;
+    }
+
+    char signature[32] {};
+
+    if (!fgets(signature, sizeof(signature), file.get())
+        || std::string(signature) != std::string(cTraceSignature) + "\n") {
+        return EINVAL;
+    }
+
+    size_t rangeCount = 0, pathLen = 0;
+
+    while (fscanf(file.get(), "%zu %zu", &rangeCount, &pathLen) == 2) {
+        WarmupFile traced;
+
+        // Skip separator: path itself may start with space.
+        if (pathLen > PATH_MAX || rangeCount > cMaxRanges || fgetc(file.get()) != ' ') {
+            mFiles.clear();
+
+            return EINVAL;
+        }
+
+        traced.mPath.resize(pathLen);
+
+        if (fread(traced.mPath.data(), 1, pathLen, file.get()) != pathLen || !IsRelativePath(traced.mPath)) {
+            mFiles.clear();
+
+            return EINVAL;
+        }
+
+        traced.mRanges.resize(rangeCount);
+
+        for (auto& range : traced.mRanges) {
+            if (fscanf(file.get(), "%" SCNu64 " %" SCNu64, &range.mOffset, &range.mLength) != 2) {
+                mFiles.clear();
+
+                return EINVAL;
+            }
+        }
+
+        mFiles.push_back(std::move(traced));
+    }
+
+    return feof(file.get()) ? 0 : EINVAL;
+}
+
+int WarmupTrace::Replay(const std::string& rootDir, uint64_t& bytes) const
+{
+    bytes = 0;
+
+    for (const auto& traced : mFiles) {
+        auto path = fs::path(rootDir) / traced.mPath;
+
+        // Symlinks are not recorded: don't follow one replaced into the image since.
+        auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+        if (fd < 0) {
+            continue;
+        }
+
+        for (const auto& range : traced.mRanges) {
+            // readahead is not supported by some filesystems: fall back to advice.
+            if (readahead(fd, static_cast<off_t>(range.mOffset), range.mLength) != 0
+                && posix_fadvise(fd, static_cast<off_t>(range.mOffset), static_cast<off_t>(range.mLength),
+                       POSIX_FADV_WILLNEED)
+                    != 0) {
+                continue;
+            }
+
+            bytes += range.mLength;
+        }
+
+        close(fd);
+    }
+
+    return 0;
+}
+
+} // namespace aos::common::image
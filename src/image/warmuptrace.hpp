@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef WARMUPTRACE_HPP_
+#define WARMUPTRACE_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace aos::common::image {
+
+/**
+ * File range.
+ */
+struct WarmupRange {
+    uint64_t mOffset = 0;
+    uint64_t mLength = 0;
+};
+
+/**
+ * Traced file.
+ */
+struct WarmupFile {
+    std::string              mPath;
+    std::vector<WarmupRange> mRanges;
+};
+
+/**
+ * Page cache warm-up trace.
+ *
+ * Record takes mincore() snapshot of files under unpacked image directory after the first instance start: resident
+ * pages are the ones the instance touched (or any other reader did). Freshly unpacked files are still in the page
+ * cache, so Evict must be called before the recorded start, otherwise the trace covers the whole image. Nearby ranges
+ * are merged, so Replay issues few large sequential readahead() requests instead of random reads during startup.
+ * Trace is stored as a text file alongside the image.
+ *
+ * Methods return 0 on success or errno value on failure.
+ */
+class WarmupTrace {
+public:
+    /**
+     * Evicts all regular files under root dir from the page cache.
+     *
+     * Dirty pages can't be dropped, so files are synced first. Pages mapped by running processes stay resident.
+     *
+     * @param rootDir unpacked image root dir.
+     * @return int.
+     */
+    static int Evict(const std::string& rootDir);
+
+    /**
+     * Records resident ranges of all regular files under root dir.
+     *
+     * @param rootDir unpacked image root dir.
+     * @param maxGap max gap between resident ranges to merge them into one read.
+     * @return int.
+     */
+    int Record(const std::string& rootDir, uint64_t maxGap = 128 * 1024);
+
+    /**
+     * Saves trace.
+     *
+     * @param path trace file path.
+     * @return int.
+     */
+    int Save(const std::string& path) const;
+
+    /**
+     * Loads trace.
+     *
+     * @param path trace file path.
+     * @return int.
+     */
+    int Load(const std::string& path);
+
+    /**
+     * Replays trace: requests readahead of all recorded ranges.
+     *
+     * Missing files are skipped: image content may change between record and replay.
+     *
+     * @param rootDir unpacked image root dir.
+     * @param[out] bytes number of bytes requested.
+     * @return int.
+     */
+    int Replay(const std::string& rootDir, uint64_t& bytes) const;
+
+    /**
+     * Returns traced files.
+     *
+     * @return const std::vector<WarmupFile>&.
+     */
+    const std::vector<WarmupFile>& GetFiles() const { return mFiles; }
+
+private:
+    std::vector<WarmupFile> mFiles;
+};
+
+} // namespace aos::common::image
+
+#endif
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+
+#include "logcontext.hpp"
+
+namespace aos::common::logger {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Vars
+ **********************************************************************************************************************/
+
+thread_local const LogContextFrame* tContext = nullptr;
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+const LogContextFrame* GetLogContext()
+{
+    return tContext;
+}
+
+LogContextSnapshot LogContextSnapshot::Capture()
+{
+    LogContextSnapshot snapshot;
+
+    for (auto frame = tContext; frame != nullptr; frame = frame->mParent) {
+        snapshot.mFields.emplace_back(frame->mKey, frame->mValue);
+    }
+
+    std::reverse(snapshot.mFields.begin(), snapshot.mFields.end());
+
+    return snapshot;
+}
+
+ScopedLogContext::ScopedLogContext(std::string_view key, std::string_view value)
+    : mPrevious(tContext)
+{
+    // Value is copied: it may be a temporary, e.g. std::to_string result.
+    if (value.size() <= cInlineValueSize) {
+        std::copy(value.begin(), value.end(), mValueBuffer);
+        value = std::string_view(mValueBuffer, value.size());
+    } else {
+        mLongValue.assign(value);
+        value = mLongValue;
+    }
+
+    mFrame   = {key, value, tContext};
+    tContext = &mFrame;
+}
+
+ScopedLogContext::ScopedLogContext(const LogContextSnapshot& snapshot)
+    : mPrevious(tContext)
+{
+    auto frames = mInlineFrames.data();
+
+    // Deep snapshot needs allocated frames. They are linked after resize: vector is not reallocated.
+    if (snapshot.mFields.size() > cInlineFrames) {
+        mFrames.resize(snapshot.mFields.size());
+        frames = mFrames.data();
+    }
+
+    for (const auto& [key, value] : snapshot.mFields) {
+        *frames  = {key, value, tContext};
+        tContext = frames++;
+    }
+}
+
+ScopedLogContext::~ScopedLogContext()
+{
+    tContext = mPrevious;
+}
+
+} // namespace aos::common::logger
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LOGCONTEXT_HPP_
+#define LOGCONTEXT_HPP_
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace aos::common::logger {
+
+/**
+ * Log context frame: one key/value pair of the thread log context chain.
+ */
+struct LogContextFrame {
+    std::string_view       mKey;
+    std::string_view       mValue;
+    const LogContextFrame* mParent = nullptr;
+};
+
+/**
+ * Returns current thread log context: innermost frame or nullptr if no context is set.
+ *
+ * @return const LogContextFrame*.
+ */
+const LogContextFrame* GetLogContext();
+
+/**
+ * Owned copy of the thread log context to pass it to another thread, e.g. with executor or channel task.
+ */
+class LogContextSnapshot {
+public:
+    /**
+     * Captures current thread log context.
+     *
+     * @return LogContextSnapshot.
+     */
+    static LogContextSnapshot Capture();
+
+    /**
+     * Returns true if snapshot is empty.
+     *
+     * @return bool.
+     */
+    bool IsEmpty() const { return mFields.empty(); }
+
+private:
+    friend class ScopedLogContext;
+
+    // Outermost first.
+    std::vector<std::pair<std::string, std::string>> mFields;
+};
+
+/**
+ * Pushes log context for the current scope.
+ *
+ * Records written by the thread within the scope carry context fields. Push and pop only link a frame stored in the
+ * object: no allocation for values up to 64 bytes and snapshots up to 4 frames, no cost for records if no context is
+ * set.
+ */
+class ScopedLogContext {
+public:
+    /**
+     * Pushes key/value context.
+     *
+     * @param key context key, should outlive the scope, e.g. string literal.
+     * @param value context value, copied.
+     */
+    ScopedLogContext(std::string_view key, std::string_view value);
+
+    /**
+     * Restores captured context on top of the current one.
+     *
+     * @param snapshot context snapshot, should outlive the scope.
+     */
+    explicit ScopedLogContext(const LogContextSnapshot& snapshot);
+
+    /**
+     * Pops context.
+     */
+    ~ScopedLogContext();
+
+    ScopedLogContext(const ScopedLogContext&)            = delete;
+    ScopedLogContext& operator=(const ScopedLogContext&) = delete;
+
+private:
+    static constexpr size_t cInlineValueSize = 64;
+    static constexpr size_t cInlineFrames    = 4;
+
+    const LogContextFrame*                     mPrevious;
+    LogContextFrame                            mFrame;
+    char                                       mValueBuffer[cInlineValueSize];
+    std::string                                mLongValue;
+    std::array<LogContextFrame, cInlineFrames> mInlineFrames;
+    std::vector<LogContextFrame>               mFrames;
+};
+
+/**
+ * Wraps task to run it with log context of the calling thread.
+ *
+ * @param task task.
+ * @return wrapped task.
+ */
+template <typename F>
+auto BindLogContext(F task)
+{
+    return [snapshot = LogContextSnapshot::Capture(), task = std::move(task)](auto&&... args) mutable {
+        if (snapshot.IsEmpty()) {
+            return task(std::forward<decltype(args)>(args)...);
+        }
+
+        ScopedLogContext context(snapshot);
+
+        return task(std::forward<decltype(args)>(args)...);
+    };
+}
+
+} // namespace aos::common::logger
+
+#endif
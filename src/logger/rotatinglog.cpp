@@ -0,0 +1,512 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "rotatinglog.hpp"
+#include "utils/numberformat.hpp"
+
+namespace aos::common::logger {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Consts
+ **********************************************************************************************************************/
+
+constexpr std::string_view cLogSuffix   = ".log";
+constexpr std::string_view cIndexSuffix = ".idx";
+constexpr std::string_view cTimePrefix  = "{\"time\":";
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+struct LogFile {
+    uint64_t    mSequence;
+    std::string mPath;
+};
+
+std::string GetLogFilePath(const RotatingLogConfig& config, uint64_t sequence)
+{
+    char name[32];
+
+    snprintf(name, sizeof(name), ".%08" PRIu64, sequence);
+
+    return config.mDir + "/" + config.mPrefix + name + std::string(cLogSuffix);
+}
+
+// Returns log files sorted by sequence.
+int GetLogFiles(const RotatingLogConfig& config, std::vector<LogFile>& files)
+{
+    auto dir = opendir(config.mDir.c_str());
+    if (dir == nullptr) {
+        return errno;
+    }
+
+    auto prefix = config.mPrefix + ".";
+
+    while (auto entry = readdir(dir)) {
+        std::string_view name(entry->d_name);
+
+        if (name.size() <= prefix.size() + cLogSuffix.size() || name.substr(0, prefix.size()) != prefix
+            || name.substr(name.size() - cLogSuffix.size()) != cLogSuffix) {
+            continue;
+        }
+
+        auto  sequenceStr = std::string(name.substr(prefix.size(), name.size() - prefix.size() - cLogSuffix.size()));
+        char* end         = nullptr;
+        auto  sequence    = strtoull(sequenceStr.c_str(), &end, 10);
+
+        if (*end != '\0') {
+            continue;
+        }
+
+        files.push_back({sequence, config.mDir + "/" + std::string(name)});
+    }
+
+    closedir(dir);
+
+    std::sort(files.begin(), files.end(),
+        [](const LogFile& lhs, const LogFile& rhs) { return lhs.mSequence < rhs.mSequence; });
+
+    return 0;
+}
+
+int WriteAt(int fd, std::string_view data, uint64_t offset)
+{
+    for (size_t written = 0; written < data.size();) {
+        auto n = pwrite(fd, data.data() + written, data.size() - written, static_cast<off_t>(offset + written));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (n <= 0) {
+            return n < 0 ? errno : EIO;
+        }
+
+        written += static_cast<size_t>(n);
+    }
+
+    return 0;
+}
+
+int ReadAt(int fd, std::string& data, size_t size, uint64_t offset)
+{
+    data.resize(size);
+
+    for (size_t read = 0; read < size;) {
+        auto n = pread(fd, data.data() + read, size - read, static_cast<off_t>(offset + read));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (n <= 0) {
+            return n < 0 ? errno : EIO;
+        }
+
+        read += static_cast<size_t>(n);
+    }
+
+    return 0;
+}
+
+int ReadIndex(const std::string& path, std::vector<LogFrameInfo>& frames)
+{
+    auto file = fopen(path.c_str(), "re");
+    if (file == nullptr) {
+        return errno;
+    }
+
+    LogFrameInfo frame;
+
+    while (fscanf(file, "%" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNd64 " %" SCNd64, &frame.mOffset, &frame.mSize,
+               &frame.mRawSize, &frame.mFirstTimeUs, &frame.mLastTimeUs)
+        == 5) {
+        frames.push_back(frame);
+    }
+
+    fclose(file);
+
+    return 0;
+}
+
+int64_t ParseLineTime(std::string_view line)
+{
+    if (line.substr(0, cTimePrefix.size()) != cTimePrefix) {
+        return 0;
+    }
+
+    return strtoll(line.data() + cTimePrefix.size(), nullptr, 10);
+}
+
+std::string& GetThreadBuffer()
+{
+    thread_local std::string buffer;
+
+    buffer.clear();
+
+    return buffer;
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+int RawLogFrameCodec::Compress(std::string_view data, std::string& out)
+{
+    out.assign(data);
+
+    return 0;
+}
+
+int RawLogFrameCodec::Decompress(std::string_view data, size_t rawSize, std::string& out)
+{
+    if (data.size() != rawSize) {
+        return EINVAL;
+    }
+
+    out.assign(data);
+
+    return 0;
+}
+
+RotatingFileLogBackend::~RotatingFileLogBackend()
+{
+    {
+        std::lock_guard lock {mMutex};
+
+        mStopFlush = true;
+        mFlushCondVar.notify_one();
+    }
+
+    if (mFlushThread.joinable()) {
+        mFlushThread.join();
+    }
+
+    std::lock_guard writeLock {mWriteMutex};
+
+    FlushFrame();
+    CloseFile();
+}
+
+int RotatingFileLogBackend::Init(const RotatingLogConfig& config)
+{
+    if (config.mMaxFiles == 0) {
+        return EINVAL;
+    }
+
+    std::lock_guard writeLock {mWriteMutex};
+
+    std::vector<LogFile> files;
+
+    {
+        std::lock_guard lock {mMutex};
+
+        if (mEnabled) {
+            return EBUSY;
+        }
+
+        mConfig = config;
+    }
+
+    if (auto err = GetLogFiles(mConfig, files); err != 0) {
+        return err;
+    }
+
+    mSequence = files.empty() ? 0 : files.back().mSequence;
+
+    if (auto err = OpenFile(); err != 0) {
+        return err;
+    }
+
+    std::lock_guard lock {mMutex};
+
+    mEnabled = true;
+
+    if (mConfig.mFlushInterval.count() > 0) {
+        mFlushThread = std::thread(&RotatingFileLogBackend::RunFlush, this);
+    }
+
+    return 0;
+}
+
+void RotatingFileLogBackend::Write(const LogRecord& record)
+{
+    auto& line   = GetThreadBuffer();
+    auto  timeUs = std::chrono::duration_cast<std::chrono::microseconds>(record.mTime.time_since_epoch()).count();
+
+    FormatLogRecordJSON(record, line);
+    line += '\n';
+
+    std::unique_lock lock {mMutex};
+
+    if (!mEnabled) {
+        return;
+    }
+
+    if (mFrame.empty()) {
+        mFrameInfo.mFirstTimeUs = timeUs;
+        mFrameInfo.mLastTimeUs  = timeUs;
+    }
+
+    mFrame += line;
+    mFrameInfo.mFirstTimeUs = std::min<int64_t>(mFrameInfo.mFirstTimeUs, timeUs);
+    mFrameInfo.mLastTimeUs  = std::max<int64_t>(mFrameInfo.mLastTimeUs, timeUs);
+
+    if (mFrame.size() < mConfig.mFrameSize) {
+        return;
+    }
+
+    lock.unlock();
+
+    // Writers above frame size wait here while the disk is slow: it bounds the collected frame size.
+    Flush();
+}
+
+int RotatingFileLogBackend::Flush()
+{
+    std::lock_guard writeLock {mWriteMutex};
+
+    return FlushFrame();
+}
+
+int ReadRotatedLogs(
+    const RotatingLogConfig& config, LogFrameCodec& codec, int64_t fromUs, int64_t tillUs, const LogLineFunc& lineFunc)
+{
+    std::vector<LogFile> files;
+
+    if (auto err = GetLogFiles(config, files); err != 0) {
+        return err;
+    }
+
+    std::vector<LogFrameInfo> frames;
+    std::string               compressed, raw;
+
+    for (const auto& file : files) {
+        frames.clear();
+
+        // Index is written after frame: frames without index entry are incomplete.
+        if (ReadIndex(file.mPath + std::string(cIndexSuffix), frames) != 0 || frames.empty()) {
+            continue;
+        }
+
+        if (frames.front().mFirstTimeUs > tillUs) {
+            break;
+        }
+
+        auto fd = open(file.mPath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+
+        auto err = 0;
+
+        for (const auto& frame : frames) {
+            if (frame.mLastTimeUs < fromUs || frame.mFirstTimeUs > tillUs) {
+                continue;
+            }
+
+            if (err = ReadAt(fd, compressed, frame.mSize, frame.mOffset); err != 0) {
+                break;
+            }
+
+            if (err = codec.Decompress(compressed, frame.mRawSize, raw); err != 0) {
+                break;
+            }
+
+            for (std::string_view rest(raw); !rest.empty();) {
+                auto line = rest.substr(0, rest.find('\n'));
+                auto time = ParseLineTime(line);
+
+                rest.remove_prefix(std::min(line.size() + 1, rest.size()));
+
+                if (time < fromUs || time > tillUs) {
+                    continue;
+                }
+
+                if (!lineFunc(time, line)) {
+                    close(fd);
+
+                    return 0;
+                }
+            }
+        }
+
+        close(fd);
+
+        if (err != 0) {
+            return err;
+        }
+    }
+
+    return 0;
+}
+
+/***********************************************************************************************************************
+ * Private
+ **********************************************************************************************************************/
+
+void RotatingFileLogBackend::RunFlush()
+{
+    std::unique_lock lock {mMutex};
+
+    while (!mFlushCondVar.wait_for(lock, mConfig.mFlushInterval, [this]() { return mStopFlush; })) {
+        lock.unlock();
+        Flush();
+        lock.lock();
+    }
+}
+
+int RotatingFileLogBackend::FlushFrame()
+{
+    LogFrameInfo info;
+
+    {
+        std::lock_guard lock {mMutex};
+
+        if (mFrame.empty()) {
+            return 0;
+        }
+
+        // Buffers are swapped keeping their capacity: writers collect the next frame while this one is written.
+        mWriteFrame.clear();
+        mWriteFrame.swap(mFrame);
+        info = mFrameInfo;
+    }
+
+    // Failed frame is dropped: retrying it would grow memory without bound while the disk is full or broken.
+    return WriteFrame(info);
+}
+
+int RotatingFileLogBackend::WriteFrame(const LogFrameInfo& info)
+{
+    // Log file is reopened if previous rotation failed.
+    if (mLogFD < 0) {
+        if (auto err = OpenFile(); err != 0) {
+            return err;
+        }
+    }
+
+    if (mFileSize == 0) {
+        mFileStart = info.mFirstTimeUs;
+    }
+
+    mCompressed.clear();
+
+    if (auto err = mCodec.Compress(mWriteFrame, mCompressed); err != 0) {
+        return err;
+    }
+
+    auto frameInfo = info;
+
+    frameInfo.mOffset  = mFileSize;
+    frameInfo.mSize    = mCompressed.size();
+    frameInfo.mRawSize = mWriteFrame.size();
+
+    // Frame is written at known offset: data of failed write is overwritten by next frame.
+    if (auto err = WriteAt(mLogFD, mCompressed, mFileSize); err != 0) {
+        return err;
+    }
+
+    // "<offset> <size> <raw size> <first time> <last time>\n"
+    mIndexEntry.clear();
+
+    utils::AppendNumber(mIndexEntry, frameInfo.mOffset);
+    mIndexEntry += ' ';
+    utils::AppendNumber(mIndexEntry, frameInfo.mSize);
+    mIndexEntry += ' ';
+    utils::AppendNumber(mIndexEntry, frameInfo.mRawSize);
+    mIndexEntry += ' ';
+    utils::AppendNumber(mIndexEntry, frameInfo.mFirstTimeUs);
+    mIndexEntry += ' ';
+    utils::AppendNumber(mIndexEntry, frameInfo.mLastTimeUs);
+    mIndexEntry += '\n';
+
+    if (auto err = WriteAt(mIndexFD, mIndexEntry, mIndexSize); err != 0) {
+        return err;
+    }
+
+    mFileSize += mCompressed.size();
+    mIndexSize += mIndexEntry.size();
+
+    auto maxAgeUs = std::chrono::duration_cast<std::chrono::microseconds>(mConfig.mMaxFileAge).count();
+
+    if (mFileSize >= mConfig.mMaxFileSize || frameInfo.mLastTimeUs - mFileStart >= maxAgeUs) {
+        CloseFile();
+
+        return OpenFile();
+    }
+
+    return 0;
+}
+
+int RotatingFileLogBackend::OpenFile()
+{
+    auto path = GetLogFilePath(mConfig, ++mSequence);
+
+    mLogFD = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0640);
+    if (mLogFD < 0) {
+        return errno;
+    }
+
+    mIndexFD = open((path + std::string(cIndexSuffix)).c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0640);
+    if (mIndexFD < 0) {
+        auto err = errno;
+
+        CloseFile();
+
+        return err;
+    }
+
+    mFileSize  = 0;
+    mIndexSize = 0;
+
+    RemoveOldFiles();
+
+    return 0;
+}
+
+void RotatingFileLogBackend::CloseFile()
+{
+    if (mLogFD >= 0) {
+        close(mLogFD);
+        mLogFD = -1;
+    }
+
+    if (mIndexFD >= 0) {
+        close(mIndexFD);
+        mIndexFD = -1;
+    }
+}
+
+void RotatingFileLogBackend::RemoveOldFiles()
+{
+    std::vector<LogFile> files;
+
+    if (GetLogFiles(mConfig, files) != 0 || files.size() <= mConfig.mMaxFiles) {
+        return;
+    }
+
+    for (size_t i = 0; i < files.size() - mConfig.mMaxFiles; i++) {
+        unlink(files[i].mPath.c_str());
+        unlink((files[i].mPath + std::string(cIndexSuffix)).c_str());
+    }
+}
+
+} // namespace aos::common::logger
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ROTATINGLOG_HPP_
+#define ROTATINGLOG_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "structuredlog.hpp"
+
+namespace aos::common::logger {
+
+/**
+ * Log frame codec: compresses each frame independently.
+ */
+class LogFrameCodec {
+public:
+    /**
+     * Destroys log frame codec.
+     */
+    virtual ~LogFrameCodec() = default;
+
+    /**
+     * Compresses frame.
+     *
+     * @param data raw frame.
+     * @param[out] out compressed frame.
+     * @return int 0 on success or errno value on failure.
+     */
+    virtual int Compress(std::string_view data, std::string& out) = 0;
+
+    /**
+     * Decompresses frame.
+     *
+     * @param data compressed frame.
+     * @param rawSize raw frame size.
+     * @param[out] out raw frame.
+     * @return int 0 on success or errno value on failure.
+     */
+    virtual int Decompress(std::string_view data, size_t rawSize, std::string& out) = 0;
+};
+
+/**
+ * Stores frames as is.
+ */
+class RawLogFrameCodec : public LogFrameCodec {
+public:
+    int Compress(std::string_view data, std::string& out) override;
+    int Decompress(std::string_view data, size_t rawSize, std::string& out) override;
+};
+
+/**
+ * Rotating log config.
+ */
+struct RotatingLogConfig {
+    std::string          mDir;
+    std::string          mPrefix      = "aos";
+    size_t               mFrameSize   = 64 * 1024;
+    size_t               mMaxFileSize = 8 * 1024 * 1024;
+    std::chrono::seconds mMaxFileAge {3600};
+    // Should be at least 1: the current file is never removed.
+    size_t mMaxFiles = 8;
+    // Pending frame is flushed by background thread at this interval, 0 disables periodic flush.
+    std::chrono::milliseconds mFlushInterval {1000};
+};
+
+/**
+ * Log frame index entry.
+ */
+struct LogFrameInfo {
+    uint64_t mOffset      = 0;
+    uint64_t mSize        = 0;
+    uint64_t mRawSize     = 0;
+    int64_t  mFirstTimeUs = 0;
+    int64_t  mLastTimeUs  = 0;
+};
+
+/**
+ * Log file backend with rotation and independently compressed frames.
+ *
+ * Records are formatted as JSON lines and collected into a frame. Full frame is compressed and appended to the
+ * current log file "<prefix>.<seq>.log"; frame offset, sizes and time range are appended to the "<file>.idx" index.
+ * Reader selects frames by time range from the index and decompresses only them. File is rotated by size or age,
+ * oldest files above max files count are removed.
+ *
+ * Pending frame is written when full, on Flush, every flush interval and on destruction: records of the last flush
+ * interval are lost on crash. Full frame is compressed and written without blocking writers of the next frame. Frame
+ * which can't be compressed or written is dropped, so memory stays bounded while the disk is full or broken.
+ */
+class RotatingFileLogBackend : public LogBackend {
+public:
+    /**
+     * Creates rotating file log backend.
+     *
+     * @param codec frame codec, should outlive the backend.
+     */
+    explicit RotatingFileLogBackend(LogFrameCodec& codec)
+        : mCodec(codec)
+    {
+    }
+
+    /**
+     * Flushes pending frame and closes log file.
+     */
+    ~RotatingFileLogBackend() override;
+
+    /**
+     * Initializes backend: new log file is started after existing ones.
+     *
+     * @param config config.
+     * @return int 0 on success, EINVAL if max files is 0, EBUSY if already initialized or errno value on failure.
+     */
+    int Init(const RotatingLogConfig& config);
+
+    void Write(const LogRecord& record) override;
+
+    /**
+     * Writes pending frame.
+     *
+     * @return int 0 on success or errno value on failure.
+     */
+    int Flush();
+
+private:
+    void RunFlush();
+    int  FlushFrame();
+    int  WriteFrame(const LogFrameInfo& info);
+    int  OpenFile();
+    void CloseFile();
+    void RemoveOldFiles();
+
+    LogFrameCodec&    mCodec;
+    RotatingLogConfig mConfig;
+    // Guards collected frame and flush thread state.
+    std::mutex              mMutex;
+    std::condition_variable mFlushCondVar;
+    bool                    mEnabled   = false;
+    bool                    mStopFlush = false;
+    std::string             mFrame;
+    LogFrameInfo            mFrameInfo;
+    std::thread             mFlushThread;
+    // Serializes frame compression and file writes, acquired before mMutex.
+    std::mutex  mWriteMutex;
+    std::string mWriteFrame;
+    std::string mCompressed;
+    std::string mIndexEntry;
+    uint64_t    mSequence  = 0;
+    int         mLogFD     = -1;
+    int         mIndexFD   = -1;
+    uint64_t    mFileSize  = 0;
+    uint64_t    mIndexSize = 0;
+    int64_t     mFileStart = 0;
+};
+
+/**
+ * Log line callback: returns false to stop reading.
+ */
+using LogLineFunc = std::function<bool(int64_t timeUs, std::string_view line)>;
+
+/**
+ * Reads logs of time range from rotated log files. Only frames which time range overlaps the requested one are read.
+ *
+ * @param config log config.
+ * @param codec frame codec.
+ * @param fromUs range begin, microseconds since epoch.
+ * @param tillUs range end, microseconds since epoch.
+ * @param lineFunc log line callback.
+ * @return int 0 on success or errno value on failure.
+ */
+int ReadRotatedLogs(
+    const RotatingLogConfig& config, LogFrameCodec& codec, int64_t fromUs, int64_t tillUs, const LogLineFunc& lineFunc);
+
+} // namespace aos::common::logger
+
+#endif
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+
+#include <unistd.h>
+
+#include "structuredlog.hpp"
+#include "utils/jsontemplate.hpp"
+#include "utils/numberformat.hpp"
+
+namespace aos::common::logger {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Vars
+ **********************************************************************************************************************/
+
+std::atomic<LogBackend*> sBackend {nullptr};
+std::atomic<LogLevel>    sLevel {LogLevel::eInfo};
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+void AppendValue(std::string& out, const LogFieldValue& value, bool quoteString)
+{
+    std::visit(
+        [&](const auto& arg) {
+            using T = std::decay_t<decltype(arg)>;
+
+            if constexpr (std::is_same_v<T, bool>) {
+                out += arg ? "true" : "false";
+            } else if constexpr (std::is_same_v<T, double>) {
+                // JSON has no NaN and infinity.
+                if (quoteString && !std::isfinite(arg)) {
+                    out += "null";
+                } else {
+                    utils::AppendNumber(out, arg);
+                }
+            } else if constexpr (std::is_same_v<T, std::string_view>) {
+                if (quoteString) {
+                    utils::AppendJSONString(out, arg);
+                } else {
+                    out += arg;
+                }
+            } else {
+                utils::AppendNumber(out, arg);
+            }
+        },
+        value);
+}
+
+std::string& GetThreadBuffer()
+{
+    thread_local std::string buffer;
+
+    buffer.clear();
+
+    return buffer;
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+void SetLogBackend(LogBackend* backend)
+{
+    sBackend.store(backend, std::memory_order_release);
+}
+
+void SetLogLevel(LogLevel level)
+{
+    sLevel.store(level, std::memory_order_relaxed);
+}
+
+bool IsLogEnabled(LogLevel level)
+{
+    return level >= sLevel.load(std::memory_order_relaxed) && sBackend.load(std::memory_order_acquire) != nullptr;
+}
+
+std::string_view GetLogLevelName(LogLevel level)
+{
+    switch (level) {
+    case LogLevel::eDebug:
+        return "debug";
+
+    case LogLevel::eInfo:
+        return "info";
+
+    case LogLevel::eWarning:
+        return "warning";
+
+    default:
+        return "error";
+    }
+}
+
+void FormatLogRecord(const LogRecord& record, std::string& out)
+{
+    out += record.mMessage;
+
+    for (size_t i = 0; i < record.mFieldCount; i++) {
+        out += ' ';
+        out += record.mFields[i].mKey;
+        out += '=';
+
+        AppendValue(out, record.mFields[i].mValue, false);
+    }
+
+    for (auto frame = record.mContext; frame != nullptr; frame = frame->mParent) {
+        out += ' ';
+        out += frame->mKey;
+        out += '=';
+        out += frame->mValue;
+    }
+}
+
+void FormatLogRecordJSON(const LogRecord& record, std::string& out)
+{
+    out += "{\"time\":";
+    utils::AppendNumber(out,
+        std::chrono::duration_cast<std::chrono::microseconds>(record.mTime.time_since_epoch()).count());
+    out += ",\"level\":\"";
+    out += GetLogLevelName(record.mLevel);
+    out += "\",\"msg\":";
+    utils::AppendJSONString(out, record.mMessage);
+
+    for (size_t i = 0; i < record.mFieldCount; i++) {
+        out += ',';
+        utils::AppendJSONString(out, record.mFields[i].mKey);
+        out += ':';
+
+        AppendValue(out, record.mFields[i].mValue, true);
+    }
+
+    for (auto frame = record.mContext; frame != nullptr; frame = frame->mParent) {
+        out += ',';
+        utils::AppendJSONString(out, frame->mKey);
+        out += ':';
+        utils::AppendJSONString(out, frame->mValue);
+    }
+
+    out += '}';
+}
+
+void JSONLinesLogBackend::Write(const LogRecord& record)
+{
+    auto& line = GetThreadBuffer();
+
+    FormatLogRecordJSON(record, line);
+    line += '\n';
+
+    // Single write per record: lines from different threads are not interleaved.
+    for (size_t offset = 0; offset < line.size();) {
+        auto n = write(mFD, line.data() + offset, line.size() - offset);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (n <= 0) {
+            break;
+        }
+
+        offset += static_cast<size_t>(n);
+    }
+}
+
+LogRecordBuilder::LogRecordBuilder(LogLevel level, std::string_view message, std::string_view file, int line)
+    : mBackend(level >= sLevel.load(std::memory_order_relaxed) ? sBackend.load(std::memory_order_acquire) : nullptr)
+{
+    if (mBackend == nullptr) {
+        return;
+    }
+
+    auto& record = mRecord.emplace();
+
+    record.mTime    = std::chrono::system_clock::now();
+    record.mLevel   = level;
+    record.mMessage = message;
+    record.mFile    = file;
+    record.mLine    = line;
+    record.mContext = GetLogContext();
+}
+
+LogRecordBuilder::~LogRecordBuilder()
+{
+    if (!mRecord) {
+        return;
+    }
+
+    for (size_t i = 0; i < mRecord->mFieldCount; i++) {
+        if (auto str = std::get_if<std::string_view>(&mRecord->mFields[i].mValue); str != nullptr) {
+            *str = std::string_view(mStrings).substr(mStringRefs[i].mOffset, mStringRefs[i].mSize);
+        }
+    }
+
+    mBackend->Write(*mRecord);
+}
+
+} // namespace aos::common::logger
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef STRUCTUREDLOG_HPP_
+#define STRUCTUREDLOG_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+#include "logcontext.hpp"
+
+namespace aos::common::logger {
+
+/**
+ * Log level.
+ */
+enum class LogLevel { eDebug, eInfo, eWarning, eError };
+
+/**
+ * Typed log field value. Strings reference the builder's copy and are valid during the backend Write call only.
+ */
+using LogFieldValue = std::variant<bool, int64_t, uint64_t, double, std::string_view>;
+
+/**
+ * Log field.
+ */
+struct LogField {
+    std::string_view mKey;
+    LogFieldValue    mValue;
+};
+
+/**
+ * Structured log record. Valid during the backend Write call only.
+ */
+struct LogRecord {
+    static constexpr size_t cMaxFields = 16;
+
+    std::chrono::system_clock::time_point mTime;
+    LogLevel                              mLevel = LogLevel::eInfo;
+    std::string_view                      mMessage;
+    std::string_view                      mFile;
+    int                                   mLine = 0;
+    std::array<LogField, cMaxFields>      mFields;
+    size_t                                mFieldCount = 0;
+    // Thread log context, innermost frame first.
+    const LogContextFrame*                mContext    = nullptr;
+};
+
+/**
+ * Log backend: renders records into its native format, e.g. journald fields or JSON lines.
+ */
+class LogBackend {
+public:
+    /**
+     * Destroys log backend.
+     */
+    virtual ~LogBackend() = default;
+
+    /**
+     * Writes log record. Called concurrently from different threads.
+     *
+     * @param record log record.
+     */
+    virtual void Write(const LogRecord& record) = 0;
+};
+
+/**
+ * Writes records as JSON lines into file descriptor.
+ */
+class JSONLinesLogBackend : public LogBackend {
+public:
+    /**
+     * Creates JSON lines log backend.
+     *
+     * @param fd output file descriptor, not owned.
+     */
+    explicit JSONLinesLogBackend(int fd)
+        : mFD(fd)
+    {
+    }
+
+    void Write(const LogRecord& record) override;
+
+private:
+    int mFD;
+};
+
+/**
+ * Sets log backend.
+ *
+ * @param backend log backend, nullptr disables logging. Should outlive logging.
+ */
+void SetLogBackend(LogBackend* backend);
+
+/**
+ * Sets min log level.
+ *
+ * @param level log level.
+ */
+void SetLogLevel(LogLevel level);
+
+/**
+ * Returns true if records of the level are written.
+ *
+ * @param level log level.
+ * @return bool.
+ */
+bool IsLogEnabled(LogLevel level);
+
+/**
+ * Returns log level name.
+ *
+ * @param level log level.
+ * @return std::string_view.
+ */
+std::string_view GetLogLevelName(LogLevel level);
+
+/**
+ * Formats log record as "message key=value ..." text line without trailing newline. Context fields follow record
+ * fields.
+ *
+ * @param record log record.
+ * @param[out] out output.
+ */
+void FormatLogRecord(const LogRecord& record, std::string& out);
+
+/**
+ * Formats log record as JSON object with "time" (microseconds since epoch), "level", "msg", field and context keys,
+ * without trailing newline.
+ *
+ * @param record log record.
+ * @param[out] out output.
+ */
+void FormatLogRecordJSON(const LogRecord& record, std::string& out);
+
+/**
+ * Builds log record and writes it to the backend at the end of the log statement.
+ *
+ * Fields are stored typed in the record without any formatting. String values are copied into the builder's buffer:
+ * temporaries passed to Field, e.g. std::to_string(id), are destroyed before the record is written at the end of the
+ * statement. Keys are referenced and should be string literals. If the level is disabled, Field calls do nothing.
+ * Fields above LogRecord::cMaxFields are dropped.
+ */
+class LogRecordBuilder {
+public:
+    /**
+     * Creates log record builder.
+     *
+     * @param level log level.
+     * @param message log message.
+     * @param file source file.
+     * @param line source line.
+     */
+    LogRecordBuilder(LogLevel level, std::string_view message, std::string_view file, int line);
+
+    /**
+     * Writes record.
+     */
+    ~LogRecordBuilder();
+
+    LogRecordBuilder(const LogRecordBuilder&)            = delete;
+    LogRecordBuilder& operator=(const LogRecordBuilder&) = delete;
+
+    /**
+     * Adds field.
+     *
+     * @param key field key, should outlive the log statement.
+     * @param value field value: bool, arithmetic or string.
+     * @return LogRecordBuilder&.
+     */
+    template <typename T>
+    LogRecordBuilder& Field(std::string_view key, const T& value)
+    {
+        if (!mRecord || mRecord->mFieldCount == LogRecord::cMaxFields) {
+            return *this;
+        }
+
+        auto& field = mRecord->mFields[mRecord->mFieldCount++];
+
+        field.mKey = key;
+
+        if constexpr (std::is_same_v<T, bool>) {
+            field.mValue = value;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            field.mValue = static_cast<double>(value);
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            field.mValue = static_cast<int64_t>(value);
+        } else if constexpr (std::is_integral_v<T>) {
+            field.mValue = static_cast<uint64_t>(value);
+        } else if constexpr (std::is_enum_v<T>) {
+            field.mValue = static_cast<int64_t>(value);
+        } else {
+            std::string_view str(value);
+
+            // View is set on write: buffer may be reallocated by next fields.
+            field.mValue                          = std::string_view();
+            mStringRefs[mRecord->mFieldCount - 1] = {mStrings.size(), str.size()};
+            mStrings.append(str);
+        }
+
+        return *this;
+    }
+
+private:
+    struct StringRef {
+        size_t mOffset;
+        size_t mSize;
+    };
+
+    LogBackend* mBackend;
+    // Constructed for enabled level only.
+    std::optional<LogRecord>                     mRecord;
+    std::string                                  mStrings;
+    std::array<StringRef, LogRecord::cMaxFields> mStringRefs {};
+};
+
+} // namespace aos::common::logger
+
+#define SLOG(level, message) aos::common::logger::LogRecordBuilder(level, message, __FILE__, __LINE__)
+
+#define SLOG_DBG(message) SLOG(aos::common::logger::LogLevel::eDebug, message)
+#define SLOG_INF(message) SLOG(aos::common::logger::LogLevel::eInfo, message)
+#define SLOG_WRN(message) SLOG(aos::common::logger::LogLevel::eWarning, message)
+#define SLOG_ERR(message) SLOG(aos::common::logger::LogLevel::eError, message)
+
+#endif
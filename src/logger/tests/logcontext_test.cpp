@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "logger/logcontext.hpp"
+
+using namespace testing;
+
+namespace aos::common::logger {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+// Returns context as "key=value" pairs, outermost first.
+std::string FormatContext()
+{
+    std::string result;
+
+    for (auto frame = GetLogContext(); frame != nullptr; frame = frame->mParent) {
+        result.insert(0, std::string(frame->mKey) + "=" + std::string(frame->mValue) + (result.empty() ? "" : " "));
+    }
+
+    return result;
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST(LogContextTest, CopiesValue)
+{
+    const std::string longValue(100, 'v');
+
+    {
+        ScopedLogContext instance("instance", std::to_string(42));
+        ScopedLogContext request("request", std::string(longValue));
+
+        EXPECT_EQ(FormatContext(), "instance=42 request=" + longValue);
+    }
+
+    EXPECT_EQ(GetLogContext(), nullptr);
+}
+
+TEST(LogContextTest, Snapshot)
+{
+    for (auto depth : {1, 4, 9}) {
+        std::string expected;
+
+        {
+            std::vector<std::unique_ptr<ScopedLogContext>> scopes;
+
+            for (auto i = 0; i < depth; i++) {
+                scopes.push_back(std::make_unique<ScopedLogContext>("key", std::to_string(i)));
+                expected += (i == 0 ? "" : " ") + std::string("key=") + std::to_string(i);
+            }
+
+            auto task = BindLogContext([]() { return FormatContext(); });
+
+            // Scopes are popped innermost first.
+            while (!scopes.empty()) {
+                scopes.pop_back();
+            }
+
+            ASSERT_EQ(GetLogContext(), nullptr);
+
+            std::string result;
+
+            std::thread([&]() {
+                ScopedLogContext outer("thread", "worker");
+
+                result = task();
+
+                EXPECT_EQ(FormatContext(), "thread=worker");
+            }).join();
+
+            EXPECT_EQ(result, "thread=worker " + expected) << depth;
+        }
+    }
+
+    EXPECT_TRUE(LogContextSnapshot::Capture().IsEmpty());
+    EXPECT_EQ(BindLogContext([]() { return GetLogContext(); })(), nullptr);
+}
+
+} // namespace aos::common::logger
@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <filesystem>
+#include <thread>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "logger/rotatinglog.hpp"
+
+using namespace testing;
+
+namespace aos::common::logger {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+class FailingLogFrameCodec : public RawLogFrameCodec {
+public:
+    int Compress(std::string_view data, std::string& out) override
+    {
+        return mFail ? EIO : RawLogFrameCodec::Compress(data, out);
+    }
+
+    bool mFail = false;
+};
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Suite
+ **********************************************************************************************************************/
+
+class RotatingLogTest : public Test {
+protected:
+    void SetUp() override
+    {
+        mConfig.mDir           = fs::temp_directory_path() / ("rotatinglog_test_" + std::to_string(getpid()));
+        mConfig.mFlushInterval = std::chrono::milliseconds(0);
+
+        fs::remove_all(mConfig.mDir);
+        fs::create_directories(mConfig.mDir);
+    }
+
+    void TearDown() override { fs::remove_all(mConfig.mDir); }
+
+    static void WriteRecord(LogBackend& backend, std::string_view message, int64_t timeUs)
+    {
+        LogRecord record;
+
+        record.mTime    = std::chrono::system_clock::time_point(std::chrono::microseconds(timeUs));
+        record.mMessage = message;
+
+        backend.Write(record);
+    }
+
+    std::vector<std::string> ReadLogs(int64_t fromUs = 0, int64_t tillUs = INT64_MAX)
+    {
+        std::vector<std::string> lines;
+        RawLogFrameCodec         codec;
+
+        EXPECT_EQ(ReadRotatedLogs(mConfig, codec, fromUs, tillUs,
+                      [&lines](int64_t, std::string_view line) {
+                          lines.emplace_back(line);
+
+                          return true;
+                      }),
+            0);
+
+        return lines;
+    }
+
+    size_t GetLogFileCount() const
+    {
+        size_t count = 0;
+
+        for (const auto& entry : fs::directory_iterator(mConfig.mDir)) {
+            count += entry.path().extension() == ".log";
+        }
+
+        return count;
+    }
+
+    RotatingLogConfig mConfig;
+};
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST_F(RotatingLogTest, WriteRead)
+{
+    RawLogFrameCodec       codec;
+    RotatingFileLogBackend backend(codec);
+
+    ASSERT_EQ(backend.Init(mConfig), 0);
+    EXPECT_EQ(backend.Init(mConfig), EBUSY);
+
+    WriteRecord(backend, "first", 1000);
+    WriteRecord(backend, "second", 2000);
+
+    EXPECT_TRUE(ReadLogs().empty());
+    ASSERT_EQ(backend.Flush(), 0);
+
+    WriteRecord(backend, "third", 3000);
+    ASSERT_EQ(backend.Flush(), 0);
+
+    auto lines = ReadLogs(1500, 3000);
+
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[0], R"({"time":2000,"level":"info","msg":"second"})");
+    EXPECT_EQ(lines[1], R"({"time":3000,"level":"info","msg":"third"})");
+}
+
+TEST_F(RotatingLogTest, Rotation)
+{
+    mConfig.mFrameSize   = 1;
+    mConfig.mMaxFileSize = 1;
+    mConfig.mMaxFiles    = 3;
+
+    RawLogFrameCodec codec;
+
+    {
+        RotatingFileLogBackend backend(codec);
+
+        ASSERT_EQ(backend.Init(mConfig), 0);
+
+        for (auto i = 0; i < 10; i++) {
+            WriteRecord(backend, "record " + std::to_string(i), i + 1);
+        }
+    }
+
+    EXPECT_EQ(GetLogFileCount(), 3u);
+
+    // The last file is empty: it is opened on rotation after the last frame.
+    auto lines = ReadLogs();
+
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[0], R"({"time":9,"level":"info","msg":"record 8"})");
+    EXPECT_EQ(lines[1], R"({"time":10,"level":"info","msg":"record 9"})");
+}
+
+TEST_F(RotatingLogTest, ZeroMaxFiles)
+{
+    RawLogFrameCodec       codec;
+    RotatingFileLogBackend backend(codec);
+
+    mConfig.mMaxFiles = 0;
+
+    EXPECT_EQ(backend.Init(mConfig), EINVAL);
+    EXPECT_EQ(GetLogFileCount(), 0u);
+}
+
+TEST_F(RotatingLogTest, FailedFrameIsDropped)
+{
+    FailingLogFrameCodec   codec;
+    RotatingFileLogBackend backend(codec);
+
+    ASSERT_EQ(backend.Init(mConfig), 0);
+
+    codec.mFail = true;
+
+    WriteRecord(backend, "lost", 1000);
+    EXPECT_EQ(backend.Flush(), EIO);
+
+    codec.mFail = false;
+
+    WriteRecord(backend, "written", 2000);
+    ASSERT_EQ(backend.Flush(), 0);
+
+    auto lines = ReadLogs();
+
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_EQ(lines[0], R"({"time":2000,"level":"info","msg":"written"})");
+}
+
+TEST_F(RotatingLogTest, PeriodicFlush)
+{
+    mConfig.mFlushInterval = std::chrono::milliseconds(20);
+
+    RawLogFrameCodec       codec;
+    RotatingFileLogBackend backend(codec);
+
+    ASSERT_EQ(backend.Init(mConfig), 0);
+
+    WriteRecord(backend, "flushed", 1000);
+
+    for (auto i = 0; i < 100 && ReadLogs().empty(); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    EXPECT_EQ(ReadLogs().size(), 1u);
+}
+
+TEST_F(RotatingLogTest, ConcurrentWriters)
+{
+    constexpr auto cThreadCount = 4;
+    constexpr auto cRecordCount = 1000;
+
+    mConfig.mFrameSize     = 4096;
+    mConfig.mFlushInterval = std::chrono::milliseconds(1);
+
+    RawLogFrameCodec codec;
+
+    {
+        RotatingFileLogBackend   backend(codec);
+        std::vector<std::thread> threads;
+
+        ASSERT_EQ(backend.Init(mConfig), 0);
+
+        for (auto i = 0; i < cThreadCount; i++) {
+            threads.emplace_back([&backend, i]() {
+                for (auto j = 0; j < cRecordCount; j++) {
+                    WriteRecord(backend, "thread " + std::to_string(i), j + 1);
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    EXPECT_EQ(ReadLogs().size(), static_cast<size_t>(cThreadCount * cRecordCount));
+}
+
+} // namespace aos::common::logger
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "logger/structuredlog.hpp"
+
+using namespace testing;
+
+namespace aos::common::logger {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+class TextLogBackend : public LogBackend {
+public:
+    void Write(const LogRecord& record) override
+    {
+        std::string line;
+
+        FormatLogRecord(record, line);
+        mLines.push_back(std::move(line));
+
+        line.clear();
+        FormatLogRecordJSON(record, line);
+
+        // Time is not deterministic.
+        mJSONLines.push_back(line.substr(line.find(",\"level\"")));
+    }
+
+    std::vector<std::string> mLines;
+    std::vector<std::string> mJSONLines;
+};
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Suite
+ **********************************************************************************************************************/
+
+class StructuredLogTest : public Test {
+protected:
+    void SetUp() override
+    {
+        SetLogBackend(&mBackend);
+        SetLogLevel(LogLevel::eInfo);
+    }
+
+    void TearDown() override { SetLogBackend(nullptr); }
+
+    TextLogBackend mBackend;
+};
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST_F(StructuredLogTest, Fields)
+{
+    SLOG_INF("instance started").Field("id", "app0").Field("pid", -1).Field("mem", 1024u).Field("ok", true);
+
+    ASSERT_EQ(mBackend.mLines.size(), 1u);
+    EXPECT_EQ(mBackend.mLines[0], "instance started id=app0 pid=-1 mem=1024 ok=true");
+    EXPECT_EQ(mBackend.mJSONLines[0],
+        R"(,"level":"info","msg":"instance started","id":"app0","pid":-1,"mem":1024,"ok":true})");
+}
+
+TEST_F(StructuredLogTest, TemporaryStringValues)
+{
+    // Temporaries are destroyed before the record is written: builder should keep own copies.
+    SLOG_WRN("temporary values")
+        .Field("first", std::to_string(1234567890123456789LL) + " long enough to avoid small string optimization")
+        .Field("second", std::string(100, 'x'))
+        .Field("third", std::string("y"));
+
+    ASSERT_EQ(mBackend.mLines.size(), 1u);
+    EXPECT_EQ(mBackend.mLines[0],
+        "temporary values first=1234567890123456789 long enough to avoid small string optimization second="
+            + std::string(100, 'x') + " third=y");
+}
+
+TEST_F(StructuredLogTest, NonFiniteNumbers)
+{
+    SLOG_ERR("non finite")
+        .Field("nan", std::numeric_limits<double>::quiet_NaN())
+        .Field("inf", std::numeric_limits<double>::infinity())
+        .Field("ninf", -std::numeric_limits<float>::infinity())
+        .Field("value", 0.5);
+
+    ASSERT_EQ(mBackend.mJSONLines.size(), 1u);
+    EXPECT_EQ(mBackend.mJSONLines[0],
+        R"(,"level":"error","msg":"non finite","nan":null,"inf":null,"ninf":null,"value":0.5})");
+}
+
+TEST_F(StructuredLogTest, DisabledLevel)
+{
+    SLOG_DBG("debug").Field("id", std::string("app0"));
+
+    EXPECT_TRUE(mBackend.mLines.empty());
+    EXPECT_FALSE(IsLogEnabled(LogLevel::eDebug));
+    EXPECT_TRUE(IsLogEnabled(LogLevel::eWarning));
+}
+
+TEST_F(StructuredLogTest, Context)
+{
+    ScopedLogContext instance("instance", "app0");
+
+    {
+        ScopedLogContext request("request", "42");
+
+        SLOG_INF("in context");
+    }
+
+    ASSERT_EQ(mBackend.mLines.size(), 1u);
+    EXPECT_EQ(mBackend.mLines[0], "in context request=42 instance=app0");
+}
+
+} // namespace aos::common::logger
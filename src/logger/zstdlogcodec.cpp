@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+
+#include <zstd.h>
+
+#include "zstdlogcodec.hpp"
+
+namespace aos::common::logger {
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+ZstdLogFrameCodec::ZstdLogFrameCodec(int level)
+    : mLevel(level)
+    , mCCtx(ZSTD_createCCtx())
+    , mDCtx(ZSTD_createDCtx())
+{
+}
+
+ZstdLogFrameCodec::~ZstdLogFrameCodec()
+{
+    ZSTD_freeCCtx(mCCtx);
+    ZSTD_freeDCtx(mDCtx);
+}
+
+int ZstdLogFrameCodec::Compress(std::string_view data, std::string& out)
+{
+    if (mCCtx == nullptr) {
+        return ENOMEM;
+    }
+
+    out.resize(ZSTD_compressBound(data.size()));
+
+    auto size = ZSTD_compressCCtx(mCCtx, out.data(), out.size(), data.data(), data.size(), mLevel);
+    if (ZSTD_isError(size)) {
+        return EIO;
+    }
+
+    out.resize(size);
+
+    return 0;
+}
+
+int ZstdLogFrameCodec::Decompress(std::string_view data, size_t rawSize, std::string& out)
+{
+    if (mDCtx == nullptr) {
+        return ENOMEM;
+    }
+
+    out.resize(rawSize);
+
+    auto size = ZSTD_decompressDCtx(mDCtx, out.data(), out.size(), data.data(), data.size());
+    if (ZSTD_isError(size) || size != rawSize) {
+        return EINVAL;
+    }
+
+    return 0;
+}
+
+} // namespace aos::common::logger
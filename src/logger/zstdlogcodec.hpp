@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZSTDLOGCODEC_HPP_
+#define ZSTDLOGCODEC_HPP_
+
+#include "rotatinglog.hpp"
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+
+namespace aos::common::logger {
+
+/**
+ * Compresses each log frame into standalone zstd frame: log file is also readable by zstdcat as a whole.
+ *
+ * Compression and decompression contexts are reused. Not thread safe: writer and reader should use separate
+ * instances.
+ */
+class ZstdLogFrameCodec : public LogFrameCodec {
+public:
+    /**
+     * Creates zstd log frame codec.
+     *
+     * @param level compression level.
+     */
+    explicit ZstdLogFrameCodec(int level = 3);
+
+    /**
+     * Destroys zstd log frame codec.
+     */
+    ~ZstdLogFrameCodec() override;
+
+    ZstdLogFrameCodec(const ZstdLogFrameCodec&)            = delete;
+    ZstdLogFrameCodec& operator=(const ZstdLogFrameCodec&) = delete;
+
+    int Compress(std::string_view data, std::string& out) override;
+    int Decompress(std::string_view data, size_t rawSize, std::string& out) override;
+
+private:
+    int          mLevel;
+    ZSTD_CCtx_s* mCCtx;
+    ZSTD_DCtx_s* mDCtx;
+};
+
+} // namespace aos::common::logger
+
+#endif
@@ -0,0 +1,375 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <queue>
+
+#include "alertmatcher.hpp"
+
+namespace aos::common::logprovider {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Consts
+ **********************************************************************************************************************/
+
+// Shorter literals match too often to be worth the prefilter.
+constexpr auto     cMinLiteralSize = 3;
+constexpr uint32_t cNoTransition   = UINT32_MAX;
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+size_t GetEscapeOperandSize(std::string_view pattern, size_t pos)
+{
+    auto   chr  = pattern[pos];
+    size_t size = 0;
+
+    switch (chr) {
+    case 'x':
+        size = 2;
+
+        break;
+
+    case 'u':
+        size = 4;
+
+        break;
+
+    case 'c':
+        size = 1;
+
+        break;
+
+    default:
+        for (auto i = pos + 1; std::isdigit(static_cast<unsigned char>(chr)) && i < pattern.size(); i++, size++) {
+            if (!std::isdigit(static_cast<unsigned char>(pattern[i]))) {
+                break;
+            }
+        }
+    }
+
+    return std::min(size, pattern.size() - pos - 1);
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Literal extraction
+ **********************************************************************************************************************/
+
+namespace alertmatcher {
+
+std::string ExtractRequiredLiteral(std::string_view pattern)
+{
+    std::string best, segment;
+    int         depth = 0;
+
+    auto breakSegment = [&]() {
+        if (segment.size() > best.size()) {
+            best = segment;
+        }
+
+        segment.clear();
+    };
+
+    for (size_t i = 0; i < pattern.size(); i++) {
+        auto chr = pattern[i];
+
+        switch (chr) {
+        case '|':
+            // Alternation: no single literal is required.
+            return {};
+
+        case '\\':
+            if (i + 1 >= pattern.size()) {
+                return {};
+            }
+
+            i++;
+
+            // Character classes, anchors and escapes like \d, \b, \n are not literals.
+            if (std::isalnum(static_cast<unsigned char>(pattern[i]))) {
+                breakSegment();
+
+                // Code escapes \xHH, \uHHHH, \cX and backreferences are followed by their operand, not by literal.
+                if (auto operandSize = GetEscapeOperandSize(pattern, i); operandSize != 0) {
+                    i += operandSize;
+                }
+            } else if (depth == 0) {
+                segment += pattern[i];
+            }
+
+            break;
+
+        case '[':
+            breakSegment();
+
+            for (i++; i < pattern.size() && pattern[i] != ']'; i++) {
+                if (pattern[i] == '\\') {
+                    i++;
+                }
+            }
+
+            break;
+
+        case '(':
+            breakSegment();
+            depth++;
+
+            break;
+
+        case ')':
+            depth--;
+
+            break;
+
+        case '*':
+        case '?':
+        case '{':
+            // Preceding char may be absent.
+            if (!segment.empty()) {
+                segment.pop_back();
+            }
+
+            breakSegment();
+
+            if (chr == '{') {
+                i = std::min(pattern.find('}', i), pattern.size());
+            }
+
+            break;
+
+        case '+':
+        case '.':
+        case '^':
+        case '$':
+            breakSegment();
+
+            break;
+
+        default:
+            if (depth == 0) {
+                segment += chr;
+            }
+        }
+    }
+
+    breakSegment();
+
+    return best.size() >= cMinLiteralSize ? best : std::string();
+}
+
+} // namespace alertmatcher
+
+/***********************************************************************************************************************
+ * AlertMatcher
+ **********************************************************************************************************************/
+
+int AlertMatcher::Init(const std::vector<AlertRule>& rules)
+{
+    // Previous rules are kept if any pattern is invalid.
+    std::vector<CompiledRule> compiledRules;
+    std::vector<size_t>       alwaysEvaluated;
+
+    for (const auto& rule : rules) {
+        try {
+            compiledRules.push_back(CompiledRule {rule, std::regex(rule.mPattern, std::regex::optimize),
+                alertmatcher::ExtractRequiredLiteral(rule.mPattern)});
+        } catch (const std::regex_error&) {
+            return EINVAL;
+        }
+
+        if (compiledRules.back().mLiteral.empty()) {
+            alwaysEvaluated.push_back(compiledRules.size() - 1);
+        }
+    }
+
+    mRules.swap(compiledRules);
+    mAlwaysEvaluated.swap(alwaysEvaluated);
+
+    BuildAutomaton();
+
+    return 0;
+}
+
+void AlertMatcher::Match(std::string_view message, std::vector<size_t>& matchedRules) const
+{
+    matchedRules.clear();
+
+    // Automaton is not built till Init.
+    if (mTransitions.empty()) {
+        return;
+    }
+
+    uint32_t state = cRootState;
+
+    for (auto chr : message) {
+        state = mTransitions[state * mClassCount + mByteClasses[static_cast<uint8_t>(chr)]];
+
+        const auto& outputs = mStates[state].mOutputs;
+
+        matchedRules.insert(matchedRules.end(), outputs.begin(), outputs.end());
+    }
+
+    matchedRules.insert(matchedRules.end(), mAlwaysEvaluated.begin(), mAlwaysEvaluated.end());
+
+    std::sort(matchedRules.begin(), matchedRules.end());
+    matchedRules.erase(std::unique(matchedRules.begin(), matchedRules.end()), matchedRules.end());
+
+    // Confirm prefiltered candidates with full regex.
+    matchedRules.erase(std::remove_if(matchedRules.begin(), matchedRules.end(),
+                           [this, message](size_t index) {
+                               return !std::regex_search(message.begin(), message.end(), mRules[index].mRegex);
+                           }),
+        matchedRules.end());
+}
+
+/***********************************************************************************************************************
+ * AlertMatcher private
+ **********************************************************************************************************************/
+
+void AlertMatcher::BuildAutomaton()
+{
+    // Map bytes used by literals to dense classes to keep transition table small, class 0 is any other byte.
+    mByteClasses.fill(0);
+    mClassCount = 1;
+
+    for (const auto& rule : mRules) {
+        for (auto chr : rule.mLiteral) {
+            auto& byteClass = mByteClasses[static_cast<uint8_t>(chr)];
+
+            if (byteClass == 0) {
+                byteClass = static_cast<uint16_t>(mClassCount++);
+            }
+        }
+    }
+
+    mStates.assign(1, State {});
+    mTransitions.assign(mClassCount, cNoTransition);
+
+    // Build trie.
+    for (size_t i = 0; i < mRules.size(); i++) {
+        uint32_t state = cRootState;
+
+        for (auto chr : mRules[i].mLiteral) {
+            auto& next = mTransitions[state * mClassCount + mByteClasses[static_cast<uint8_t>(chr)]];
+
+            if (next == cNoTransition) {
+                next = static_cast<uint32_t>(mStates.size());
+
+                mStates.emplace_back();
+                mTransitions.resize(mTransitions.size() + mClassCount, cNoTransition);
+            }
+
+            state = mTransitions[state * mClassCount + mByteClasses[static_cast<uint8_t>(chr)]];
+        }
+
+        if (!mRules[i].mLiteral.empty()) {
+            mStates[state].mOutputs.push_back(i);
+        }
+    }
+
+    // Compute failure links in BFS order and turn trie into full DFA.
+    std::vector<uint32_t> fail(mStates.size(), cRootState);
+    std::queue<uint32_t>  queue;
+
+    for (size_t byteClass = 0; byteClass < mClassCount; byteClass++) {
+        auto& next = mTransitions[byteClass];
+
+        if (next == cNoTransition) {
+            next = cRootState;
+        } else {
+            queue.push(next);
+        }
+    }
+
+    while (!queue.empty()) {
+        auto state = queue.front();
+
+        queue.pop();
+
+        for (size_t byteClass = 0; byteClass < mClassCount; byteClass++) {
+            auto& next         = mTransitions[state * mClassCount + byteClass];
+            auto  failureState = mTransitions[fail[state] * mClassCount + byteClass];
+
+            if (next == cNoTransition) {
+                next = failureState;
+
+                continue;
+            }
+
+            fail[next] = failureState;
+
+            const auto& failureOutputs = mStates[failureState].mOutputs;
+
+            mStates[next].mOutputs.insert(mStates[next].mOutputs.end(), failureOutputs.begin(), failureOutputs.end());
+            queue.push(next);
+        }
+    }
+}
+
+/***********************************************************************************************************************
+ * AlertAggregator
+ **********************************************************************************************************************/
+
+AlertAggregator::AlertAggregator(std::chrono::steady_clock::duration window)
+    : mWindow(window)
+{
+}
+
+bool AlertAggregator::Add(const std::string& rule, std::string_view message, std::chrono::steady_clock::time_point now)
+{
+    auto key = rule;
+
+    key.append(1, '\0').append(message);
+
+    auto it = mAlerts.find(key);
+    if (it != mAlerts.end() && now - it->second.mFirstSeen < mWindow) {
+        it->second.mCount++;
+
+        return false;
+    }
+
+    if (it != mAlerts.end() && it->second.mCount > 1) {
+        // Expired window is not flushed yet: keep its summary.
+        it->second.mCount--;
+        mExpired.push_back(std::move(it->second));
+    }
+
+    mAlerts[key] = AggregatedAlert {rule, std::string(message), now, 1};
+
+    return true;
+}
+
+void AlertAggregator::Flush(std::chrono::steady_clock::time_point now, std::vector<AggregatedAlert>& duplicates)
+{
+    duplicates.clear();
+    duplicates.swap(mExpired);
+
+    for (auto it = mAlerts.begin(); it != mAlerts.end();) {
+        if (now - it->second.mFirstSeen < mWindow) {
+            it++;
+
+            continue;
+        }
+
+        if (it->second.mCount > 1) {
+            // First alert was already reported.
+            it->second.mCount--;
+            duplicates.push_back(std::move(it->second));
+        }
+
+        it = mAlerts.erase(it);
+    }
+}
+
+} // namespace aos::common::logprovider
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ALERTMATCHER_HPP_
+#define ALERTMATCHER_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace aos::common::logprovider {
+
+/**
+ * Alert rule.
+ */
+struct AlertRule {
+    std::string mName;
+    std::string mPattern;
+};
+
+/**
+ * Matches log messages against set of alert rules.
+ *
+ * Required literal is extracted from each rule pattern, all literals are compiled into one Aho-Corasick automaton.
+ * Message is scanned once by the automaton and regex is evaluated only for rules which literal is found in the
+ * message. Rules without extractable literal (e.g. with top level alternation) are always evaluated.
+ */
+class AlertMatcher {
+public:
+    /**
+     * Compiles rules.
+     *
+     * @param rules alert rules.
+     * @return int 0 on success or EINVAL if any rule pattern is invalid, previous rules are kept in this case.
+     */
+    int Init(const std::vector<AlertRule>& rules);
+
+    /**
+     * Matches message.
+     *
+     * @param message log message.
+     * @param[out] matchedRules indexes of matched rules.
+     */
+    void Match(std::string_view message, std::vector<size_t>& matchedRules) const;
+
+    /**
+     * Returns rule by index.
+     *
+     * @param index rule index.
+     * @return const AlertRule&.
+     */
+    const AlertRule& GetRule(size_t index) const { return mRules[index].mRule; }
+
+private:
+    static constexpr uint32_t cRootState = 0;
+
+    struct CompiledRule {
+        AlertRule   mRule;
+        std::regex  mRegex;
+        std::string mLiteral;
+    };
+
+    struct State {
+        std::vector<size_t> mOutputs;
+    };
+
+    void BuildAutomaton();
+
+    std::vector<CompiledRule> mRules;
+    std::vector<size_t>       mAlwaysEvaluated;
+    std::array<uint16_t, 256> mByteClasses {};
+    size_t                    mClassCount = 1;
+    std::vector<uint32_t>     mTransitions;
+    std::vector<State>        mStates;
+};
+
+/**
+ * Aggregated alert.
+ */
+struct AggregatedAlert {
+    std::string                           mRule;
+    std::string                           mMessage;
+    std::chrono::steady_clock::time_point mFirstSeen;
+    uint64_t                              mCount = 0;
+};
+
+/**
+ * Aggregates duplicate alerts within time window.
+ *
+ * First alert of each rule/message pair is reported immediately, duplicates within the window are counted and reported
+ * once as summary when the window expires.
+ */
+class AlertAggregator {
+public:
+    /**
+     * Creates alert aggregator.
+     *
+     * @param window aggregation window.
+     */
+    explicit AlertAggregator(std::chrono::steady_clock::duration window);
+
+    /**
+     * Adds alert.
+     *
+     * @param rule rule name.
+     * @param message alert message.
+     * @param now current time.
+     * @return bool true if alert should be reported immediately.
+     */
+    bool Add(const std::string& rule, std::string_view message, std::chrono::steady_clock::time_point now);
+
+    /**
+     * Removes expired windows.
+     *
+     * @param now current time.
+     * @param[out] duplicates summaries of expired windows with suppressed duplicates.
+     */
+    void Flush(std::chrono::steady_clock::time_point now, std::vector<AggregatedAlert>& duplicates);
+
+private:
+    std::chrono::steady_clock::duration              mWindow;
+    std::unordered_map<std::string, AggregatedAlert> mAlerts;
+    std::vector<AggregatedAlert>                     mExpired;
+};
+
+namespace alertmatcher {
+
+/**
+ * Extracts longest literal substring every regex match must contain.
+ *
+ * @param pattern ECMAScript regex pattern.
+ * @return std::string empty if no literal can be safely extracted.
+ */
+std::string ExtractRequiredLiteral(std::string_view pattern);
+
+} // namespace alertmatcher
+
+} // namespace aos::common::logprovider
+
+#endif
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+
+#include "journalalerts.hpp"
+
+namespace aos::common::logprovider {
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+JournalAlertWatcher::JournalAlertWatcher(JournalLogSourceConfig config, std::chrono::steady_clock::duration window)
+    : mConfig(std::move(config))
+    , mAggregator(window)
+{
+    mConfig.mFollow = true;
+}
+
+JournalAlertWatcher::~JournalAlertWatcher()
+{
+    Stop();
+}
+
+int JournalAlertWatcher::Start(const std::vector<AlertRule>& rules, JournalAlertFunc func)
+{
+    if (mThread.joinable()) {
+        return EBUSY;
+    }
+
+    if (auto err = mMatcher.Init(rules); err != 0) {
+        return err;
+    }
+
+    mFunc  = std::move(func);
+    mStop  = false;
+    mError = 0;
+
+    mThread = std::thread(&JournalAlertWatcher::Run, this);
+
+    return 0;
+}
+
+int JournalAlertWatcher::Stop()
+{
+    mStop = true;
+
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+
+    return mError;
+}
+
+/***********************************************************************************************************************
+ * Private
+ **********************************************************************************************************************/
+
+void JournalAlertWatcher::Run()
+{
+    JournalLogSource             journal(mConfig);
+    LogEntry                     entry;
+    std::vector<size_t>          matchedRules;
+    std::vector<AggregatedAlert> duplicates;
+    auto                         flushTime = std::chrono::steady_clock::now();
+
+    while (!mStop) {
+        auto eof = false;
+
+        if (mError = journal.Next(entry, eof); mError != 0) {
+            return;
+        }
+
+        if (!eof) {
+            HandleEntry(entry, matchedRules);
+        }
+
+        // Expired windows are also flushed while journal is written continuously.
+        if (auto now = std::chrono::steady_clock::now(); eof || now - flushTime >= cWaitTimeout) {
+            FlushDuplicates(duplicates);
+            flushTime = now;
+        }
+
+        if (!eof) {
+            continue;
+        }
+
+        if (mError = journal.Wait(cWaitTimeout); mError != 0) {
+            return;
+        }
+    }
+}
+
+void JournalAlertWatcher::HandleEntry(const LogEntry& entry, std::vector<size_t>& matchedRules)
+{
+    mMatcher.Match(entry.mMessage, matchedRules);
+
+    for (auto index : matchedRules) {
+        const auto& rule = mMatcher.GetRule(index);
+
+        if (!mAggregator.Add(rule.mName, entry.mMessage, std::chrono::steady_clock::now())) {
+            continue;
+        }
+
+        mFunc(JournalAlert {rule.mName, std::string(entry.mMessage), std::string(entry.mSourceID), entry.mTimeUs});
+    }
+}
+
+void JournalAlertWatcher::FlushDuplicates(std::vector<AggregatedAlert>& duplicates)
+{
+    mAggregator.Flush(std::chrono::steady_clock::now(), duplicates);
+
+    for (auto& duplicate : duplicates) {
+        mFunc(JournalAlert {std::move(duplicate.mRule), std::move(duplicate.mMessage), {}, 0, duplicate.mCount});
+    }
+}
+
+} // namespace aos::common::logprovider
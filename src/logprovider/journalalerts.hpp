@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef JOURNALALERTS_HPP_
+#define JOURNALALERTS_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "alertmatcher.hpp"
+#include "journallogsource.hpp"
+
+namespace aos::common::logprovider {
+
+/**
+ * Journal alert.
+ */
+struct JournalAlert {
+    std::string mRule;
+    std::string mMessage;
+    std::string mSourceID;
+    int64_t     mTimeUs = 0;
+    // Number of suppressed duplicates: 0 for first alert, summary alert is sent when aggregation window expires.
+    uint64_t mDuplicates = 0;
+};
+
+/**
+ * Journal alert callback, called from watcher thread.
+ */
+using JournalAlertFunc = std::function<void(const JournalAlert& alert)>;
+
+/**
+ * Follows journal and reports entries matching alert rules.
+ *
+ * Field matches from config are pushed down to journal, so entries of other units are not read at all. Messages are
+ * matched with AlertMatcher and duplicates are aggregated with AlertAggregator.
+ */
+class JournalAlertWatcher {
+public:
+    /**
+     * Creates journal alert watcher.
+     *
+     * @param config journal config, follow mode is always set.
+     * @param window duplicate aggregation window.
+     */
+    JournalAlertWatcher(JournalLogSourceConfig config, std::chrono::steady_clock::duration window);
+
+    /**
+     * Stops watcher.
+     */
+    ~JournalAlertWatcher();
+
+    JournalAlertWatcher(const JournalAlertWatcher&)            = delete;
+    JournalAlertWatcher& operator=(const JournalAlertWatcher&) = delete;
+
+    /**
+     * Compiles rules and starts following journal.
+     *
+     * @param rules alert rules.
+     * @param func alert callback.
+     * @return int.
+     */
+    int Start(const std::vector<AlertRule>& rules, JournalAlertFunc func);
+
+    /**
+     * Stops following journal.
+     *
+     * @return int journal error which stopped watcher, 0 otherwise.
+     */
+    int Stop();
+
+private:
+    static constexpr auto cWaitTimeout = std::chrono::milliseconds(500);
+
+    void Run();
+    void HandleEntry(const LogEntry& entry, std::vector<size_t>& matchedRules);
+    void FlushDuplicates(std::vector<AggregatedAlert>& duplicates);
+
+    JournalLogSourceConfig mConfig;
+    AlertMatcher           mMatcher;
+    AlertAggregator        mAggregator;
+    JournalAlertFunc       mFunc;
+    std::atomic_bool       mStop {false};
+    int                    mError = 0;
+    std::thread            mThread;
+};
+
+} // namespace aos::common::logprovider
+
+#endif
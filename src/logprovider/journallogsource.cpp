@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <cstring>
+
+#include "journallogsource.hpp"
+
+#if AOS_WITH_JOURNAL
+#include <systemd/sd-journal.h>
+#endif
+
+namespace aos::common::logprovider {
+
+#if AOS_WITH_JOURNAL
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+JournalLogSource::JournalLogSource(JournalLogSourceConfig config)
+    : mConfig(std::move(config))
+{
+}
+
+JournalLogSource::~JournalLogSource()
+{
+    if (mJournal != nullptr) {
+        sd_journal_close(mJournal);
+    }
+}
+
+int JournalLogSource::Next(LogEntry& entry, bool& eof)
+{
+    eof = false;
+
+    if (mJournal == nullptr && !mDone) {
+        if (auto err = Open(); err != 0) {
+            return err;
+        }
+    }
+
+    while (!mDone) {
+        auto ret = sd_journal_next(mJournal);
+        if (ret < 0) {
+            return -ret;
+        }
+
+        if (ret == 0) {
+            mDone = !mConfig.mFollow;
+            break;
+        }
+
+        uint64_t timeUs = 0;
+
+        if (ret = sd_journal_get_realtime_usec(mJournal, &timeUs); ret < 0) {
+            return -ret;
+        }
+
+        if (static_cast<int64_t>(timeUs) < mConfig.mFromUs) {
+            continue;
+        }
+
+        if (static_cast<int64_t>(timeUs) > mConfig.mTillUs) {
+            mDone = true;
+            break;
+        }
+
+        std::string_view value;
+
+        // Next data request invalidates the pointer: source ID is copied, message is requested last.
+        if (!mConfig.mSourceIDField.empty() && GetField(mConfig.mSourceIDField.c_str(), value)) {
+            mSourceID.assign(value);
+        } else {
+            mSourceID.clear();
+        }
+
+        if (!GetField("MESSAGE", value)) {
+            value = {};
+        }
+
+        entry.mTimeUs   = static_cast<int64_t>(timeUs);
+        entry.mMessage  = value;
+        entry.mSourceID = mSourceID;
+
+        return 0;
+    }
+
+    eof = true;
+
+    return 0;
+}
+
+int JournalLogSource::Wait(std::chrono::microseconds timeout)
+{
+    if (mJournal == nullptr) {
+        if (mDone) {
+            return 0;
+        }
+
+        if (auto err = Open(); err != 0) {
+            return err;
+        }
+    }
+
+    if (auto ret = sd_journal_wait(mJournal, static_cast<uint64_t>(timeout.count())); ret < 0) {
+        return -ret;
+    }
+
+    return 0;
+}
+
+/***********************************************************************************************************************
+ * Private
+ **********************************************************************************************************************/
+
+int JournalLogSource::Open()
+{
+    auto ret = 0;
+
+    if (!mConfig.mFiles.empty()) {
+        std::vector<const char*> paths;
+
+        for (const auto& file : mConfig.mFiles) {
+            paths.push_back(file.c_str());
+        }
+
+        paths.push_back(nullptr);
+
+        ret = sd_journal_open_files(&mJournal, paths.data(), 0);
+    } else if (!mConfig.mDirectory.empty()) {
+        ret = sd_journal_open_directory(&mJournal, mConfig.mDirectory.c_str(), 0);
+    } else {
+        ret = sd_journal_open(&mJournal, SD_JOURNAL_LOCAL_ONLY);
+    }
+
+    if (ret < 0) {
+        mJournal = nullptr;
+
+        return -ret;
+    }
+
+    ret = sd_journal_set_data_threshold(mJournal, mConfig.mMaxFieldSize);
+
+    for (size_t i = 0; ret >= 0 && i < mConfig.mMatches.size(); i++) {
+        ret = sd_journal_add_match(mJournal, mConfig.mMatches[i].data(), mConfig.mMatches[i].size());
+    }
+
+    if (ret >= 0 && mConfig.mFromUs > 0) {
+        ret = sd_journal_seek_realtime_usec(mJournal, static_cast<uint64_t>(mConfig.mFromUs));
+    } else if (ret >= 0 && mConfig.mFollow) {
+        // Positioned at last entry: next call returns entries appended after open.
+        if (ret = sd_journal_seek_tail(mJournal); ret >= 0) {
+            ret = sd_journal_previous(mJournal);
+        }
+    }
+
+    if (ret < 0) {
+        sd_journal_close(mJournal);
+        mJournal = nullptr;
+
+        return -ret;
+    }
+
+    return 0;
+}
+
+bool JournalLogSource::GetField(const char* name, std::string_view& value)
+{
+    const void* data    = nullptr;
+    size_t      size    = 0;
+    auto        nameLen = strlen(name);
+
+    if (sd_journal_get_data(mJournal, name, &data, &size) < 0 || size <= nameLen) {
+        return false;
+    }
+
+    // Data is "<name>=<value>".
+    value = std::string_view(static_cast<const char*>(data) + nameLen + 1, size - nameLen - 1);
+
+    return true;
+}
+
+#else
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+JournalLogSource::JournalLogSource(JournalLogSourceConfig config)
+    : mConfig(std::move(config))
+{
+}
+
+JournalLogSource::~JournalLogSource() = default;
+
+int JournalLogSource::Next(LogEntry& entry, bool& eof)
+{
+    (void)entry;
+
+    eof = false;
+
+    return ENOTSUP;
+}
+
+int JournalLogSource::Wait(std::chrono::microseconds timeout)
+{
+    (void)timeout;
+
+    return ENOTSUP;
+}
+
+#endif
+
+} // namespace aos::common::logprovider
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef JOURNALLOGSOURCE_HPP_
+#define JOURNALLOGSOURCE_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "logsource.hpp"
+
+/**
+ * Journal support: enabled if sd-journal headers are available, may be forced with -DAOS_WITH_JOURNAL=0 or 1. Without
+ * journal support JournalLogSource is built as a stub.
+ */
+#ifndef AOS_WITH_JOURNAL
+#if __has_include(<systemd/sd-journal.h>)
+#define AOS_WITH_JOURNAL 1
+#else
+#define AOS_WITH_JOURNAL 0
+#endif
+#endif
+
+struct sd_journal;
+
+namespace aos::common::logprovider {
+
+/**
+ * Journal log source config.
+ */
+struct JournalLogSourceConfig {
+    // Journal directory, system journal if empty and no files are set.
+    std::string mDirectory;
+    // Journal files, e.g. one file per partition for parallel scanning.
+    std::vector<std::string> mFiles;
+    // "FIELD=value" matches: different fields are ANDed, same field values are ORed.
+    std::vector<std::string> mMatches;
+    // Field reported as entry source ID, e.g. "_SYSTEMD_UNIT"; none if empty.
+    std::string mSourceIDField;
+    int64_t     mFromUs       = 0;
+    int64_t     mTillUs       = INT64_MAX;
+    size_t      mMaxFieldSize = 64 * 1024;
+    // Follow mode: reaching journal end is reported as eof, Next returns new entries after Wait. Reading starts at
+    // journal tail if mFromUs is not set.
+    bool mFollow = false;
+};
+
+/**
+ * Reads journal entries.
+ *
+ * Only MESSAGE and source ID fields are fetched per entry; message is returned as view over journal memory without
+ * copying. Source ID is copied into reused buffer since journal data pointer is only valid till next data request.
+ * Steady state reading does not allocate. Next and Wait return ENOTSUP if built without journal support.
+ */
+class JournalLogSource : public LogSource {
+public:
+    /**
+     * Creates journal log source.
+     *
+     * @param config config.
+     */
+    explicit JournalLogSource(JournalLogSourceConfig config);
+
+    /**
+     * Closes journal.
+     */
+    ~JournalLogSource() override;
+
+    JournalLogSource(const JournalLogSource&)            = delete;
+    JournalLogSource& operator=(const JournalLogSource&) = delete;
+
+    int Next(LogEntry& entry, bool& eof) override;
+
+    /**
+     * Waits for journal changes in follow mode.
+     *
+     * @param timeout wait timeout.
+     * @return int 0 on change or timeout.
+     */
+    int Wait(std::chrono::microseconds timeout);
+
+private:
+    int  Open();
+    bool GetField(const char* name, std::string_view& value);
+
+    JournalLogSourceConfig mConfig;
+    sd_journal*            mJournal = nullptr;
+    bool                   mDone    = false;
+    std::string            mSourceID;
+};
+
+} // namespace aos::common::logprovider
+
+#endif
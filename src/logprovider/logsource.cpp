@@ -0,0 +1,339 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "logsource.hpp"
+
+namespace aos::common::logprovider {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+bool ParseDigits(std::string_view str, size_t pos, size_t count, int& value)
+{
+    if (pos + count > str.size()) {
+        return false;
+    }
+
+    value = 0;
+
+    for (size_t i = pos; i < pos + count; i++) {
+        if (str[i] < '0' || str[i] > '9') {
+            return false;
+        }
+
+        value = value * 10 + (str[i] - '0');
+    }
+
+    return true;
+}
+
+// Days since 1970-01-01 for proleptic Gregorian date.
+int64_t DaysFromCivil(int64_t year, int month, int day)
+{
+    year -= month <= 2;
+
+    auto era = (year >= 0 ? year : year - 399) / 400;
+    auto yoe = year - era * 400;
+    auto doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    auto doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+    return era * 146097 + doe - 719468;
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+bool ParseRFC3339(std::string_view str, int64_t& timeUs)
+{
+    int year = 0, month = 0, day = 0, hour = 0, min = 0, sec = 0;
+
+    // Shortest form: "YYYY-MM-DDTHH:MM:SSZ".
+    if (str.size() < 20) {
+        return false;
+    }
+
+    if (!ParseDigits(str, 0, 4, year) || str[4] != '-' || !ParseDigits(str, 5, 2, month) || str[7] != '-'
+        || !ParseDigits(str, 8, 2, day) || (str[10] != 'T' && str[10] != 't' && str[10] != ' ')
+        || !ParseDigits(str, 11, 2, hour) || str[13] != ':' || !ParseDigits(str, 14, 2, min) || str[16] != ':'
+        || !ParseDigits(str, 17, 2, sec) || month < 1 || month > 12 || day < 1 || day > 31) {
+        return false;
+    }
+
+    size_t  pos      = 19;
+    int64_t fraction = 0;
+
+    if (pos < str.size() && str[pos] == '.') {
+        int64_t scale = 1000000;
+
+        for (pos++; pos < str.size() && str[pos] >= '0' && str[pos] <= '9'; pos++) {
+            if (scale > 1) {
+                scale /= 10;
+                fraction += (str[pos] - '0') * scale;
+            }
+        }
+    }
+
+    int offset = 0;
+
+    if (pos < str.size() && (str[pos] == '+' || str[pos] == '-')) {
+        int hours = 0, minutes = 0;
+
+        if (!ParseDigits(str, pos + 1, 2, hours) || pos + 3 >= str.size() || str[pos + 3] != ':'
+            || !ParseDigits(str, pos + 4, 2, minutes)) {
+            return false;
+        }
+
+        offset = (hours * 60 + minutes) * 60 * (str[pos] == '-' ? -1 : 1);
+        pos += 6;
+    } else if (pos < str.size() && (str[pos] == 'Z' || str[pos] == 'z')) {
+        pos++;
+    } else {
+        return false;
+    }
+
+    if (pos != str.size()) {
+        return false;
+    }
+
+    auto seconds = DaysFromCivil(year, month, day) * 86400 + hour * 3600 + min * 60 + sec - offset;
+
+    timeUs = seconds * 1000000 + fraction;
+
+    return true;
+}
+
+FileLogSource::FileLogSource(std::string path, std::string sourceID, int64_t fromUs, int64_t tillUs)
+    : mPath(std::move(path))
+    , mSourceID(std::move(sourceID))
+    , mFromUs(fromUs)
+    , mTillUs(tillUs)
+{
+}
+
+FileLogSource::~FileLogSource()
+{
+    if (mFD >= 0) {
+        close(mFD);
+    }
+}
+
+int FileLogSource::Next(LogEntry& entry, bool& eof)
+{
+    eof = false;
+
+    if (mClearMessage) {
+        mMessage.clear();
+        mClearMessage = false;
+    }
+
+    if (mFD < 0 && !mDone) {
+        mFD = open(mPath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (mFD < 0) {
+            return errno;
+        }
+
+        mBuffer.resize(cBufferSize);
+    }
+
+    while (!mDone) {
+        std::string_view line;
+
+        if (auto err = ReadLine(line, eof); err != 0) {
+            return err;
+        }
+
+        if (eof) {
+            mDone = true;
+            break;
+        }
+
+        // <time> <stream> <tag> <message>
+        auto timeEnd   = line.find(' ');
+        auto streamEnd = timeEnd == std::string_view::npos ? timeEnd : line.find(' ', timeEnd + 1);
+
+        if (streamEnd == std::string_view::npos || streamEnd + 2 > line.size()) {
+            continue;
+        }
+
+        int64_t timeUs = 0;
+
+        if (!ParseRFC3339(line.substr(0, timeEnd), timeUs)) {
+            continue;
+        }
+
+        if (timeUs < mFromUs) {
+            mMessage.clear();
+            continue;
+        }
+
+        if (timeUs > mTillUs) {
+            mDone = true;
+            break;
+        }
+
+        auto isPartial = line[streamEnd + 1] == 'P';
+        auto message   = line.substr(std::min(streamEnd + 3, line.size()));
+
+        if (isPartial) {
+            mMessage += message;
+            continue;
+        }
+
+        if (!mMessage.empty()) {
+            mMessage += message;
+            message       = mMessage;
+            mClearMessage = true;
+        }
+
+        entry.mTimeUs   = timeUs;
+        entry.mMessage  = message;
+        entry.mSourceID = mSourceID;
+
+        return 0;
+    }
+
+    eof = true;
+
+    return 0;
+}
+
+void MergedLogSource::AddSource(std::unique_ptr<LogSource> source)
+{
+    mSources.push_back(std::move(source));
+}
+
+int MergedLogSource::Next(LogEntry& entry, bool& eof)
+{
+    eof = false;
+
+    if (!mStarted) {
+        mStarted = true;
+
+        mHeap.reserve(mSources.size());
+
+        for (size_t i = 0; i < mSources.size(); i++) {
+            if (auto err = Pull(i); err != 0) {
+                return err;
+            }
+        }
+    } else if (mPending != SIZE_MAX) {
+        auto index = mPending;
+
+        mPending = SIZE_MAX;
+
+        if (auto err = Pull(index); err != 0) {
+            return err;
+        }
+    }
+
+    if (mHeap.empty()) {
+        eof = true;
+
+        return 0;
+    }
+
+    std::pop_heap(mHeap.begin(), mHeap.end(), IsLater);
+
+    entry    = mHeap.back().mEntry;
+    mPending = mHeap.back().mIndex;
+
+    mHeap.pop_back();
+
+    return 0;
+}
+
+/***********************************************************************************************************************
+ * Private
+ **********************************************************************************************************************/
+
+int FileLogSource::ReadLine(std::string_view& line, bool& eof)
+{
+    mLine.clear();
+
+    for (;;) {
+        auto begin = mBuffer.data() + mBegin;
+        auto end   = static_cast<const char*>(memchr(begin, '\n', mEnd - mBegin));
+
+        if (end != nullptr) {
+            mBegin += static_cast<size_t>(end - begin) + 1;
+
+            if (mLine.empty()) {
+                line = std::string_view(begin, static_cast<size_t>(end - begin));
+            } else {
+                mLine.append(begin, static_cast<size_t>(end - begin));
+                line = mLine;
+            }
+
+            return 0;
+        }
+
+        mLine.append(begin, mEnd - mBegin);
+
+        mBegin = 0;
+        mEnd   = 0;
+
+        auto n = read(mFD, mBuffer.data(), mBuffer.size());
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (n < 0) {
+            return errno;
+        }
+
+        if (n == 0) {
+            // Last line without newline.
+            eof  = mLine.empty();
+            line = mLine;
+
+            return 0;
+        }
+
+        mEnd = static_cast<size_t>(n);
+    }
+}
+
+bool MergedLogSource::IsLater(const Head& lhs, const Head& rhs)
+{
+    if (lhs.mEntry.mTimeUs != rhs.mEntry.mTimeUs) {
+        return lhs.mEntry.mTimeUs > rhs.mEntry.mTimeUs;
+    }
+
+    return lhs.mIndex > rhs.mIndex;
+}
+
+int MergedLogSource::Pull(size_t index)
+{
+    LogEntry entry;
+    bool     eof = false;
+
+    if (auto err = mSources[index]->Next(entry, eof); err != 0) {
+        return err;
+    }
+
+    if (!eof) {
+        mHeap.push_back({entry, index});
+        std::push_heap(mHeap.begin(), mHeap.end(), IsLater);
+    }
+
+    return 0;
+}
+
+} // namespace aos::common::logprovider
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef LOGSOURCE_HPP_
+#define LOGSOURCE_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aos::common::logprovider {
+
+/**
+ * Log entry. Views are valid till next call of the source.
+ */
+struct LogEntry {
+    int64_t          mTimeUs = 0;
+    std::string_view mMessage;
+    std::string_view mSourceID;
+};
+
+/**
+ * Time ordered log source, e.g. journal or container log file.
+ */
+class LogSource {
+public:
+    /**
+     * Destroys log source.
+     */
+    virtual ~LogSource() = default;
+
+    /**
+     * Reads next entry.
+     *
+     * @param[out] entry log entry.
+     * @param[out] eof true if there are no more entries.
+     * @return int 0 on success or errno value on failure.
+     */
+    virtual int Next(LogEntry& entry, bool& eof) = 0;
+};
+
+/**
+ * Reads container log file in CRI format: "<RFC3339 time> <stream> <P|F> <message>".
+ *
+ * File is read with fixed size buffer; entries reference the buffer and are not copied unless a line crosses buffer
+ * boundary or is split into partial lines. Entries outside of the time range are skipped.
+ */
+class FileLogSource : public LogSource {
+public:
+    /**
+     * Creates file log source.
+     *
+     * @param path log file path.
+     * @param sourceID source ID reported in entries.
+     * @param fromUs range begin, microseconds since epoch.
+     * @param tillUs range end, microseconds since epoch.
+     */
+    FileLogSource(std::string path, std::string sourceID, int64_t fromUs, int64_t tillUs);
+
+    /**
+     * Closes log file.
+     */
+    ~FileLogSource() override;
+
+    FileLogSource(const FileLogSource&)            = delete;
+    FileLogSource& operator=(const FileLogSource&) = delete;
+
+    int Next(LogEntry& entry, bool& eof) override;
+
+private:
+    static constexpr size_t cBufferSize = 64 * 1024;
+
+    int ReadLine(std::string_view& line, bool& eof);
+
+    std::string       mPath;
+    std::string       mSourceID;
+    int64_t           mFromUs;
+    int64_t           mTillUs;
+    int               mFD   = -1;
+    bool              mDone = false;
+    std::vector<char> mBuffer;
+    size_t            mBegin = 0;
+    size_t            mEnd   = 0;
+    // Line crossing buffer boundary.
+    std::string mLine;
+    // Joined partial lines.
+    std::string mMessage;
+    bool        mClearMessage = false;
+};
+
+/**
+ * Merges time ordered log sources into one time ordered stream.
+ *
+ * Sources are read lazily: only one head entry per source is kept in a binary heap, so memory usage does not depend
+ * on source sizes. Entries with equal time are returned in order of sources.
+ */
+class MergedLogSource : public LogSource {
+public:
+    /**
+     * Adds source. Should be called before first Next.
+     *
+     * @param source log source.
+     */
+    void AddSource(std::unique_ptr<LogSource> source);
+
+    int Next(LogEntry& entry, bool& eof) override;
+
+private:
+    struct Head {
+        LogEntry mEntry;
+        size_t   mIndex;
+    };
+
+    static bool IsLater(const Head& lhs, const Head& rhs);
+
+    int Pull(size_t index);
+
+    std::vector<std::unique_ptr<LogSource>> mSources;
+    std::vector<Head>                       mHeap;
+    bool                                    mStarted = false;
+    // Source of the last returned entry: advanced on next call to keep returned entry valid.
+    size_t mPending = SIZE_MAX;
+};
+
+/**
+ * Parses RFC3339 time, e.g. "2024-01-02T03:04:05.123456789Z" or "2024-01-02T05:04:05+02:00".
+ *
+ * @param str time string.
+ * @param[out] timeUs microseconds since epoch.
+ * @return bool.
+ */
+bool ParseRFC3339(std::string_view str, int64_t& timeUs);
+
+} // namespace aos::common::logprovider
+
+#endif
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+
+#include "prefetchlogsource.hpp"
+
+namespace aos::common::logprovider {
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+PrefetchLogSource::PrefetchLogSource(
+    std::unique_ptr<LogSource> source, LogFilterFunc filter, size_t batchSize, size_t maxBatches)
+    : mSource(std::move(source))
+    , mFilter(std::move(filter))
+    , mBatchSize(std::max<size_t>(batchSize, 1))
+    , mReady(std::max<size_t>(maxBatches, 1))
+    , mFree(mReady.Capacity())
+{
+    for (size_t i = 0; i < mFree.Capacity(); i++) {
+        auto batch = std::make_unique<Batch>();
+
+        batch->mEntries.reserve(mBatchSize);
+        mFree.TryPush(std::move(batch));
+    }
+
+    mThread = std::thread(&PrefetchLogSource::Run, this);
+}
+
+PrefetchLogSource::~PrefetchLogSource()
+{
+    mFree.Close();
+    mReady.Close();
+    mThread.join();
+}
+
+int PrefetchLogSource::Next(LogEntry& entry, bool& eof)
+{
+    eof = false;
+
+    if (!mCurrent || mPosition == mCurrent->mEntries.size()) {
+        // Consumed batch is returned for reuse: free queue holds all batches, so it never fails.
+        if (mCurrent) {
+            mFree.TryPush(std::move(mCurrent));
+        }
+
+        if (!mReady.Pop(mCurrent)) {
+            eof = mError == 0;
+
+            return mError;
+        }
+
+        mPosition = 0;
+    }
+
+    const auto& stored = mCurrent->mEntries[mPosition++];
+
+    entry.mTimeUs   = stored.mTimeUs;
+    entry.mMessage  = std::string_view(mCurrent->mData).substr(stored.mMessageOffset, stored.mMessageSize);
+    entry.mSourceID = std::string_view(mCurrent->mData).substr(stored.mSourceIDOffset, stored.mSourceIDSize);
+
+    return 0;
+}
+
+std::unique_ptr<LogSource> CreatePartitionedLogSource(std::vector<std::unique_ptr<LogSource>> partitions,
+    const LogFilterFunc& filter, size_t batchSize, size_t maxBatches)
+{
+    auto merged = std::make_unique<MergedLogSource>();
+
+    for (auto& partition : partitions) {
+        merged->AddSource(std::make_unique<PrefetchLogSource>(std::move(partition), filter, batchSize, maxBatches));
+    }
+
+    return merged;
+}
+
+/***********************************************************************************************************************
+ * Private
+ **********************************************************************************************************************/
+
+void PrefetchLogSource::Run()
+{
+    std::unique_ptr<Batch> batch;
+    size_t                 sourceIDOffset = 0;
+    size_t                 sourceIDSize   = 0;
+    auto                   err            = 0;
+
+    for (;;) {
+        if (!batch) {
+            if (!mFree.Pop(batch)) {
+                return;
+            }
+
+            batch->Clear();
+        }
+
+        LogEntry entry;
+        bool     eof = false;
+
+        if (err = mSource->Next(entry, eof); err != 0 || eof) {
+            break;
+        }
+
+        if (mFilter && !mFilter(entry)) {
+            continue;
+        }
+
+        // Source ID is usually the same for all entries: stored once per batch.
+        if (batch->mEntries.empty()
+            || entry.mSourceID != std::string_view(batch->mData).substr(sourceIDOffset, sourceIDSize)) {
+            sourceIDOffset = batch->mData.size();
+            sourceIDSize   = entry.mSourceID.size();
+            batch->mData.append(entry.mSourceID);
+        }
+
+        batch->mEntries.push_back(
+            {entry.mTimeUs, batch->mData.size(), entry.mMessage.size(), sourceIDOffset, sourceIDSize});
+        batch->mData.append(entry.mMessage);
+
+        if (batch->mEntries.size() == mBatchSize && !mReady.Push(std::move(batch))) {
+            return;
+        }
+    }
+
+    if (batch && !batch->mEntries.empty() && !mReady.Push(std::move(batch))) {
+        return;
+    }
+
+    // Close publishes mError: reader checks it only after Pop observes closed queue.
+    mError = err;
+    mReady.Close();
+}
+
+} // namespace aos::common::logprovider
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PREFETCHLOGSOURCE_HPP_
+#define PREFETCHLOGSOURCE_HPP_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "logsource.hpp"
+#include "utils/spscqueue.hpp"
+
+namespace aos::common::logprovider {
+
+/**
+ * Log entry filter: returns true to keep entry.
+ */
+using LogFilterFunc = std::function<bool(const LogEntry& entry)>;
+
+/**
+ * Scans wrapped log source in own thread.
+ *
+ * Partitions of a wide request (journal files or time ranges, each with its own handle) are wrapped with prefetch
+ * sources and combined with MergedLogSource, see CreatePartitionedLogSource. Filtered entries are copied into batches;
+ * batches are preallocated and cycle between scanning thread and reader through lock-free queues, so memory usage does
+ * not depend on partition size.
+ */
+class PrefetchLogSource : public LogSource {
+public:
+    /**
+     * Creates prefetch log source and starts scanning.
+     *
+     * @param source wrapped log source.
+     * @param filter entry filter applied in scanning thread, may be empty.
+     * @param batchSize max number of entries in batch.
+     * @param maxBatches max number of batches in flight.
+     */
+    PrefetchLogSource(
+        std::unique_ptr<LogSource> source, LogFilterFunc filter = {}, size_t batchSize = 1024, size_t maxBatches = 4);
+
+    /**
+     * Stops scanning.
+     */
+    ~PrefetchLogSource() override;
+
+    PrefetchLogSource(const PrefetchLogSource&)            = delete;
+    PrefetchLogSource& operator=(const PrefetchLogSource&) = delete;
+
+    int Next(LogEntry& entry, bool& eof) override;
+
+private:
+    struct StoredEntry {
+        int64_t mTimeUs;
+        size_t  mMessageOffset;
+        size_t  mMessageSize;
+        size_t  mSourceIDOffset;
+        size_t  mSourceIDSize;
+    };
+
+    struct Batch {
+        std::vector<StoredEntry> mEntries;
+        std::string              mData;
+
+        void Clear()
+        {
+            mEntries.clear();
+            mData.clear();
+        }
+    };
+
+    void Run();
+
+    std::unique_ptr<LogSource> mSource;
+    LogFilterFunc              mFilter;
+    size_t                     mBatchSize;
+
+    utils::SPSCQueue<std::unique_ptr<Batch>> mReady;
+    utils::SPSCQueue<std::unique_ptr<Batch>> mFree;
+    // Set before mReady is closed.
+    int mError = 0;
+
+    std::unique_ptr<Batch> mCurrent;
+    size_t                 mPosition = 0;
+    std::thread            mThread;
+};
+
+/**
+ * Creates source scanning partitions in parallel.
+ *
+ * Each partition is wrapped with a prefetch source and the results are combined with MergedLogSource: reading, parsing
+ * and filtering of partitions run concurrently while the merge keeps the output time ordered. Partitions should not
+ * overlap in time for the output to match sequential scanning; entries with equal time are returned in partition
+ * order. Dropping the returned source stops all scanning threads.
+ *
+ * @param partitions time ordered partition sources.
+ * @param filter entry filter, may be empty. Called concurrently from scanning threads.
+ * @param batchSize max number of entries in batch.
+ * @param maxBatches max number of batches in flight per partition.
+ * @return std::unique_ptr<LogSource>.
+ */
+std::unique_ptr<LogSource> CreatePartitionedLogSource(std::vector<std::unique_ptr<LogSource>> partitions,
+    const LogFilterFunc& filter = {}, size_t batchSize = 1024, size_t maxBatches = 4);
+
+} // namespace aos::common::logprovider
+
+#endif
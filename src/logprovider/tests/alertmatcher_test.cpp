@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "logprovider/alertmatcher.hpp"
+
+using namespace testing;
+
+namespace aos::common::logprovider {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+std::vector<AlertRule> CreateBenchmarkRules(size_t count)
+{
+    std::vector<AlertRule> rules;
+
+    for (size_t i = 0; i < count; i++) {
+        auto name = "rule" + std::to_string(i);
+
+        rules.push_back({name, "service" + std::to_string(i) + " .* failed with code \\d+"});
+    }
+
+    return rules;
+}
+
+// Mostly non matching messages as seen in a regular journal, every 100th message matches a rule.
+std::vector<std::string> CreateBenchmarkMessages(size_t count, size_t ruleCount)
+{
+    std::vector<std::string> messages;
+
+    for (size_t i = 0; i < count; i++) {
+        if (i % 100 == 0) {
+            messages.push_back(
+                "service" + std::to_string(i % ruleCount) + " worker " + std::to_string(i) + " failed with code 1");
+        } else {
+            messages.push_back("Started session " + std::to_string(i) + " of user root, pid " + std::to_string(i * 7)
+                + ", status: running normally");
+        }
+    }
+
+    return messages;
+}
+
+template <typename Func>
+double MeasureEntriesPerSec(const std::vector<std::string>& messages, size_t rounds, Func func)
+{
+    size_t matches = 0;
+    auto   start   = std::chrono::steady_clock::now();
+
+    for (size_t round = 0; round < rounds; round++) {
+        for (const auto& message : messages) {
+            matches += func(message);
+        }
+    }
+
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_EQ(matches, rounds * messages.size() / 100);
+
+    return static_cast<double>(rounds * messages.size()) / seconds;
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST(AlertMatcherTest, ExtractRequiredLiteral)
+{
+    EXPECT_EQ(alertmatcher::ExtractRequiredLiteral("disk .* failed"), " failed");
+    EXPECT_EQ(alertmatcher::ExtractRequiredLiteral("out of memory\\.x?"), "out of memory.");
+    EXPECT_EQ(alertmatcher::ExtractRequiredLiteral("error\\d+ in unit"), " in unit");
+    EXPECT_EQ(alertmatcher::ExtractRequiredLiteral("oom|panic"), "");
+    EXPECT_EQ(alertmatcher::ExtractRequiredLiteral("(kernel) panic"), " panic");
+    EXPECT_EQ(alertmatcher::ExtractRequiredLiteral("[a-z]+ab"), "");
+}
+
+TEST(AlertMatcherTest, ExtractRequiredLiteralSkipsEscapeOperands)
+{
+    EXPECT_EQ(alertmatcher::ExtractRequiredLiteral("\\x41BCD failed"), "BCD failed");
+    EXPECT_EQ(alertmatcher::ExtractRequiredLiteral("\\u0041BCD failed"), "BCD failed");
+    EXPECT_EQ(alertmatcher::ExtractRequiredLiteral("\\cJnext line"), "next line");
+    EXPECT_EQ(alertmatcher::ExtractRequiredLiteral("(a)\\123 failed"), " failed");
+    EXPECT_EQ(alertmatcher::ExtractRequiredLiteral("abc\\x4"), "abc");
+}
+
+TEST(AlertMatcherTest, Match)
+{
+    AlertMatcher matcher;
+
+    ASSERT_EQ(matcher.Init({{"disk", "disk .* failed"}, {"oom", "Out of memory: Killed process \\d+"},
+                  {"hex", "\\x41BCD failed"}, {"any", "panic|BUG:"}}),
+        0);
+
+    std::vector<size_t> matched;
+
+    matcher.Match("disk sda1 failed", matched);
+    EXPECT_EQ(matched, std::vector<size_t>({0}));
+
+    matcher.Match("Out of memory: Killed process 1234 (app)", matched);
+    EXPECT_EQ(matched, std::vector<size_t>({1}));
+
+    matcher.Match("ABCD failed", matched);
+    EXPECT_EQ(matched, std::vector<size_t>({2}));
+
+    matcher.Match("kernel panic", matched);
+    EXPECT_EQ(matched, std::vector<size_t>({3}));
+
+    matcher.Match("disk failed", matched);
+    EXPECT_TRUE(matched.empty());
+
+    matcher.Match("", matched);
+    EXPECT_TRUE(matched.empty());
+}
+
+TEST(AlertMatcherTest, MatchWithoutInit)
+{
+    AlertMatcher        matcher;
+    std::vector<size_t> matched {1, 2};
+
+    matcher.Match("some message", matched);
+    EXPECT_TRUE(matched.empty());
+}
+
+TEST(AlertMatcherTest, FailedInitKeepsRules)
+{
+    AlertMatcher matcher;
+
+    ASSERT_EQ(matcher.Init({{"disk", "disk .* failed"}, {"any", "panic|BUG:"}}), 0);
+    EXPECT_EQ(matcher.Init({{"bad", "unbalanced (paren"}}), EINVAL);
+
+    std::vector<size_t> matched;
+
+    matcher.Match("disk sda1 failed", matched);
+    EXPECT_EQ(matched, std::vector<size_t>({0}));
+
+    matcher.Match("BUG: soft lockup", matched);
+    EXPECT_EQ(matched, std::vector<size_t>({1}));
+    EXPECT_EQ(matcher.GetRule(1).mName, "any");
+}
+
+TEST(AlertAggregatorTest, Duplicates)
+{
+    using namespace std::chrono;
+
+    AlertAggregator              aggregator(seconds(10));
+    std::vector<AggregatedAlert> duplicates;
+    steady_clock::time_point     now;
+
+    EXPECT_TRUE(aggregator.Add("disk", "sda failed", now));
+    EXPECT_FALSE(aggregator.Add("disk", "sda failed", now + seconds(1)));
+    EXPECT_FALSE(aggregator.Add("disk", "sda failed", now + seconds(2)));
+    EXPECT_TRUE(aggregator.Add("disk", "sdb failed", now + seconds(2)));
+
+    aggregator.Flush(now + seconds(5), duplicates);
+    EXPECT_TRUE(duplicates.empty());
+
+    aggregator.Flush(now + seconds(11), duplicates);
+    ASSERT_EQ(duplicates.size(), 1);
+    EXPECT_EQ(duplicates[0].mMessage, "sda failed");
+    EXPECT_EQ(duplicates[0].mCount, 2);
+
+    aggregator.Flush(now + seconds(20), duplicates);
+    EXPECT_TRUE(duplicates.empty());
+
+    EXPECT_TRUE(aggregator.Add("disk", "sda failed", now + seconds(21)));
+}
+
+// Run with --gtest_also_run_disabled_tests.
+TEST(AlertMatcherTest, DISABLED_ThroughputBenchmark)
+{
+    constexpr size_t cRuleCount    = 50;
+    constexpr size_t cMessageCount = 10000;
+    constexpr size_t cRounds       = 20;
+
+    auto rules    = CreateBenchmarkRules(cRuleCount);
+    auto messages = CreateBenchmarkMessages(cMessageCount, cRuleCount);
+
+    std::vector<std::regex> regexes;
+
+    for (const auto& rule : rules) {
+        regexes.emplace_back(rule.mPattern);
+    }
+
+    AlertMatcher matcher;
+
+    ASSERT_EQ(matcher.Init(rules), 0);
+
+    // Baseline: every rule regex is evaluated for every message.
+    auto regex = MeasureEntriesPerSec(messages, 1, [&](const std::string& message) {
+        size_t matches = 0;
+
+        for (const auto& rule : regexes) {
+            matches += std::regex_search(message, rule);
+        }
+
+        return matches;
+    });
+
+    std::vector<size_t> matched;
+
+    auto automaton = MeasureEntriesPerSec(messages, cRounds, [&](const std::string& message) {
+        matcher.Match(message, matched);
+
+        return matched.size();
+    });
+
+    // Journal watcher path: matching followed by duplicate aggregation of matched entries.
+    AlertAggregator aggregator(std::chrono::seconds(10));
+    auto            now = std::chrono::steady_clock::now();
+
+    auto watcher = MeasureEntriesPerSec(messages, cRounds, [&](const std::string& message) {
+        matcher.Match(message, matched);
+
+        for (auto index : matched) {
+            aggregator.Add(matcher.GetRule(index).mName, message, now);
+        }
+
+        return matched.size();
+    });
+
+    printf("%zu rules: std::regex %.0f entries/sec, AlertMatcher %.0f entries/sec, with aggregation %.0f entries/sec\n",
+        cRuleCount, regex, automaton, watcher);
+}
+
+} // namespace aos::common::logprovider
@@ -0,0 +1,411 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "logprovider/journallogsource.hpp"
+
+#if AOS_WITH_JOURNAL
+#include <systemd/sd-journal.h>
+#endif
+
+using namespace testing;
+
+#if AOS_WITH_JOURNAL
+
+/***********************************************************************************************************************
+ * Fake journal
+ **********************************************************************************************************************/
+
+namespace {
+
+struct FakeJournalEntry {
+    uint64_t                 mTimeUs;
+    std::vector<std::string> mFields;
+};
+
+// Journal content shared by all handles, replaces libsystemd journal at link time.
+struct FakeJournal {
+    std::deque<FakeJournalEntry> mEntries;
+    int                          mOpenError = 0;
+    std::vector<std::string>     mFiles;
+    std::string                  mDirectory;
+    size_t                       mDataThreshold = 0;
+    size_t                       mOpenCount     = 0;
+};
+
+FakeJournal sFakeJournal;
+
+} // namespace
+
+struct sd_journal {
+    std::vector<std::string> mMatches;
+    // Index of current entry: -1 is before the first one.
+    ptrdiff_t mCurrent = -1;
+};
+
+namespace {
+
+std::string_view GetFieldName(std::string_view data)
+{
+    return data.substr(0, data.find('='));
+}
+
+// Different fields are ANDed, values of the same field are ORed.
+bool Matches(const sd_journal* journal, const FakeJournalEntry& entry)
+{
+    for (const auto& match : journal->mMatches) {
+        auto name = GetFieldName(match);
+
+        auto hasValue = std::any_of(journal->mMatches.begin(), journal->mMatches.end(), [&](const std::string& value) {
+            return GetFieldName(value) == name
+                && std::find(entry.mFields.begin(), entry.mFields.end(), value) != entry.mFields.end();
+        });
+
+        if (!hasValue) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int OpenFakeJournal(sd_journal** ret)
+{
+    if (sFakeJournal.mOpenError != 0) {
+        return -sFakeJournal.mOpenError;
+    }
+
+    sFakeJournal.mOpenCount++;
+    *ret = new sd_journal {};
+
+    return 0;
+}
+
+} // namespace
+
+extern "C" {
+
+int sd_journal_open(sd_journal** ret, int)
+{
+    return OpenFakeJournal(ret);
+}
+
+int sd_journal_open_directory(sd_journal** ret, const char* path, int)
+{
+    sFakeJournal.mDirectory = path;
+
+    return OpenFakeJournal(ret);
+}
+
+int sd_journal_open_files(sd_journal** ret, const char** paths, int)
+{
+    sFakeJournal.mFiles.clear();
+
+    for (auto path = paths; *path != nullptr; path++) {
+        sFakeJournal.mFiles.emplace_back(*path);
+    }
+
+    return OpenFakeJournal(ret);
+}
+
+void sd_journal_close(sd_journal* j)
+{
+    delete j;
+}
+
+int sd_journal_add_match(sd_journal* j, const void* data, size_t size)
+{
+    j->mMatches.emplace_back(static_cast<const char*>(data), size);
+
+    return 0;
+}
+
+int sd_journal_set_data_threshold(sd_journal*, size_t sz)
+{
+    sFakeJournal.mDataThreshold = sz;
+
+    return 0;
+}
+
+int sd_journal_seek_realtime_usec(sd_journal* j, uint64_t usec)
+{
+    const auto& entries = sFakeJournal.mEntries;
+
+    auto it = std::find_if(
+        entries.begin(), entries.end(), [usec](const FakeJournalEntry& entry) { return entry.mTimeUs >= usec; });
+
+    j->mCurrent = it - entries.begin() - 1;
+
+    return 0;
+}
+
+int sd_journal_seek_tail(sd_journal* j)
+{
+    j->mCurrent = static_cast<ptrdiff_t>(sFakeJournal.mEntries.size());
+
+    return 0;
+}
+
+int sd_journal_next(sd_journal* j)
+{
+    const auto& entries = sFakeJournal.mEntries;
+
+    for (auto i = j->mCurrent + 1; i < static_cast<ptrdiff_t>(entries.size()); i++) {
+        if (Matches(j, entries[i])) {
+            j->mCurrent = i;
+
+            return 1;
+        }
+    }
+
+    // Stays at the last entry: entries appended later are returned by next call.
+    j->mCurrent = std::max<ptrdiff_t>(j->mCurrent, static_cast<ptrdiff_t>(entries.size()) - 1);
+
+    return 0;
+}
+
+int sd_journal_previous(sd_journal* j)
+{
+    const auto& entries = sFakeJournal.mEntries;
+
+    for (auto i = std::min(j->mCurrent, static_cast<ptrdiff_t>(entries.size())) - 1; i >= 0; i--) {
+        if (Matches(j, entries[i])) {
+            j->mCurrent = i;
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+int sd_journal_get_realtime_usec(sd_journal* j, uint64_t* ret)
+{
+    *ret = sFakeJournal.mEntries[j->mCurrent].mTimeUs;
+
+    return 0;
+}
+
+int sd_journal_get_data(sd_journal* j, const char* field, const void** data, size_t* l)
+{
+    auto threshold = sFakeJournal.mDataThreshold != 0 ? sFakeJournal.mDataThreshold : SIZE_MAX;
+
+    for (const auto& value : sFakeJournal.mEntries[j->mCurrent].mFields) {
+        if (GetFieldName(value) == field) {
+            *data = value.data();
+            *l    = std::min(value.size(), threshold);
+
+            return 0;
+        }
+    }
+
+    return -ENOENT;
+}
+
+int sd_journal_wait(sd_journal*, uint64_t)
+{
+    return SD_JOURNAL_NOP;
+}
+
+} // extern "C"
+
+#endif
+
+namespace aos::common::logprovider {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+struct ReadEntry {
+    int64_t     mTimeUs;
+    std::string mMessage;
+    std::string mSourceID;
+
+    bool operator==(const ReadEntry& other) const
+    {
+        return mTimeUs == other.mTimeUs && mMessage == other.mMessage && mSourceID == other.mSourceID;
+    }
+};
+
+int ReadAll(LogSource& source, std::vector<ReadEntry>& entries)
+{
+    entries.clear();
+
+    for (;;) {
+        LogEntry entry;
+        bool     eof = false;
+
+        if (auto err = source.Next(entry, eof); err != 0) {
+            return err;
+        }
+
+        if (eof) {
+            return 0;
+        }
+
+        entries.push_back({entry.mTimeUs, std::string(entry.mMessage), std::string(entry.mSourceID)});
+    }
+}
+
+} // namespace
+
+#if AOS_WITH_JOURNAL
+
+/***********************************************************************************************************************
+ * Suite
+ **********************************************************************************************************************/
+
+class JournalLogSourceTest : public Test {
+protected:
+    void SetUp() override
+    {
+        sFakeJournal = FakeJournal {};
+
+        AddEntry(10, {"MESSAGE=started", "_SYSTEMD_UNIT=a.service", "PRIORITY=6"});
+        AddEntry(20, {"MESSAGE=disk failed", "_SYSTEMD_UNIT=b.service", "PRIORITY=3"});
+        AddEntry(30, {"_SYSTEMD_UNIT=a.service", "MESSAGE=out of memory", "PRIORITY=3"});
+        AddEntry(40, {"MESSAGE=kernel message", "PRIORITY=3"});
+        AddEntry(50, {"MESSAGE=stopped", "_SYSTEMD_UNIT=c.service", "PRIORITY=6"});
+    }
+
+    void AddEntry(uint64_t timeUs, std::vector<std::string> fields)
+    {
+        sFakeJournal.mEntries.push_back({timeUs, std::move(fields)});
+    }
+};
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST_F(JournalLogSourceTest, ReadRange)
+{
+    JournalLogSourceConfig config;
+
+    config.mFiles         = {"/var/log/journal/system@1.journal", "/var/log/journal/system@2.journal"};
+    config.mSourceIDField = "_SYSTEMD_UNIT";
+    config.mFromUs        = 20;
+    config.mTillUs        = 40;
+
+    JournalLogSource       source(config);
+    std::vector<ReadEntry> entries;
+
+    ASSERT_EQ(ReadAll(source, entries), 0);
+
+    EXPECT_EQ(entries,
+        std::vector<ReadEntry>(
+            {{20, "disk failed", "b.service"}, {30, "out of memory", "a.service"}, {40, "kernel message", ""}}));
+    EXPECT_EQ(sFakeJournal.mFiles, config.mFiles);
+    EXPECT_EQ(sFakeJournal.mDataThreshold, config.mMaxFieldSize);
+
+    // Done after the range end: journal is not read again.
+    LogEntry entry;
+    bool     eof = false;
+
+    EXPECT_EQ(source.Next(entry, eof), 0);
+    EXPECT_TRUE(eof);
+}
+
+TEST_F(JournalLogSourceTest, Matches)
+{
+    JournalLogSourceConfig config;
+
+    config.mDirectory     = "/run/log/journal";
+    config.mSourceIDField = "_SYSTEMD_UNIT";
+    config.mMatches       = {"_SYSTEMD_UNIT=a.service", "_SYSTEMD_UNIT=b.service", "PRIORITY=3"};
+
+    JournalLogSource       source(config);
+    std::vector<ReadEntry> entries;
+
+    ASSERT_EQ(ReadAll(source, entries), 0);
+
+    EXPECT_EQ(entries,
+        std::vector<ReadEntry>({{20, "disk failed", "b.service"}, {30, "out of memory", "a.service"}}));
+    EXPECT_EQ(sFakeJournal.mDirectory, config.mDirectory);
+}
+
+TEST_F(JournalLogSourceTest, MissingFields)
+{
+    AddEntry(60, {"_SYSTEMD_UNIT=d.service"});
+
+    JournalLogSourceConfig config;
+
+    config.mFromUs       = 50;
+    config.mMaxFieldSize = 12;
+
+    JournalLogSource       source(config);
+    std::vector<ReadEntry> entries;
+
+    ASSERT_EQ(ReadAll(source, entries), 0);
+
+    // Source ID field is not set; message is cut by data threshold.
+    EXPECT_EQ(entries, std::vector<ReadEntry>({{50, "stop", ""}, {60, "", ""}}));
+}
+
+TEST_F(JournalLogSourceTest, Follow)
+{
+    JournalLogSourceConfig config;
+
+    config.mFollow = true;
+
+    JournalLogSource       source(config);
+    std::vector<ReadEntry> entries;
+
+    // Follow mode starts at the tail: existing entries are skipped, journal end is reported as eof.
+    ASSERT_EQ(ReadAll(source, entries), 0);
+    EXPECT_TRUE(entries.empty());
+
+    AddEntry(60, {"MESSAGE=new entry"});
+
+    ASSERT_EQ(source.Wait(std::chrono::milliseconds(10)), 0);
+    ASSERT_EQ(ReadAll(source, entries), 0);
+    EXPECT_EQ(entries, std::vector<ReadEntry>({{60, "new entry", ""}}));
+
+    AddEntry(70, {"MESSAGE=next entry"});
+
+    ASSERT_EQ(ReadAll(source, entries), 0);
+    EXPECT_EQ(entries, std::vector<ReadEntry>({{70, "next entry", ""}}));
+    EXPECT_EQ(sFakeJournal.mOpenCount, 1);
+}
+
+TEST_F(JournalLogSourceTest, OpenError)
+{
+    sFakeJournal.mOpenError = EACCES;
+
+    JournalLogSource source({});
+    LogEntry         entry;
+    bool             eof = false;
+
+    EXPECT_EQ(source.Next(entry, eof), EACCES);
+    EXPECT_FALSE(eof);
+    EXPECT_EQ(source.Wait(std::chrono::milliseconds(10)), EACCES);
+}
+
+#else
+
+TEST(JournalLogSourceTest, NotSupported)
+{
+    JournalLogSource       source({});
+    std::vector<ReadEntry> entries;
+
+    EXPECT_EQ(ReadAll(source, entries), ENOTSUP);
+    EXPECT_EQ(source.Wait(std::chrono::milliseconds(10)), ENOTSUP);
+}
+
+#endif
+
+} // namespace aos::common::logprovider
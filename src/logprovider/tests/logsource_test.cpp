@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "logprovider/logsource.hpp"
+
+using namespace testing;
+
+namespace aos::common::logprovider {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+// Returns predefined entries. Message buffer is overwritten on each call, as real sources reuse their buffers.
+class FakeLogSource : public LogSource {
+public:
+    FakeLogSource(std::string sourceID, std::vector<int64_t> times, int error = 0)
+        : mSourceID(std::move(sourceID))
+        , mTimes(std::move(times))
+        , mError(error)
+    {
+    }
+
+    int Next(LogEntry& entry, bool& eof) override
+    {
+        eof = false;
+        mCalls++;
+
+        if (mRead == mTimes.size()) {
+            eof = mError == 0;
+
+            return mError;
+        }
+
+        mMessage = mSourceID + "/" + std::to_string(mRead);
+
+        entry.mTimeUs   = mTimes[mRead++];
+        entry.mMessage  = mMessage;
+        entry.mSourceID = mSourceID;
+
+        return 0;
+    }
+
+    size_t GetCalls() const { return mCalls; }
+
+private:
+    std::string          mSourceID;
+    std::string          mMessage;
+    std::vector<int64_t> mTimes;
+    int                  mError;
+    size_t               mRead  = 0;
+    size_t               mCalls = 0;
+};
+
+using MergedEntries = std::vector<std::pair<int64_t, std::string>>;
+
+FakeLogSource* AddSource(MergedLogSource& merged, std::string sourceID, std::vector<int64_t> times, int error = 0)
+{
+    auto source = std::make_unique<FakeLogSource>(std::move(sourceID), std::move(times), error);
+    auto result = source.get();
+
+    merged.AddSource(std::move(source));
+
+    return result;
+}
+
+int ReadAll(LogSource& source, MergedEntries& entries, size_t limit = SIZE_MAX)
+{
+    entries.clear();
+
+    while (entries.size() < limit) {
+        LogEntry entry;
+        bool     eof = false;
+
+        if (auto err = source.Next(entry, eof); err != 0) {
+            return err;
+        }
+
+        if (eof) {
+            break;
+        }
+
+        entries.emplace_back(entry.mTimeUs, std::string(entry.mMessage));
+    }
+
+    return 0;
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST(MergedLogSourceTest, Order)
+{
+    MergedLogSource merged;
+    MergedEntries   entries;
+
+    AddSource(merged, "a", {1, 4, 7, 10});
+    AddSource(merged, "b", {2, 3, 8});
+    AddSource(merged, "c", {});
+    AddSource(merged, "d", {0, 5, 6, 9, 11, 12});
+
+    ASSERT_EQ(ReadAll(merged, entries), 0);
+
+    EXPECT_EQ(entries,
+        MergedEntries({{0, "d/0"}, {1, "a/0"}, {2, "b/0"}, {3, "b/1"}, {4, "a/1"}, {5, "d/1"}, {6, "d/2"}, {7, "a/2"},
+            {8, "b/2"}, {9, "d/3"}, {10, "a/3"}, {11, "d/4"}, {12, "d/5"}}));
+
+    // Eof is sticky.
+    LogEntry entry;
+    bool     eof = false;
+
+    EXPECT_EQ(merged.Next(entry, eof), 0);
+    EXPECT_TRUE(eof);
+}
+
+TEST(MergedLogSourceTest, Empty)
+{
+    MergedLogSource merged;
+    LogEntry        entry;
+    bool            eof = false;
+
+    EXPECT_EQ(merged.Next(entry, eof), 0);
+    EXPECT_TRUE(eof);
+}
+
+TEST(MergedLogSourceTest, Ties)
+{
+    MergedLogSource merged;
+    MergedEntries   entries;
+
+    AddSource(merged, "a", {1, 1, 2});
+    AddSource(merged, "b", {1, 2, 2});
+    AddSource(merged, "c", {0, 1, 2});
+
+    ASSERT_EQ(ReadAll(merged, entries), 0);
+
+    // Equal times are returned in order of sources, entries of one source keep their order.
+    EXPECT_EQ(entries,
+        MergedEntries({{0, "c/0"}, {1, "a/0"}, {1, "a/1"}, {1, "b/0"}, {1, "c/1"}, {2, "a/2"}, {2, "b/1"}, {2, "b/2"},
+            {2, "c/2"}}));
+}
+
+TEST(MergedLogSourceTest, EarlyStop)
+{
+    MergedLogSource merged;
+    MergedEntries   entries;
+
+    std::vector<int64_t> times(1000);
+
+    for (size_t i = 0; i < times.size(); i++) {
+        times[i] = static_cast<int64_t>(i) * 2;
+    }
+
+    auto even = AddSource(merged, "even", times);
+
+    for (auto& time : times) {
+        time++;
+    }
+
+    auto odd = AddSource(merged, "odd", times);
+
+    ASSERT_EQ(ReadAll(merged, entries, 10), 0);
+    ASSERT_EQ(entries.size(), 10);
+    EXPECT_EQ(entries.back(), MergedEntries::value_type(9, "odd/4"));
+
+    // Sources are read lazily: only one head entry is buffered per source, and source of the last returned entry is
+    // not advanced yet.
+    EXPECT_EQ(even->GetCalls(), 6);
+    EXPECT_EQ(odd->GetCalls(), 5);
+}
+
+TEST(MergedLogSourceTest, ReturnedEntryStaysValid)
+{
+    MergedLogSource merged;
+    LogEntry        first, second;
+    bool            eof = false;
+
+    AddSource(merged, "a", {1, 2});
+    AddSource(merged, "b", {3});
+
+    // Source of returned entry is advanced only on next call: returned view is not overwritten before that.
+    ASSERT_EQ(merged.Next(first, eof), 0);
+    EXPECT_EQ(first.mMessage, "a/0");
+
+    ASSERT_EQ(merged.Next(second, eof), 0);
+    EXPECT_EQ(second.mMessage, "a/1");
+    EXPECT_EQ(second.mSourceID, "a");
+}
+
+TEST(MergedLogSourceTest, Error)
+{
+    MergedLogSource merged;
+    MergedEntries   entries;
+
+    AddSource(merged, "a", {1, 2, 3, 4});
+    AddSource(merged, "b", {2}, EIO);
+
+    EXPECT_EQ(ReadAll(merged, entries), EIO);
+    EXPECT_EQ(entries, MergedEntries({{1, "a/0"}, {2, "a/1"}, {2, "b/0"}}));
+
+    MergedLogSource failed;
+
+    AddSource(failed, "a", {1});
+    AddSource(failed, "b", {}, ENOENT);
+
+    EXPECT_EQ(ReadAll(failed, entries), ENOENT);
+    EXPECT_TRUE(entries.empty());
+}
+
+TEST(LogSourceTest, ParseRFC3339)
+{
+    int64_t timeUs = 0;
+
+    EXPECT_TRUE(ParseRFC3339("1970-01-01T00:00:01Z", timeUs));
+    EXPECT_EQ(timeUs, 1000000);
+
+    EXPECT_TRUE(ParseRFC3339("2024-01-02T03:04:05.123456789Z", timeUs));
+    EXPECT_EQ(timeUs, 1704164645123456);
+
+    EXPECT_TRUE(ParseRFC3339("2024-01-02T05:04:05.123456+02:00", timeUs));
+    EXPECT_EQ(timeUs, 1704164645123456);
+
+    EXPECT_FALSE(ParseRFC3339("2024-01-02T03:04:05", timeUs));
+    EXPECT_FALSE(ParseRFC3339("2024-13-02T03:04:05Z", timeUs));
+    EXPECT_FALSE(ParseRFC3339("2024-01-02T03:04:05Zx", timeUs));
+}
+
+} // namespace aos::common::logprovider
@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "logprovider/prefetchlogsource.hpp"
+
+using namespace testing;
+
+namespace aos::common::logprovider {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+struct TestEntry {
+    int64_t     mTimeUs;
+    std::string mMessage;
+    std::string mSourceID;
+
+    bool operator==(const TestEntry& other) const
+    {
+        return mTimeUs == other.mTimeUs && mMessage == other.mMessage && mSourceID == other.mSourceID;
+    }
+};
+
+// Returns entries generated on the fly; endless if count is not set.
+class FakeLogSource : public LogSource {
+public:
+    FakeLogSource(std::string sourceID, int64_t firstUs, int64_t stepUs, size_t count = SIZE_MAX, int error = 0)
+        : mSourceID(std::move(sourceID))
+        , mTimeUs(firstUs)
+        , mStepUs(stepUs)
+        , mCount(count)
+        , mError(error)
+    {
+    }
+
+    int Next(LogEntry& entry, bool& eof) override
+    {
+        eof = false;
+
+        if (mRead == mCount) {
+            eof = mError == 0;
+
+            return mError;
+        }
+
+        mMessage = mSourceID + " " + std::to_string(mRead++);
+
+        entry.mTimeUs   = mTimeUs;
+        entry.mMessage  = mMessage;
+        entry.mSourceID = mSourceID;
+
+        mTimeUs += mStepUs;
+        sRead++;
+
+        return 0;
+    }
+
+    static std::atomic<size_t> sRead;
+
+private:
+    std::string mSourceID;
+    std::string mMessage;
+    int64_t     mTimeUs;
+    int64_t     mStepUs;
+    size_t      mCount;
+    int         mError;
+    size_t      mRead = 0;
+};
+
+std::atomic<size_t> FakeLogSource::sRead {0};
+
+int ReadAll(LogSource& source, std::vector<TestEntry>& entries, size_t limit = SIZE_MAX)
+{
+    entries.clear();
+
+    while (entries.size() < limit) {
+        LogEntry entry;
+        bool     eof = false;
+
+        if (auto err = source.Next(entry, eof); err != 0) {
+            return err;
+        }
+
+        if (eof) {
+            break;
+        }
+
+        entries.push_back({entry.mTimeUs, std::string(entry.mMessage), std::string(entry.mSourceID)});
+    }
+
+    return 0;
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST(PrefetchLogSourceTest, KeepsOrder)
+{
+    FakeLogSource          expectedSource("unit", 0, 10, 1000);
+    std::vector<TestEntry> expected;
+
+    ASSERT_EQ(ReadAll(expectedSource, expected), 0);
+
+    for (auto [batchSize, maxBatches] : {std::pair<size_t, size_t> {1, 1}, {7, 2}, {1024, 4}}) {
+        PrefetchLogSource      source(std::make_unique<FakeLogSource>("unit", 0, 10, 1000), {}, batchSize, maxBatches);
+        std::vector<TestEntry> entries;
+
+        EXPECT_EQ(ReadAll(source, entries), 0);
+        EXPECT_EQ(entries, expected) << batchSize;
+    }
+}
+
+TEST(PrefetchLogSourceTest, Filter)
+{
+    auto filter = [](const LogEntry& entry) { return entry.mTimeUs % 10 == 0; };
+
+    PrefetchLogSource      source(std::make_unique<FakeLogSource>("unit", 0, 1, 100), filter, 3);
+    std::vector<TestEntry> entries;
+
+    ASSERT_EQ(ReadAll(source, entries), 0);
+    ASSERT_EQ(entries.size(), 10);
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        EXPECT_EQ(entries[i], (TestEntry {static_cast<int64_t>(i * 10), "unit " + std::to_string(i * 10), "unit"}));
+    }
+}
+
+TEST(PrefetchLogSourceTest, Error)
+{
+    PrefetchLogSource      source(std::make_unique<FakeLogSource>("unit", 0, 1, 10, EIO), {}, 4);
+    std::vector<TestEntry> entries;
+
+    // Entries read before the error are returned first.
+    EXPECT_EQ(ReadAll(source, entries), EIO);
+    EXPECT_EQ(entries.size(), 10);
+}
+
+TEST(PrefetchLogSourceTest, EarlyStop)
+{
+    constexpr size_t cBatchSize  = 8;
+    constexpr size_t cMaxBatches = 2;
+
+    FakeLogSource::sRead = 0;
+
+    // Endless source: destruction must stop the scanning thread blocked on full queues.
+    PrefetchLogSource      source(std::make_unique<FakeLogSource>("unit", 0, 1), {}, cBatchSize, cMaxBatches);
+    std::vector<TestEntry> entries;
+
+    ASSERT_EQ(ReadAll(source, entries, 20), 0);
+    ASSERT_EQ(entries.size(), 20);
+    EXPECT_EQ(entries.back().mTimeUs, 19);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // Read ahead is bounded by batches in flight.
+    EXPECT_LE(FakeLogSource::sRead, 20 + cMaxBatches * cBatchSize);
+}
+
+TEST(PrefetchLogSourceTest, Partitioned)
+{
+    std::vector<std::unique_ptr<LogSource>> partitions;
+
+    // Interleaved partitions: p0 at 0, 3, 6..., p1 at 1, 4, 7..., p2 at 2, 5, 8... and p3 ties with p0.
+    for (int i = 0; i < 3; i++) {
+        partitions.push_back(std::make_unique<FakeLogSource>("p" + std::to_string(i), i, 3, 500));
+    }
+
+    partitions.push_back(std::make_unique<FakeLogSource>("p3", 0, 3, 500));
+
+    auto source = CreatePartitionedLogSource(
+        std::move(partitions), [](const LogEntry& entry) { return entry.mTimeUs % 2 == 0; }, 16, 2);
+
+    std::vector<TestEntry> entries;
+
+    ASSERT_EQ(ReadAll(*source, entries), 0);
+    ASSERT_EQ(entries.size(), 1000);
+
+    for (size_t i = 1; i < entries.size(); i++) {
+        ASSERT_LE(entries[i - 1].mTimeUs, entries[i].mTimeUs) << i;
+        EXPECT_EQ(entries[i].mTimeUs % 2, 0);
+
+        if (entries[i - 1].mTimeUs == entries[i].mTimeUs) {
+            EXPECT_EQ(entries[i - 1].mSourceID, "p0");
+            EXPECT_EQ(entries[i].mSourceID, "p3");
+        }
+    }
+}
+
+TEST(PrefetchLogSourceTest, PartitionedEarlyStop)
+{
+    std::vector<std::unique_ptr<LogSource>> partitions;
+
+    for (int i = 0; i < 4; i++) {
+        partitions.push_back(std::make_unique<FakeLogSource>("p" + std::to_string(i), i, 4));
+    }
+
+    auto source = CreatePartitionedLogSource(std::move(partitions), {}, 4, 1);
+
+    std::vector<TestEntry> entries;
+
+    ASSERT_EQ(ReadAll(*source, entries, 100), 0);
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        EXPECT_EQ(entries[i].mTimeUs, static_cast<int64_t>(i));
+    }
+
+    // Dropping merged source stops all endless partitions.
+    source.reset();
+}
+
+} // namespace aos::common::logprovider
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "atomicfile.hpp"
+
+namespace aos::common::utils {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+int SyncParentDir(const std::string& path)
+{
+    auto pos = path.find_last_of('/');
+    auto dir = pos == std::string::npos ? std::string(".") : path.substr(0, pos == 0 ? 1 : pos);
+
+    auto fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        return errno;
+    }
+
+    auto err = fsync(fd) != 0 ? errno : 0;
+
+    close(fd);
+
+    return err;
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+int WriteFileAtomically(const std::string& path, std::string_view content, mode_t mode, struct stat* st)
+{
+    auto tmpPath = path + ".XXXXXX";
+
+    auto fd = mkostemp(tmpPath.data(), O_CLOEXEC);
+    if (fd < 0) {
+        return errno;
+    }
+
+    auto err = fchmod(fd, mode) != 0 ? errno : 0;
+
+    for (size_t offset = 0; err == 0 && offset < content.size();) {
+        auto n = write(fd, content.data() + offset, content.size() - offset);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (n < 0) {
+            err = errno;
+            break;
+        }
+
+        offset += static_cast<size_t>(n);
+    }
+
+    if (err == 0 && fsync(fd) != 0) {
+        err = errno;
+    }
+
+    if (err == 0 && st != nullptr && fstat(fd, st) != 0) {
+        err = errno;
+    }
+
+    if (close(fd) != 0 && err == 0) {
+        err = errno;
+    }
+
+    if (err == 0 && rename(tmpPath.c_str(), path.c_str()) != 0) {
+        err = errno;
+    }
+
+    if (err != 0) {
+        unlink(tmpPath.c_str());
+
+        return err;
+    }
+
+    // Rename is durable only after directory entry is synced.
+    return SyncParentDir(path);
+}
+
+} // namespace aos::common::utils
@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ATOMICFILE_HPP_
+#define ATOMICFILE_HPP_
+
+#include <string>
+#include <string_view>
+
+#include <sys/stat.h>
+
+namespace aos::common::utils {
+
+/**
+ * Writes file atomically and durably.
+ *
+ * Content is written into a uniquely named temporary file next to the path, so concurrent writers, e.g. other
+ * processes, don't share it. The file is synced and renamed over the path, then the parent directory is synced:
+ * readers see either the old or the new content, and after a crash the path holds one of them.
+ *
+ * @param path file path.
+ * @param content file content.
+ * @param mode file mode, umask is not applied.
+ * @param[out] st stat of the written file, optional. Renamed file keeps its inode and modification time.
+ * @return int 0 on success or errno value on failure.
+ */
+int WriteFileAtomically(
+    const std::string& path, std::string_view content, mode_t mode = 0644, struct stat* st = nullptr);
+
+} // namespace aos::common::utils
+
+#endif
@@ -0,0 +1,508 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <filesystem>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "configwatcher.hpp"
+#include "jsonstreamparser.hpp"
+#include "jsontemplate.hpp"
+
+namespace aos::common::utils {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Consts
+ **********************************************************************************************************************/
+
+constexpr auto cInotifyBufferSize = 4096;
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+void AppendPointerToken(std::string& path, std::string_view token)
+{
+    // JSON pointer escaping, RFC 6901.
+    for (auto chr : token) {
+        if (chr == '~') {
+            path += "~0";
+        } else if (chr == '/') {
+            path += "~1";
+        } else {
+            path += chr;
+        }
+    }
+}
+
+class ConfigBuilder : public JSONEventHandler {
+public:
+    explicit ConfigBuilder(ConfigSections& sections)
+        : mSections(sections)
+    {
+    }
+
+    int GetError() const { return mError; }
+
+    bool OnObjectBegin() override { return BeginContainer(false); }
+    bool OnArrayBegin() override { return BeginContainer(true); }
+    bool OnObjectEnd() override { return EndContainer('}', "{}"); }
+    bool OnArrayEnd() override { return EndContainer(']', "[]"); }
+
+    bool OnKey(std::string_view key) override
+    {
+        mKey.assign(key);
+
+        return true;
+    }
+
+    bool OnScalar(JSONScalarType type, std::string_view value) override
+    {
+        if (!BeginValue()) {
+            return false;
+        }
+
+        auto& json   = mSection->mJSON;
+        auto  offset = json.size();
+
+        switch (type) {
+        case JSONScalarType::eString:
+            AppendJSONString(json, value);
+            break;
+
+        case JSONScalarType::eNumber:
+            json.append(value);
+            break;
+
+        case JSONScalarType::eTrue:
+            json.append("true");
+            break;
+
+        case JSONScalarType::eFalse:
+            json.append("false");
+            break;
+
+        default:
+            json.append("null");
+        }
+
+        mSection->mValues[mPath] = json.substr(offset);
+
+        return true;
+    }
+
+private:
+    struct Frame {
+        bool   mIsArray;
+        size_t mPathSize;
+        size_t mCount;
+    };
+
+    bool BeginValue()
+    {
+        // Config root must be an object.
+        if (mFrames.empty()) {
+            mError = EINVAL;
+
+            return false;
+        }
+
+        auto& parent = mFrames.back();
+
+        parent.mCount++;
+
+        if (mFrames.size() == 1) {
+            // Duplicate section key: the last one wins.
+            mSection  = &mSections[mKey];
+            *mSection = ConfigSection {};
+            mPath.clear();
+
+            return true;
+        }
+
+        if (parent.mCount > 1) {
+            mSection->mJSON += ',';
+        }
+
+        mPath.resize(parent.mPathSize);
+        mPath += '/';
+
+        if (parent.mIsArray) {
+            mPath += std::to_string(parent.mCount - 1);
+        } else {
+            AppendPointerToken(mPath, mKey);
+            AppendJSONString(mSection->mJSON, mKey);
+            mSection->mJSON += ':';
+        }
+
+        return true;
+    }
+
+    bool BeginContainer(bool isArray)
+    {
+        if (mFrames.empty() && !isArray) {
+            mFrames.push_back({false, 0, 0});
+
+            return true;
+        }
+
+        if (!BeginValue()) {
+            return false;
+        }
+
+        mFrames.push_back({isArray, mPath.size(), 0});
+        mSection->mJSON += isArray ? '[' : '{';
+
+        return true;
+    }
+
+    bool EndContainer(char chr, const char* emptyValue)
+    {
+        auto frame = mFrames.back();
+
+        mFrames.pop_back();
+
+        if (mFrames.empty()) {
+            return true;
+        }
+
+        mSection->mJSON += chr;
+
+        if (frame.mCount == 0) {
+            mPath.resize(frame.mPathSize);
+            mSection->mValues[mPath] = emptyValue;
+        }
+
+        return true;
+    }
+
+    ConfigSections&    mSections;
+    ConfigSection*     mSection = nullptr;
+    std::vector<Frame> mFrames;
+    std::string        mKey;
+    std::string        mPath;
+    int                mError = 0;
+};
+
+void DiffValues(const std::map<std::string, std::string>& from, const std::map<std::string, std::string>& to,
+    std::vector<std::string>& changedPaths)
+{
+    auto fromIt = from.begin();
+    auto toIt   = to.begin();
+
+    while (fromIt != from.end() || toIt != to.end()) {
+        if (toIt == to.end() || (fromIt != from.end() && fromIt->first < toIt->first)) {
+            changedPaths.push_back((fromIt++)->first);
+        } else if (fromIt == from.end() || toIt->first < fromIt->first) {
+            changedPaths.push_back((toIt++)->first);
+        } else {
+            if (fromIt->second != toIt->second) {
+                changedPaths.push_back(toIt->first);
+            }
+
+            fromIt++;
+            toIt++;
+        }
+    }
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+int ParseConfig(std::string_view content, ConfigSections& sections)
+{
+    ConfigSections   parsed;
+    ConfigBuilder    builder(parsed);
+    JSONStreamParser parser(builder);
+
+    auto err = parser.Feed(content);
+
+    if (err == 0 && builder.GetError() == 0) {
+        err = parser.Finish();
+    }
+
+    if (err == 0) {
+        err = builder.GetError();
+    }
+
+    if (err != 0) {
+        return err;
+    }
+
+    sections.swap(parsed);
+
+    return 0;
+}
+
+int ParseConfigFile(const std::string& path, ConfigSections& sections)
+{
+    ConfigSections parsed;
+    ConfigBuilder  builder(parsed);
+
+    auto err = ParseJSONFile(path, builder);
+
+    if (err == 0) {
+        err = builder.GetError();
+    }
+
+    if (err != 0) {
+        return err;
+    }
+
+    sections.swap(parsed);
+
+    return 0;
+}
+
+void DiffConfig(const ConfigSections& from, const ConfigSections& to, std::vector<ConfigSectionChange>& changes)
+{
+    static const ConfigSection sEmptySection;
+
+    changes.clear();
+
+    auto fromIt = from.begin();
+    auto toIt   = to.begin();
+
+    while (fromIt != from.end() || toIt != to.end()) {
+        const std::string*   name        = nullptr;
+        const ConfigSection* fromSection = &sEmptySection;
+        const ConfigSection* toSection   = &sEmptySection;
+
+        if (toIt == to.end() || (fromIt != from.end() && fromIt->first < toIt->first)) {
+            name        = &fromIt->first;
+            fromSection = &(fromIt++)->second;
+        } else if (fromIt == from.end() || toIt->first < fromIt->first) {
+            name      = &toIt->first;
+            toSection = &(toIt++)->second;
+        } else {
+            name        = &toIt->first;
+            fromSection = &(fromIt++)->second;
+            toSection   = &(toIt++)->second;
+        }
+
+        // Any existing section has at least one leaf value.
+        if (fromSection->mValues == toSection->mValues) {
+            continue;
+        }
+
+        ConfigSectionChange change {*name, toSection->mJSON, {}};
+
+        DiffValues(fromSection->mValues, toSection->mValues, change.mChangedPaths);
+        changes.push_back(std::move(change));
+    }
+}
+
+ConfigWatcher::ConfigWatcher(std::string path)
+    : mPath(std::move(path))
+{
+}
+
+ConfigWatcher::~ConfigWatcher()
+{
+    Stop();
+}
+
+int ConfigWatcher::Start()
+{
+    if (mThread.joinable()) {
+        return EBUSY;
+    }
+
+    {
+        std::lock_guard lock {mReloadMutex};
+
+        ConfigSections sections;
+
+        if (auto err = ParseConfigFile(mPath, sections); err != 0) {
+            return err;
+        }
+
+        std::lock_guard sectionsLock {mMutex};
+
+        mSections.swap(sections);
+    }
+
+    auto dir = std::filesystem::path(mPath).parent_path();
+
+    if (dir.empty()) {
+        dir = ".";
+    }
+
+    // Directory is watched: editors and config deployment usually replace the file by rename.
+    if (mInotifyFD = inotify_init1(IN_CLOEXEC | IN_NONBLOCK); mInotifyFD < 0) {
+        return errno;
+    }
+
+    if (inotify_add_watch(mInotifyFD, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        auto err = errno;
+
+        Stop();
+
+        return err;
+    }
+
+    if (mEventFD = eventfd(0, EFD_CLOEXEC); mEventFD < 0) {
+        auto err = errno;
+
+        Stop();
+
+        return err;
+    }
+
+    mThread = std::thread(&ConfigWatcher::Run, this);
+
+    return 0;
+}
+
+void ConfigWatcher::Stop()
+{
+    if (mThread.joinable()) {
+        uint64_t value = 1;
+
+        if (write(mEventFD, &value, sizeof(value)) < 0) {
+            // Counter overflow means stop is already pending.
+        }
+
+        // Called from a subscriber: the thread can't join itself, it exits once the callback returns.
+        if (mThread.get_id() == std::this_thread::get_id()) {
+            return;
+        }
+
+        mThread.join();
+    }
+
+    for (auto fd : {&mInotifyFD, &mEventFD}) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+size_t ConfigWatcher::Subscribe(const std::string& section, ConfigChangeFunc func)
+{
+    std::lock_guard lock {mMutex};
+
+    mSubscribers.push_back({mNextID, section, std::move(func)});
+
+    return mNextID++;
+}
+
+void ConfigWatcher::Unsubscribe(size_t id)
+{
+    std::lock_guard lock {mMutex};
+
+    mSubscribers.erase(std::remove_if(mSubscribers.begin(), mSubscribers.end(),
+                           [id](const Subscriber& subscriber) { return subscriber.mID == id; }),
+        mSubscribers.end());
+}
+
+int ConfigWatcher::GetSection(const std::string& section, std::string& json) const
+{
+    std::lock_guard lock {mMutex};
+
+    auto it = mSections.find(section);
+    if (it == mSections.end()) {
+        return ENOENT;
+    }
+
+    json = it->second.mJSON;
+
+    return 0;
+}
+
+int ConfigWatcher::Reload()
+{
+    std::lock_guard lock {mReloadMutex};
+
+    ConfigSections                   sections;
+    std::vector<ConfigSectionChange> changes;
+    // Callbacks are called without lock: subscribers may call GetSection or unsubscribe.
+    std::vector<std::pair<ConfigChangeFunc, size_t>> notifications;
+
+    if (auto err = ParseConfigFile(mPath, sections); err != 0) {
+        return err;
+    }
+
+    {
+        std::lock_guard sectionsLock {mMutex};
+
+        DiffConfig(mSections, sections, changes);
+        mSections.swap(sections);
+
+        for (size_t i = 0; i < changes.size(); i++) {
+            for (const auto& subscriber : mSubscribers) {
+                if (subscriber.mSection == changes[i].mSection) {
+                    notifications.emplace_back(subscriber.mFunc, i);
+                }
+            }
+        }
+    }
+
+    for (const auto& [func, index] : notifications) {
+        func(changes[index]);
+    }
+
+    return 0;
+}
+
+/***********************************************************************************************************************
+ * Private
+ **********************************************************************************************************************/
+
+void ConfigWatcher::Run()
+{
+    auto fileName = std::filesystem::path(mPath).filename().string();
+
+    alignas(inotify_event) char buffer[cInotifyBufferSize];
+
+    for (;;) {
+        pollfd fds[] = {{mEventFD, POLLIN, 0}, {mInotifyFD, POLLIN, 0}};
+
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return;
+        }
+
+        if (fds[0].revents != 0) {
+            return;
+        }
+
+        auto changed = false;
+        auto size    = read(mInotifyFD, buffer, sizeof(buffer));
+
+        for (ssize_t offset = 0; offset < size;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+
+            if (event->len != 0 && fileName == event->name) {
+                changed = true;
+            }
+
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+
+        // Invalid config, e.g. partially written by non atomic writer, is reloaded on the next write.
+        if (changed) {
+            Reload();
+        }
+    }
+}
+
+} // namespace aos::common::utils
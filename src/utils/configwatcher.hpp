@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef CONFIGWATCHER_HPP_
+#define CONFIGWATCHER_HPP_
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace aos::common::utils {
+
+/**
+ * Parsed config section: value of top level config key.
+ */
+struct ConfigSection {
+    // Section value as compact JSON.
+    std::string mJSON;
+    // Section leaf values as compact JSON by JSON pointer relative to section, e.g. "/limits/0/cpu". Empty objects and
+    // arrays are leaves as well.
+    std::map<std::string, std::string> mValues;
+};
+
+/**
+ * Parsed config: sections by top level key.
+ */
+using ConfigSections = std::map<std::string, ConfigSection>;
+
+/**
+ * Config section change.
+ */
+struct ConfigSectionChange {
+    std::string mSection;
+    // New section value as compact JSON, empty if section is removed.
+    std::string mJSON;
+    // JSON pointers of added, removed and modified leaf values relative to section.
+    std::vector<std::string> mChangedPaths;
+};
+
+/**
+ * Config change callback.
+ */
+using ConfigChangeFunc = std::function<void(const ConfigSectionChange& change)>;
+
+/**
+ * Parses config document: root must be JSON object.
+ *
+ * @param content config content.
+ * @param[out] sections config sections.
+ * @return int.
+ */
+int ParseConfig(std::string_view content, ConfigSections& sections);
+
+/**
+ * Parses config file: root must be JSON object.
+ *
+ * @param path config file path.
+ * @param[out] sections config sections.
+ * @return int.
+ */
+int ParseConfigFile(const std::string& path, ConfigSections& sections);
+
+/**
+ * Computes structural diff between configs.
+ *
+ * Sections are compared by leaf values, so key order and formatting changes are not reported.
+ *
+ * @param from old config.
+ * @param to new config.
+ * @param[out] changes changed sections.
+ */
+void DiffConfig(const ConfigSections& from, const ConfigSections& to, std::vector<ConfigSectionChange>& changes);
+
+/**
+ * Watches config file and notifies subscribers about changed sections.
+ *
+ * Config directory is watched with inotify, so both in place writes and atomic replace by rename are detected. New
+ * config is parsed and compared with the running one; only subscribers of changed sections are notified, from the
+ * watcher thread. Invalid config is ignored and the running one is kept.
+ *
+ * Methods return 0 on success or errno value on failure.
+ */
+class ConfigWatcher {
+public:
+    /**
+     * Creates config watcher.
+     *
+     * @param path config file path.
+     */
+    explicit ConfigWatcher(std::string path);
+
+    /**
+     * Stops watching.
+     */
+    ~ConfigWatcher();
+
+    ConfigWatcher(const ConfigWatcher&)            = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    /**
+     * Loads config and starts watching.
+     *
+     * @return int.
+     */
+    int Start();
+
+    /**
+     * Stops watching.
+     *
+     * May be called from a subscriber callback: then it only requests the watcher thread to exit, and the thread is
+     * joined by the next Stop call or the destructor from another thread. The watcher must not be destroyed from a
+     * subscriber callback.
+     */
+    void Stop();
+
+    /**
+     * Subscribes to section changes.
+     *
+     * @param section section name.
+     * @param func change callback.
+     * @return size_t subscription ID.
+     */
+    size_t Subscribe(const std::string& section, ConfigChangeFunc func);
+
+    /**
+     * Unsubscribes from section changes.
+     *
+     * @param id subscription ID.
+     */
+    void Unsubscribe(size_t id);
+
+    /**
+     * Returns running section value as compact JSON.
+     *
+     * @param section section name.
+     * @param[out] json section value.
+     * @return int ENOENT if section does not exist.
+     */
+    int GetSection(const std::string& section, std::string& json) const;
+
+    /**
+     * Reloads config: parses the file and notifies subscribers of changed sections.
+     *
+     * @return int.
+     */
+    int Reload();
+
+private:
+    struct Subscriber {
+        size_t           mID;
+        std::string      mSection;
+        ConfigChangeFunc mFunc;
+    };
+
+    void Run();
+
+    std::string             mPath;
+    mutable std::mutex      mMutex;
+    ConfigSections          mSections;
+    std::vector<Subscriber> mSubscribers;
+    size_t                  mNextID = 1;
+    // Serializes reloads, so subscribers get changes in order.
+    std::mutex  mReloadMutex;
+    int         mInotifyFD = -1;
+    int         mEventFD   = -1;
+    std::thread mThread;
+};
+
+} // namespace aos::common::utils
+
+#endif
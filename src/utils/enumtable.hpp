@@ -0,0 +1,347 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ENUMTABLE_HPP_
+#define ENUMTABLE_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+namespace aos::common::utils {
+
+/**
+ * Compile time string <-> enum table based on perfect hash.
+ *
+ * Enum values should be dense: 0..cNumValues-1, where cNumValues is the enum's own count value, e.g. eNumValues, so a
+ * value added to the enum but not to the table is detected. Enum to string is a direct index; string to enum hashes
+ * the string with seeded FNV-1a into a collision free slot table and compares a single candidate. The seed is
+ * searched at compile time for enums up to 128 values and is practically always found for up to about 100 values;
+ * otherwise lookup falls back to binary search over sorted names. Tables should be declared constexpr and checked
+ * with static_assert(table.IsValid()): the check fails if any enum value is missing, duplicated or out of range, or if
+ * any name is duplicated.
+ */
+template <typename Enum, Enum cNumValues = Enum::eNumValues>
+class EnumStringTable {
+public:
+    using Entry = std::pair<std::string_view, Enum>;
+
+    /**
+     * Creates enum string table.
+     *
+     * @param entries enum names.
+     */
+    template <size_t M>
+    constexpr explicit EnumStringTable(const std::array<Entry, M>& entries)
+    {
+        std::array<bool, cSize> present {};
+
+        if (M != cSize) {
+            return;
+        }
+
+        for (const auto& [name, value] : entries) {
+            auto index = static_cast<size_t>(value);
+
+            if (index >= cSize || present[index]) {
+                return;
+            }
+
+            present[index] = true;
+            mNames[index]  = name;
+        }
+
+        for (uint32_t seed = 0; cSize <= cMaxPerfectHashSize && seed < cMaxSeed; seed++) {
+            if (BuildSlots(seed)) {
+                mSeed        = seed;
+                mPerfectHash = true;
+                mValid       = true;
+
+                return;
+            }
+        }
+
+        SortNames();
+
+        // Equal names collide for every seed, so duplicates are possible only here: they are adjacent once sorted.
+        for (size_t i = 1; i < cSize; i++) {
+            if (mNames[mSorted[i - 1]] == mNames[mSorted[i]]) {
+                return;
+            }
+        }
+
+        mValid = true;
+    }
+
+    /**
+     * Returns true if table is complete and names are unique.
+     *
+     * @return bool.
+     */
+    constexpr bool IsValid() const { return mValid; }
+
+    /**
+     * Returns true if perfect hash is found, otherwise FromString uses binary search.
+     *
+     * @return bool.
+     */
+    constexpr bool IsPerfectHash() const { return mPerfectHash; }
+
+    /**
+     * Converts enum to string.
+     *
+     * @param value enum value.
+     * @return std::string_view empty for out of range value.
+     */
+    constexpr std::string_view ToString(Enum value) const
+    {
+        auto index = static_cast<size_t>(value);
+
+        return index < cSize ? mNames[index] : std::string_view();
+    }
+
+    /**
+     * Converts string to enum.
+     *
+     * @param name enum name.
+     * @return std::optional<Enum>.
+     */
+    constexpr std::optional<Enum> FromString(std::string_view name) const
+    {
+        if (!mPerfectHash) {
+            return FindSorted(name);
+        }
+
+        auto slot = mSlots[Hash(name, mSeed) & (cSlotCount - 1)];
+
+        if (slot == 0 || mNames[slot - 1] != name) {
+            return std::nullopt;
+        }
+
+        return static_cast<Enum>(slot - 1);
+    }
+
+private:
+    static constexpr size_t   cSize    = static_cast<size_t>(cNumValues);
+    static constexpr uint32_t cMaxSeed = 4096;
+    // Larger enums have negligible chance to get perfect hash: don't waste compile time on search.
+    static constexpr size_t cMaxPerfectHashSize = 128;
+
+    static constexpr size_t SlotCount()
+    {
+        size_t count = 1;
+
+        if (cSize > cMaxPerfectHashSize) {
+            return count;
+        }
+
+        // Load factor 1/8: for 64 values a seed is found with probability ~2% per seed.
+        while (count < 8 * cSize) {
+            count <<= 1;
+        }
+
+        return count;
+    }
+
+    static constexpr size_t cSlotCount = SlotCount();
+
+    static constexpr uint64_t Hash(std::string_view str, uint32_t seed)
+    {
+        uint64_t hash = 14695981039346656037ULL ^ seed;
+
+        for (auto chr : str) {
+            hash ^= static_cast<unsigned char>(chr);
+            hash *= 1099511628211ULL;
+        }
+
+        return hash ^ (hash >> 32);
+    }
+
+    constexpr bool BuildSlots(uint32_t seed)
+    {
+        for (size_t i = 0; i < cSize; i++) {
+            auto& slot = mSlots[Hash(mNames[i], seed) & (cSlotCount - 1)];
+
+            if (slot == 0) {
+                slot = static_cast<uint16_t>(i + 1);
+
+                continue;
+            }
+
+            // Clear only filled slots: clearing the whole table per seed dominates compile time.
+            for (size_t j = 0; j < i; j++) {
+                mSlots[Hash(mNames[j], seed) & (cSlotCount - 1)] = 0;
+            }
+
+            return false;
+        }
+
+        return true;
+    }
+
+    constexpr void SortNames()
+    {
+        // Insertion sort: std::sort is not constexpr in C++17.
+        for (size_t i = 0; i < cSize; i++) {
+            auto index = static_cast<uint16_t>(i);
+            auto j     = i;
+
+            for (; j > 0 && mNames[index] < mNames[mSorted[j - 1]]; j--) {
+                mSorted[j] = mSorted[j - 1];
+            }
+
+            mSorted[j] = index;
+        }
+    }
+
+    constexpr std::optional<Enum> FindSorted(std::string_view name) const
+    {
+        size_t begin = 0, end = cSize;
+
+        while (begin < end) {
+            auto middle = begin + (end - begin) / 2;
+            auto index  = mSorted[middle];
+
+            if (mNames[index] == name) {
+                return static_cast<Enum>(index);
+            }
+
+            if (mNames[index] < name) {
+                begin = middle + 1;
+            } else {
+                end = middle;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    static_assert(cSize > 0 && cSize < UINT16_MAX, "unsupported enum size");
+
+    std::array<std::string_view, cSize> mNames {};
+    std::array<uint16_t, cSlotCount>    mSlots {};
+    std::array<uint16_t, cSize>         mSorted {};
+    uint32_t                            mSeed        = 0;
+    bool                                mPerfectHash = false;
+    bool                                mValid       = false;
+};
+
+/**
+ * Compile time enum -> enum mapping, e.g. aos enum to protobuf enum.
+ *
+ * Source enum values should be dense: 0..cNumValues-1, where cNumValues is the source enum's own count value, e.g.
+ * eNumValues. Tables should be declared constexpr and checked with static_assert(map.IsValid()): the check fails if
+ * any source value is missing, duplicated or out of range. Maps used in both directions, e.g. to convert received
+ * protobuf values back, should also be checked with static_assert(map.IsReversible()).
+ */
+template <typename From, typename To, From cNumValues = From::eNumValues>
+class EnumMap {
+public:
+    using Entry = std::pair<From, To>;
+
+    /**
+     * Creates enum map.
+     *
+     * @param entries enum mapping.
+     */
+    template <size_t M>
+    constexpr explicit EnumMap(const std::array<Entry, M>& entries)
+    {
+        std::array<bool, cSize> present {};
+
+        if (M != cSize) {
+            return;
+        }
+
+        for (const auto& [from, to] : entries) {
+            auto index = static_cast<size_t>(from);
+
+            if (index >= cSize || present[index]) {
+                return;
+            }
+
+            present[index] = true;
+            mValues[index] = to;
+        }
+
+        mValid      = true;
+        mReversible = true;
+
+        for (size_t i = 0; i < cSize && mReversible; i++) {
+            for (size_t j = 0; j < i; j++) {
+                if (mValues[i] == mValues[j]) {
+                    mReversible = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    /**
+     * Returns true if mapping is complete.
+     *
+     * @return bool.
+     */
+    constexpr bool IsValid() const { return mValid; }
+
+    /**
+     * Returns true if mapping is valid and mapped values are unique, so each of them converts back to one source value.
+     *
+     * @return bool.
+     */
+    constexpr bool IsReversible() const { return mReversible; }
+
+    /**
+     * Converts enum value.
+     *
+     * @param value source value.
+     * @return std::optional<To> nullopt for out of range value.
+     */
+    constexpr std::optional<To> Convert(From value) const
+    {
+        auto index = static_cast<size_t>(value);
+
+        if (index >= cSize) {
+            return std::nullopt;
+        }
+
+        return mValues[index];
+    }
+
+    /**
+     * Converts mapped value back to source value.
+     *
+     * Linear search: mapped enums are small.
+     *
+     * @param value mapped value.
+     * @return std::optional<From> nullopt for value which is not mapped, e.g. protobuf unknown value.
+     */
+    constexpr std::optional<From> ConvertBack(To value) const
+    {
+        for (size_t i = 0; i < cSize; i++) {
+            if (mValues[i] == value) {
+                return static_cast<From>(i);
+            }
+        }
+
+        return std::nullopt;
+    }
+
+private:
+    static constexpr size_t cSize = static_cast<size_t>(cNumValues);
+
+    std::array<To, cSize> mValues {};
+    bool                  mValid      = false;
+    bool                  mReversible = false;
+};
+
+} // namespace aos::common::utils
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <system_error>
+
+#include "exception.hpp"
+
+namespace aos::common::utils {
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+AosException::AosException(std::string message, int err)
+    : mMessage(std::move(message))
+    , mError(err)
+    // Skip constructor frame: trace starts at throw site.
+    , mStackTrace(StackTrace::Capture(1))
+{
+}
+
+const char* AosException::what() const noexcept
+{
+    if (!mFormatted.empty()) {
+        return mFormatted.c_str();
+    }
+
+    try {
+        mFormatted = mMessage;
+
+        if (mError != 0) {
+            mFormatted.append(": ").append(strerror(mError));
+        }
+
+        if (mStackTrace.Size() != 0) {
+            mFormatted.append("\n").append(mStackTrace.ToString());
+        }
+    } catch (...) {
+        mFormatted.clear();
+
+        return mMessage.c_str();
+    }
+
+    return mFormatted.c_str();
+}
+
+int GetExceptionError(const std::exception_ptr& exception)
+{
+    try {
+        std::rethrow_exception(exception);
+    } catch (const AosException& e) {
+        return e.GetError() != 0 ? e.GetError() : EFAULT;
+    } catch (const std::system_error& e) {
+        return e.code().value();
+    } catch (const std::bad_alloc&) {
+        return ENOMEM;
+    } catch (...) {
+        return EFAULT;
+    }
+}
+
+} // namespace aos::common::utils
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef EXCEPTION_HPP_
+#define EXCEPTION_HPP_
+
+#include <exception>
+#include <string>
+
+#include "stacktrace.hpp"
+
+namespace aos::common::utils {
+
+/**
+ * Aos exception.
+ *
+ * Captures raw stack trace on construction; symbols are resolved and full message is formatted on first what() call
+ * only, so throwing stays cheap for exceptions used for control flow.
+ *
+ * what() is not thread safe for the same instance.
+ */
+class AosException : public std::exception {
+public:
+    /**
+     * Creates Aos exception.
+     *
+     * @param message error message.
+     * @param err errno value.
+     */
+    explicit AosException(std::string message, int err = 0);
+
+    /**
+     * Returns message with error and stack trace.
+     *
+     * @return const char*.
+     */
+    const char* what() const noexcept override;
+
+    /**
+     * Returns message without stack trace.
+     *
+     * @return const std::string&.
+     */
+    const std::string& GetMessage() const { return mMessage; }
+
+    /**
+     * Returns errno value.
+     *
+     * @return int.
+     */
+    int GetError() const { return mError; }
+
+    /**
+     * Returns stack trace captured at throw site.
+     *
+     * @return const StackTrace&.
+     */
+    const StackTrace& GetStackTrace() const { return mStackTrace; }
+
+private:
+    std::string         mMessage;
+    int                 mError;
+    StackTrace          mStackTrace;
+    mutable std::string mFormatted;
+};
+
+/**
+ * Converts exception to errno value: AosException error, system_error code, ENOMEM for bad_alloc, EFAULT otherwise.
+ *
+ * @param exception exception.
+ * @return int.
+ */
+int GetExceptionError(const std::exception_ptr& exception);
+
+} // namespace aos::common::utils
+
+#endif
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "atomicfile.hpp"
+#include "filewritecache.hpp"
+
+namespace aos::common::utils {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Consts
+ **********************************************************************************************************************/
+
+constexpr uint64_t cFNVOffset   = 14695981039346656037ULL;
+constexpr uint64_t cFNVPrime    = 1099511628211ULL;
+constexpr mode_t   cDefaultMode = 0644;
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+int64_t GetMTime(const struct stat& st)
+{
+    return static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+}
+
+bool IsSameFile(uint64_t size, uint64_t ino, int64_t mtime, const struct stat& st)
+{
+    return static_cast<uint64_t>(st.st_size) == size && static_cast<uint64_t>(st.st_ino) == ino
+        && GetMTime(st) == mtime;
+}
+
+int ReadFile(const std::string& path, std::string& content, struct stat& st)
+{
+    auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return errno;
+    }
+
+    auto err = 0;
+
+    if (fstat(fd, &st) != 0) {
+        err = errno;
+    } else {
+        content.resize(static_cast<size_t>(st.st_size));
+
+        for (size_t offset = 0; offset < content.size();) {
+            auto n = read(fd, content.data() + offset, content.size() - offset);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+
+            if (n <= 0) {
+                err = n < 0 ? errno : EIO;
+                break;
+            }
+
+            offset += static_cast<size_t>(n);
+        }
+    }
+
+    close(fd);
+
+    return err;
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+uint64_t CalculateContentHash(std::string_view data)
+{
+    auto hash = cFNVOffset;
+
+    for (auto chr : data) {
+        hash ^= static_cast<unsigned char>(chr);
+        hash *= cFNVPrime;
+    }
+
+    return hash;
+}
+
+int FileWriteCache::WriteIfChanged(const std::string& path, std::string_view content, bool& written)
+{
+    written = false;
+
+    auto  hash  = CalculateContentHash(content);
+    auto& entry = AcquireEntry(path);
+    auto  err   = 0;
+
+    {
+        std::lock_guard writeLock {entry.mWriteMutex};
+
+        FileState   state;
+        bool        cached = false;
+        bool        skip   = false;
+        struct stat st {};
+
+        {
+            std::lock_guard lock {mMutex};
+
+            cached = entry.mCached;
+            state  = entry.mState;
+        }
+
+        auto exists = stat(path.c_str(), &st) == 0;
+
+        // File is unchanged on disk since last write or compare: cached hash tells if content differs, no need to read
+        // the file. Otherwise it is compared byte by byte.
+        if (exists && cached && IsSameFile(state.mSize, state.mIno, state.mMTime, st)) {
+            skip = state.mHash == hash && state.mSize == content.size();
+        } else if (std::string existing; exists && ReadFile(path, existing, st) == 0 && existing == content) {
+            skip = true;
+        }
+
+        if (!skip) {
+            err = WriteFileAtomically(path, content, exists ? st.st_mode & 07777 : cDefaultMode, &st);
+        }
+
+        std::lock_guard lock {mMutex};
+
+        entry.mCached = err == 0;
+
+        if (err == 0) {
+            entry.mState = FileState {hash, content.size(), static_cast<uint64_t>(st.st_ino), GetMTime(st)};
+
+            if (skip) {
+                mStats.mSkipped++;
+                mStats.mSkippedBytes += content.size();
+            } else {
+                mStats.mWrites++;
+                mStats.mWrittenBytes += content.size();
+            }
+        }
+
+        written = err == 0 && !skip;
+    }
+
+    ReleaseEntry(path);
+
+    return err;
+}
+
+void FileWriteCache::Invalidate(const std::string& path)
+{
+    std::lock_guard lock {mMutex};
+
+    auto it = mFiles.find(path);
+    if (it == mFiles.end()) {
+        return;
+    }
+
+    if (it->second.mWriters == 0) {
+        mFiles.erase(it);
+    } else {
+        it->second.mCached = false;
+    }
+}
+
+FileWriteStats FileWriteCache::GetStats() const
+{
+    std::lock_guard lock {mMutex};
+
+    return mStats;
+}
+
+/***********************************************************************************************************************
+ * Private
+ **********************************************************************************************************************/
+
+FileWriteCache::FileEntry& FileWriteCache::AcquireEntry(const std::string& path)
+{
+    std::lock_guard lock {mMutex};
+
+    // Node based map: entry address is stable while the entry is used.
+    auto& entry = mFiles[path];
+
+    entry.mWriters++;
+
+    return entry;
+}
+
+void FileWriteCache::ReleaseEntry(const std::string& path)
+{
+    std::lock_guard lock {mMutex};
+
+    auto it = mFiles.find(path);
+
+    if (--it->second.mWriters == 0 && !it->second.mCached) {
+        mFiles.erase(it);
+    }
+}
+
+} // namespace aos::common::utils
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef FILEWRITECACHE_HPP_
+#define FILEWRITECACHE_HPP_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace aos::common::utils {
+
+/**
+ * File write cache statistics.
+ */
+struct FileWriteStats {
+    uint64_t mWrites       = 0;
+    uint64_t mWrittenBytes = 0;
+    uint64_t mSkipped      = 0;
+    uint64_t mSkippedBytes = 0;
+};
+
+/**
+ * Skips writing files which content is unchanged.
+ *
+ * Content hash, size, inode and modification time are cached per path after each write or compare. While the file is
+ * unchanged on disk, the cached hash decides whether content differs and the file is not read. Unknown files (e.g.
+ * after restart) and files changed on disk are compared with existing content byte by byte once. Changed content is
+ * written atomically by WriteFileAtomically and keeps the mode of the replaced file; new files get mode 0644.
+ *
+ * Cached files are compared by 64-bit FNV-1a hash and size only: a collision (probability 2^-64 per changed write)
+ * skips the write. It is accepted as the cache is used for generated runtime files which are rewritten on the next
+ * change anyway. External modification which keeps size, inode and modification time is not detected either.
+ *
+ * Writes of different paths run concurrently, writes of the same path are serialized, so the cached state always
+ * matches the last renamed file. Methods return 0 on success or errno value on failure.
+ */
+class FileWriteCache {
+public:
+    /**
+     * Writes file if its content differs from the given one.
+     *
+     * @param path file path.
+     * @param content file content.
+     * @param[out] written true if file was written.
+     * @return int.
+     */
+    int WriteIfChanged(const std::string& path, std::string_view content, bool& written);
+
+    /**
+     * Drops cached state of the file, e.g. after removing it.
+     *
+     * @param path file path.
+     */
+    void Invalidate(const std::string& path);
+
+    /**
+     * Returns statistics.
+     *
+     * @return FileWriteStats.
+     */
+    FileWriteStats GetStats() const;
+
+private:
+    struct FileState {
+        uint64_t mHash  = 0;
+        uint64_t mSize  = 0;
+        uint64_t mIno   = 0;
+        int64_t  mMTime = 0;
+    };
+
+    struct FileEntry {
+        // Serializes writers of the path, held without mMutex.
+        std::mutex mWriteMutex;
+        size_t     mWriters = 0;
+        bool       mCached  = false;
+        FileState  mState;
+    };
+
+    FileEntry& AcquireEntry(const std::string& path);
+    void       ReleaseEntry(const std::string& path);
+
+    mutable std::mutex                         mMutex;
+    std::unordered_map<std::string, FileEntry> mFiles;
+    FileWriteStats                             mStats;
+};
+
+/**
+ * Calculates 64-bit FNV-1a hash.
+ *
+ * @param data data.
+ * @return uint64_t.
+ */
+uint64_t CalculateContentHash(std::string_view data);
+
+} // namespace aos::common::utils
+
+#endif
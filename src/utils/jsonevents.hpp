@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef JSONEVENTS_HPP_
+#define JSONEVENTS_HPP_
+
+#include <string_view>
+
+namespace aos::common::utils {
+
+/**
+ * JSON scalar type.
+ */
+enum class JSONScalarType { eString, eNumber, eTrue, eFalse, eNull };
+
+/**
+ * Streaming JSON event handler.
+ *
+ * Each handler returns false to stop parsing, e.g. when all required data is found.
+ */
+class JSONEventHandler {
+public:
+    /**
+     * Destroys JSON event handler.
+     */
+    virtual ~JSONEventHandler() = default;
+
+    /**
+     * Called on object begin.
+     *
+     * @return bool.
+     */
+    virtual bool OnObjectBegin() = 0;
+
+    /**
+     * Called on object end.
+     *
+     * @return bool.
+     */
+    virtual bool OnObjectEnd() = 0;
+
+    /**
+     * Called on array begin.
+     *
+     * @return bool.
+     */
+    virtual bool OnArrayBegin() = 0;
+
+    /**
+     * Called on array end.
+     *
+     * @return bool.
+     */
+    virtual bool OnArrayEnd() = 0;
+
+    /**
+     * Called on object key.
+     *
+     * @param key unescaped key, valid during the call only.
+     * @return bool.
+     */
+    virtual bool OnKey(std::string_view key) = 0;
+
+    /**
+     * Called on scalar value.
+     *
+     * @param type value type.
+     * @param value unescaped string or number text, valid during the call only.
+     * @return bool.
+     */
+    virtual bool OnScalar(JSONScalarType type, std::string_view value) = 0;
+};
+
+} // namespace aos::common::utils
+
+#endif
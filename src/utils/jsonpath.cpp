@@ -0,0 +1,325 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+
+#include "jsonpath.hpp"
+#include "jsontemplate.hpp"
+
+namespace aos::common::utils {
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+int JSONPathQuery::Compile(const std::vector<std::string>& paths)
+{
+    mQueries.clear();
+
+    for (const auto& path : paths) {
+        Query            query;
+        std::string_view rest(path);
+
+        if (!path.empty() && path.back() == '.') {
+            return EINVAL;
+        }
+
+        while (!rest.empty()) {
+            auto segment = rest.substr(0, rest.find('.'));
+            if (segment.empty()) {
+                return EINVAL;
+            }
+
+            rest.remove_prefix(std::min(segment.size() + 1, rest.size()));
+
+            auto key = segment.substr(0, segment.find('['));
+
+            if (!key.empty()) {
+                query.mSteps.push_back(Step {std::string(key)});
+            }
+
+            segment.remove_prefix(key.size());
+
+            // Array subscripts: "[<index>]" or "[*]".
+            while (!segment.empty()) {
+                auto end = segment.find(']');
+
+                if (segment.front() != '[' || end == std::string_view::npos || end == 1) {
+                    return EINVAL;
+                }
+
+                auto subscript = std::string(segment.substr(1, end - 1));
+                Step step {{}, 0, true};
+
+                if (subscript == "*") {
+                    step.mIndex = cAnyIndex;
+                } else {
+                    char* endPtr = nullptr;
+
+                    step.mIndex = strtoull(subscript.c_str(), &endPtr, 10);
+
+                    if (*endPtr != '\0' || subscript.front() == '-') {
+                        return EINVAL;
+                    }
+                }
+
+                query.mSteps.push_back(step);
+                segment.remove_prefix(end + 1);
+            }
+        }
+
+        for (size_t i = 0; i < query.mSteps.size(); i++) {
+            if (query.mSteps[i].mIsIndex && query.mSteps[i].mIndex == cAnyIndex) {
+                query.mWildcardStep = i;
+                break;
+            }
+        }
+
+        mQueries.push_back(std::move(query));
+    }
+
+    Reset();
+
+    return 0;
+}
+
+void JSONPathQuery::Reset()
+{
+    mFrames.clear();
+    mCaptures.clear();
+
+    for (auto& query : mQueries) {
+        query.mComplete = false;
+        query.mMatches.clear();
+    }
+
+    mPendingCount = mQueries.size();
+}
+
+bool JSONPathQuery::OnObjectBegin()
+{
+    return BeginValue(ValueKind::eObject, "{");
+}
+
+bool JSONPathQuery::OnObjectEnd()
+{
+    return EndContainer(false);
+}
+
+bool JSONPathQuery::OnArrayBegin()
+{
+    return BeginValue(ValueKind::eArray, "[");
+}
+
+bool JSONPathQuery::OnArrayEnd()
+{
+    return EndContainer(true);
+}
+
+bool JSONPathQuery::OnKey(std::string_view key)
+{
+    if (!mFrames.empty()) {
+        mFrames.back().mKey = key;
+    }
+
+    if (mCaptures.empty()) {
+        return true;
+    }
+
+    std::string token;
+
+    AppendJSONString(token, key);
+    token += ':';
+
+    for (auto& capture : mCaptures) {
+        auto& level = capture.mLevels.back();
+
+        if (!level.mFirst) {
+            capture.mBuffer += ',';
+        }
+
+        level.mFirst = false;
+        capture.mBuffer += token;
+    }
+
+    return true;
+}
+
+bool JSONPathQuery::OnScalar(JSONScalarType type, std::string_view value)
+{
+    switch (type) {
+    case JSONScalarType::eString:
+        // Escaped only if captured.
+        return BeginValue(ValueKind::eString, value);
+
+    case JSONScalarType::eTrue:
+        return BeginValue(ValueKind::eScalar, "true");
+
+    case JSONScalarType::eFalse:
+        return BeginValue(ValueKind::eScalar, "false");
+
+    case JSONScalarType::eNull:
+        return BeginValue(ValueKind::eScalar, "null");
+
+    default:
+        return BeginValue(ValueKind::eScalar, value);
+    }
+}
+
+/***********************************************************************************************************************
+ * Private
+ **********************************************************************************************************************/
+
+bool JSONPathQuery::StepMatches(const Step& step, const Frame& parent)
+{
+    if (parent.mIsArray) {
+        return step.mIsIndex && (step.mIndex == cAnyIndex || step.mIndex == parent.mIndex);
+    }
+
+    return !step.mIsIndex && step.mKey == parent.mKey;
+}
+
+void JSONPathQuery::WriteValue(Capture& capture, ValueKind kind, std::string_view token)
+{
+    if (!capture.mLevels.empty()) {
+        auto& level = capture.mLevels.back();
+
+        // Object values are separated together with their keys.
+        if (level.mIsArray && !level.mFirst) {
+            capture.mBuffer += ',';
+        }
+
+        level.mFirst = false;
+    }
+
+    if (kind == ValueKind::eString) {
+        AppendJSONString(capture.mBuffer, token);
+    } else {
+        capture.mBuffer += token;
+    }
+
+    if (IsContainer(kind)) {
+        capture.mLevels.push_back({kind == ValueKind::eArray, true});
+    }
+}
+
+bool JSONPathQuery::BeginValue(ValueKind kind, std::string_view token)
+{
+    for (auto& capture : mCaptures) {
+        WriteValue(capture, kind, token);
+    }
+
+    auto    parent = mFrames.empty() ? nullptr : &mFrames.back();
+    auto    depth  = mFrames.empty() ? 0 : mFrames.size() - 1;
+    Frame   child;
+    Capture capture;
+
+    child.mIsArray = kind == ValueKind::eArray;
+
+    auto checkQuery = [&](size_t index, size_t matchedSteps) {
+        auto& query = mQueries[index];
+
+        if (query.mSteps.size() == matchedSteps) {
+            capture.mQueries.push_back(index);
+        } else if (IsContainer(kind)) {
+            child.mAlive.push_back(index);
+        }
+    };
+
+    if (parent == nullptr) {
+        for (size_t i = 0; i < mQueries.size(); i++) {
+            if (!mQueries[i].mComplete) {
+                checkQuery(i, 0);
+            }
+        }
+    } else {
+        for (auto index : parent->mAlive) {
+            if (!mQueries[index].mComplete && StepMatches(mQueries[index].mSteps[depth], *parent)) {
+                checkQuery(index, depth + 1);
+            }
+        }
+
+        if (parent->mIsArray) {
+            parent->mIndex++;
+        }
+    }
+
+    if (IsContainer(kind)) {
+        mFrames.push_back(std::move(child));
+    }
+
+    if (capture.mQueries.empty()) {
+        return true;
+    }
+
+    WriteValue(capture, kind, token);
+
+    if (IsContainer(kind)) {
+        mCaptures.push_back(std::move(capture));
+
+        return true;
+    }
+
+    FinishCapture(capture);
+
+    return !IsComplete();
+}
+
+bool JSONPathQuery::EndContainer(bool isArray)
+{
+    for (auto it = mCaptures.begin(); it != mCaptures.end();) {
+        it->mBuffer += isArray ? ']' : '}';
+        it->mLevels.pop_back();
+
+        if (!it->mLevels.empty()) {
+            it++;
+
+            continue;
+        }
+
+        FinishCapture(*it);
+        it = mCaptures.erase(it);
+    }
+
+    if (!mFrames.empty()) {
+        auto depth = mFrames.size() - 1;
+
+        // Array holding the first wildcard is closed: no more matches possible for the query.
+        for (auto index : mFrames.back().mAlive) {
+            if (mQueries[index].mWildcardStep == depth) {
+                CompleteQuery(index);
+            }
+        }
+
+        mFrames.pop_back();
+    }
+
+    return !IsComplete();
+}
+
+void JSONPathQuery::FinishCapture(Capture& capture)
+{
+    for (auto index : capture.mQueries) {
+        mQueries[index].mMatches.push_back(capture.mBuffer);
+
+        if (mQueries[index].mWildcardStep == SIZE_MAX) {
+            CompleteQuery(index);
+        }
+    }
+}
+
+void JSONPathQuery::CompleteQuery(size_t index)
+{
+    if (!mQueries[index].mComplete) {
+        mQueries[index].mComplete = true;
+        mPendingCount--;
+    }
+}
+
+} // namespace aos::common::utils
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef JSONPATH_HPP_
+#define JSONPATH_HPP_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "jsonevents.hpp"
+
+namespace aos::common::utils {
+
+/**
+ * Compiled set of JSON path queries extracted in a single streaming pass.
+ *
+ * Path syntax: dot separated object keys with optional array subscripts: "config.Env", "rootfs.diff_ids[0]",
+ * "layers[*].digest". Empty path selects the document root. Each match is returned as serialized JSON.
+ *
+ * Only queries which prefix matches the current position are checked on each event. Once every query is complete the
+ * handler stops the parser: queries without wildcard complete on first match, wildcard queries complete when the
+ * array of their first wildcard is closed.
+ */
+class JSONPathQuery : public JSONEventHandler {
+public:
+    /**
+     * Compiles queries.
+     *
+     * @param paths JSON paths.
+     * @return int 0 on success or EINVAL on malformed path.
+     */
+    int Compile(const std::vector<std::string>& paths);
+
+    /**
+     * Resets match state before parsing next document.
+     */
+    void Reset();
+
+    /**
+     * Returns serialized matches of query.
+     *
+     * @param index query index.
+     * @return const std::vector<std::string>&.
+     */
+    const std::vector<std::string>& GetMatches(size_t index) const { return mQueries[index].mMatches; }
+
+    /**
+     * Returns true if all queries are complete.
+     *
+     * @return bool.
+     */
+    bool IsComplete() const { return mPendingCount == 0; }
+
+    bool OnObjectBegin() override;
+    bool OnObjectEnd() override;
+    bool OnArrayBegin() override;
+    bool OnArrayEnd() override;
+    bool OnKey(std::string_view key) override;
+    bool OnScalar(JSONScalarType type, std::string_view value) override;
+
+private:
+    static constexpr size_t cAnyIndex = SIZE_MAX;
+
+    // String token is the unescaped value.
+    enum class ValueKind { eScalar, eString, eObject, eArray };
+
+    struct Step {
+        std::string mKey;
+        size_t      mIndex   = 0;
+        bool        mIsIndex = false;
+    };
+
+    struct Query {
+        std::vector<Step>        mSteps;
+        size_t                   mWildcardStep = SIZE_MAX;
+        bool                     mComplete     = false;
+        std::vector<std::string> mMatches;
+    };
+
+    struct Frame {
+        bool        mIsArray = false;
+        size_t      mIndex = 0;
+        std::string mKey;
+        // Queries which prefix matches path of this container.
+        std::vector<size_t> mAlive;
+    };
+
+    struct CaptureLevel {
+        bool mIsArray;
+        bool mFirst;
+    };
+
+    struct Capture {
+        std::string               mBuffer;
+        std::vector<size_t>       mQueries;
+        std::vector<CaptureLevel> mLevels;
+    };
+
+    static bool IsContainer(ValueKind kind) { return kind == ValueKind::eObject || kind == ValueKind::eArray; }
+    static bool StepMatches(const Step& step, const Frame& parent);
+    static void WriteValue(Capture& capture, ValueKind kind, std::string_view token);
+
+    bool BeginValue(ValueKind kind, std::string_view token);
+    bool EndContainer(bool isArray);
+    void FinishCapture(Capture& capture);
+    void CompleteQuery(size_t index);
+
+    std::vector<Query>   mQueries;
+    std::vector<Frame>   mFrames;
+    std::vector<Capture> mCaptures;
+    size_t               mPendingCount = 0;
+};
+
+} // namespace aos::common::utils
+
+#endif
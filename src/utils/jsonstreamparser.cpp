@@ -0,0 +1,604 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "jsonstreamparser.hpp"
+
+namespace aos::common::utils {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+bool IsSpace(char chr)
+{
+    return chr == ' ' || chr == '\n' || chr == '\r' || chr == '\t';
+}
+
+bool IsNumberChar(char chr)
+{
+    return (chr >= '0' && chr <= '9') || chr == '-' || chr == '+' || chr == '.' || chr == 'e' || chr == 'E';
+}
+
+bool IsDigit(char chr)
+{
+    return chr >= '0' && chr <= '9';
+}
+
+int HexDigit(char chr)
+{
+    if (chr >= '0' && chr <= '9') {
+        return chr - '0';
+    }
+
+    if (chr >= 'a' && chr <= 'f') {
+        return chr - 'a' + 10;
+    }
+
+    if (chr >= 'A' && chr <= 'F') {
+        return chr - 'A' + 10;
+    }
+
+    return -1;
+}
+
+// -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+bool IsValidNumber(std::string_view number)
+{
+    size_t pos = 0;
+
+    auto skipDigits = [&]() {
+        auto start = pos;
+
+        while (pos < number.size() && IsDigit(number[pos])) {
+            pos++;
+        }
+
+        return pos - start;
+    };
+
+    if (pos < number.size() && number[pos] == '-') {
+        pos++;
+    }
+
+    if (pos < number.size() && number[pos] == '0') {
+        pos++;
+    } else if (skipDigits() == 0) {
+        return false;
+    }
+
+    if (pos < number.size() && number[pos] == '.') {
+        pos++;
+
+        if (skipDigits() == 0) {
+            return false;
+        }
+    }
+
+    if (pos < number.size() && (number[pos] == 'e' || number[pos] == 'E')) {
+        pos++;
+
+        if (pos < number.size() && (number[pos] == '+' || number[pos] == '-')) {
+            pos++;
+        }
+
+        if (skipDigits() == 0) {
+            return false;
+        }
+    }
+
+    return pos == number.size();
+}
+
+void AppendUTF8(std::string& out, uint32_t codePoint)
+{
+    if (codePoint < 0x80) {
+        out += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        out += static_cast<char>(0xC0 | (codePoint >> 6));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        out += static_cast<char>(0xE0 | (codePoint >> 12));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (codePoint >> 18));
+        out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+JSONStreamParser::JSONStreamParser(JSONEventHandler& handler, size_t maxDepth)
+    : mHandler(handler)
+    , mMaxDepth(maxDepth)
+{
+}
+
+int JSONStreamParser::Feed(std::string_view chunk)
+{
+    size_t pos = 0;
+
+    while (pos < chunk.size() && mState != State::eStopped && mState != State::eError) {
+        switch (mState) {
+        case State::eString:
+            pos = ParseString(chunk, pos);
+            break;
+
+        case State::eNumber:
+            pos = ParseNumber(chunk, pos);
+            break;
+
+        case State::eLiteral:
+            pos = ParseLiteral(chunk, pos);
+            break;
+
+        default:
+            pos = ParseStructural(chunk, pos);
+            break;
+        }
+    }
+
+    mOffset += pos;
+
+    return mState == State::eError ? mError : 0;
+}
+
+int JSONStreamParser::Finish()
+{
+    // Root number has no terminator.
+    if (mState == State::eNumber && mStack.empty()) {
+        EmitNumber();
+    }
+
+    if (mState == State::eError) {
+        return mError;
+    }
+
+    if (mState != State::eDone && mState != State::eStopped) {
+        SetError(EINVAL);
+
+        return mError;
+    }
+
+    return 0;
+}
+
+void JSONStreamParser::Reset()
+{
+    mState  = State::eValue;
+    mError  = 0;
+    mOffset = 0;
+
+    mStack.clear();
+    mToken.clear();
+
+    mIsKey         = false;
+    mEscape        = 0;
+    mCodeUnit      = 0;
+    mHighSurrogate = 0;
+    mLiteral       = {};
+    mLiteralPos    = 0;
+}
+
+int ParseJSONFile(const std::string& path, JSONEventHandler& handler, size_t chunkSize)
+{
+    auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return errno;
+    }
+
+    JSONStreamParser  parser(handler);
+    std::vector<char> buffer(chunkSize);
+    auto              err = 0;
+
+    while (err == 0 && !parser.IsStopped()) {
+        auto n = read(fd, buffer.data(), buffer.size());
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (n < 0) {
+            err = errno;
+            break;
+        }
+
+        if (n == 0) {
+            err = parser.Finish();
+            break;
+        }
+
+        err = parser.Feed(std::string_view(buffer.data(), static_cast<size_t>(n)));
+    }
+
+    close(fd);
+
+    return err;
+}
+
+/***********************************************************************************************************************
+ * Private
+ **********************************************************************************************************************/
+
+size_t JSONStreamParser::ParseStructural(std::string_view chunk, size_t pos)
+{
+    while (pos < chunk.size() && IsSpace(chunk[pos])) {
+        pos++;
+    }
+
+    if (pos == chunk.size()) {
+        return pos;
+    }
+
+    auto chr = chunk[pos];
+
+    switch (mState) {
+    case State::eValueOrEnd:
+        if (chr == ']') {
+            EndContainer(chr);
+            break;
+        }
+
+        [[fallthrough]];
+
+    case State::eValue:
+        BeginValue(chr);
+        break;
+
+    case State::eKeyOrEnd:
+        if (chr == '}') {
+            EndContainer(chr);
+            break;
+        }
+
+        [[fallthrough]];
+
+    case State::eKey:
+        if (chr != '"') {
+            SetError(EINVAL);
+            break;
+        }
+
+        mIsKey = true;
+        mState = State::eString;
+        break;
+
+    case State::eColon:
+        if (chr != ':') {
+            SetError(EINVAL);
+            break;
+        }
+
+        mState = State::eValue;
+        break;
+
+    case State::eCommaOrEnd:
+        if (chr == ',') {
+            mState = mStack.back() == '{' ? State::eKey : State::eValue;
+            break;
+        }
+
+        EndContainer(chr);
+        break;
+
+    default:
+        SetError(EINVAL);
+        break;
+    }
+
+    return mState == State::eError ? pos : pos + 1;
+}
+
+size_t JSONStreamParser::ParseString(std::string_view chunk, size_t pos)
+{
+    while (pos < chunk.size()) {
+        if (mEscape != 0) {
+            if (!ParseEscape(chunk[pos])) {
+                SetError(EINVAL);
+
+                return pos;
+            }
+
+            pos++;
+
+            continue;
+        }
+
+        // High surrogate should be followed by low surrogate escape.
+        if (mHighSurrogate != 0 && chunk[pos] != '\\') {
+            SetError(EINVAL);
+
+            return pos;
+        }
+
+        auto start = pos;
+
+        while (pos < chunk.size() && chunk[pos] != '"' && chunk[pos] != '\\'
+            && static_cast<unsigned char>(chunk[pos]) >= 0x20) {
+            pos++;
+        }
+
+        mToken.append(chunk.data() + start, pos - start);
+
+        if (pos == chunk.size()) {
+            break;
+        }
+
+        if (chunk[pos] == '\\') {
+            mEscape = 1;
+            pos++;
+
+            continue;
+        }
+
+        if (chunk[pos] != '"') {
+            SetError(EINVAL);
+
+            return pos;
+        }
+
+        if (mIsKey) {
+            mState = State::eColon;
+            Notify(mHandler.OnKey(mToken));
+        } else {
+            EndValue();
+            Notify(mHandler.OnScalar(JSONScalarType::eString, mToken));
+        }
+
+        mToken.clear();
+
+        return pos + 1;
+    }
+
+    return pos;
+}
+
+bool JSONStreamParser::ParseEscape(char chr)
+{
+    if (mEscape == 1) {
+        if (chr == 'u') {
+            mEscape   = 2;
+            mCodeUnit = 0;
+
+            return true;
+        }
+
+        if (mHighSurrogate != 0) {
+            return false;
+        }
+
+        switch (chr) {
+        case '"':
+        case '\\':
+        case '/':
+            mToken += chr;
+            break;
+
+        case 'b':
+            mToken += '\b';
+            break;
+
+        case 'f':
+            mToken += '\f';
+            break;
+
+        case 'n':
+            mToken += '\n';
+            break;
+
+        case 'r':
+            mToken += '\r';
+            break;
+
+        case 't':
+            mToken += '\t';
+            break;
+
+        default:
+            return false;
+        }
+
+        mEscape = 0;
+
+        return true;
+    }
+
+    auto digit = HexDigit(chr);
+    if (digit < 0) {
+        return false;
+    }
+
+    mCodeUnit = (mCodeUnit << 4) | static_cast<uint32_t>(digit);
+
+    if (++mEscape < 6) {
+        return true;
+    }
+
+    mEscape = 0;
+
+    auto isHigh = mCodeUnit >= 0xD800 && mCodeUnit <= 0xDBFF;
+    auto isLow  = mCodeUnit >= 0xDC00 && mCodeUnit <= 0xDFFF;
+
+    if (mHighSurrogate != 0) {
+        if (!isLow) {
+            return false;
+        }
+
+        AppendUTF8(mToken, 0x10000 + ((mHighSurrogate - 0xD800) << 10) + (mCodeUnit - 0xDC00));
+        mHighSurrogate = 0;
+
+        return true;
+    }
+
+    if (isLow) {
+        return false;
+    }
+
+    if (isHigh) {
+        mHighSurrogate = mCodeUnit;
+
+        return true;
+    }
+
+    AppendUTF8(mToken, mCodeUnit);
+
+    return true;
+}
+
+size_t JSONStreamParser::ParseNumber(std::string_view chunk, size_t pos)
+{
+    auto start = pos;
+
+    while (pos < chunk.size() && IsNumberChar(chunk[pos])) {
+        pos++;
+    }
+
+    mToken.append(chunk.data() + start, pos - start);
+
+    // Terminator is not consumed: it is parsed as structural character.
+    if (pos < chunk.size()) {
+        EmitNumber();
+    }
+
+    return pos;
+}
+
+size_t JSONStreamParser::ParseLiteral(std::string_view chunk, size_t pos)
+{
+    for (; pos < chunk.size() && mLiteralPos < mLiteral.size(); pos++, mLiteralPos++) {
+        if (chunk[pos] != mLiteral[mLiteralPos]) {
+            SetError(EINVAL);
+
+            return pos;
+        }
+    }
+
+    if (mLiteralPos == mLiteral.size()) {
+        auto type = mLiteral[0] == 't' ? JSONScalarType::eTrue
+            : mLiteral[0] == 'f'       ? JSONScalarType::eFalse
+                                       : JSONScalarType::eNull;
+
+        EndValue();
+        Notify(mHandler.OnScalar(type, mLiteral));
+    }
+
+    return pos;
+}
+
+void JSONStreamParser::BeginValue(char chr)
+{
+    switch (chr) {
+    case '{':
+        BeginContainer(false);
+        break;
+
+    case '[':
+        BeginContainer(true);
+        break;
+
+    case '"':
+        mIsKey = false;
+        mState = State::eString;
+        break;
+
+    case 't':
+    case 'f':
+    case 'n':
+        mLiteral    = chr == 't' ? "true" : chr == 'f' ? "false" : "null";
+        mLiteralPos = 1;
+        mState      = State::eLiteral;
+        break;
+
+    default:
+        if (chr != '-' && !IsDigit(chr)) {
+            SetError(EINVAL);
+            break;
+        }
+
+        mToken = chr;
+        mState = State::eNumber;
+        break;
+    }
+}
+
+void JSONStreamParser::BeginContainer(bool isArray)
+{
+    if (mStack.size() >= mMaxDepth) {
+        SetError(E2BIG);
+
+        return;
+    }
+
+    mStack += isArray ? '[' : '{';
+    mState = isArray ? State::eValueOrEnd : State::eKeyOrEnd;
+
+    Notify(isArray ? mHandler.OnArrayBegin() : mHandler.OnObjectBegin());
+}
+
+void JSONStreamParser::EndContainer(char chr)
+{
+    auto isArray = mStack.back() == '[';
+
+    if (chr != (isArray ? ']' : '}')) {
+        SetError(EINVAL);
+
+        return;
+    }
+
+    mStack.pop_back();
+    EndValue();
+
+    Notify(isArray ? mHandler.OnArrayEnd() : mHandler.OnObjectEnd());
+}
+
+bool JSONStreamParser::EmitNumber()
+{
+    if (!IsValidNumber(mToken)) {
+        SetError(EINVAL);
+
+        return false;
+    }
+
+    EndValue();
+    Notify(mHandler.OnScalar(JSONScalarType::eNumber, mToken));
+    mToken.clear();
+
+    return true;
+}
+
+void JSONStreamParser::EndValue()
+{
+    mState = mStack.empty() ? State::eDone : State::eCommaOrEnd;
+}
+
+void JSONStreamParser::Notify(bool proceed)
+{
+    if (!proceed) {
+        mState = State::eStopped;
+    }
+}
+
+void JSONStreamParser::SetError(int err)
+{
+    mError = err;
+    mState = State::eError;
+}
+
+} // namespace aos::common::utils
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef JSONSTREAMPARSER_HPP_
+#define JSONSTREAMPARSER_HPP_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "jsonevents.hpp"
+
+namespace aos::common::utils {
+
+/**
+ * Resumable JSON parser.
+ *
+ * Accepts the document in arbitrary chunks as they arrive and reports it to the event handler. Parser state is kept
+ * across chunk boundaries, so memory usage is bounded by nesting depth and the longest string or number token instead
+ * of the document size. Parsing stops when the handler returns false.
+ *
+ * Methods return 0 on success, EINVAL on malformed document or E2BIG if nesting exceeds max depth.
+ */
+class JSONStreamParser {
+public:
+    /**
+     * Default max nesting depth.
+     */
+    static constexpr size_t cDefaultMaxDepth = 512;
+
+    /**
+     * Creates JSON stream parser.
+     *
+     * @param handler event handler.
+     * @param maxDepth max nesting depth.
+     */
+    explicit JSONStreamParser(JSONEventHandler& handler, size_t maxDepth = cDefaultMaxDepth);
+
+    /**
+     * Parses next chunk.
+     *
+     * @param chunk chunk data, not referenced after the call.
+     * @return int.
+     */
+    int Feed(std::string_view chunk);
+
+    /**
+     * Finishes parsing: checks that the document is complete.
+     *
+     * @return int.
+     */
+    int Finish();
+
+    /**
+     * Resets parser to parse next document.
+     */
+    void Reset();
+
+    /**
+     * Returns true if parsing is stopped by the handler.
+     *
+     * @return bool.
+     */
+    bool IsStopped() const { return mState == State::eStopped; }
+
+    /**
+     * Returns true if root value is parsed.
+     *
+     * @return bool.
+     */
+    bool IsDone() const { return mState == State::eDone; }
+
+    /**
+     * Returns number of consumed bytes. On error points to the offending byte.
+     *
+     * @return uint64_t.
+     */
+    uint64_t GetOffset() const { return mOffset; }
+
+private:
+    enum class State {
+        eValue,
+        eValueOrEnd,
+        eKey,
+        eKeyOrEnd,
+        eColon,
+        eCommaOrEnd,
+        eString,
+        eNumber,
+        eLiteral,
+        eDone,
+        eStopped,
+        eError,
+    };
+
+    size_t ParseStructural(std::string_view chunk, size_t pos);
+    size_t ParseString(std::string_view chunk, size_t pos);
+    bool   ParseEscape(char chr);
+    size_t ParseNumber(std::string_view chunk, size_t pos);
+    size_t ParseLiteral(std::string_view chunk, size_t pos);
+
+    void BeginValue(char chr);
+    void BeginContainer(bool isArray);
+    void EndContainer(char chr);
+    bool EmitNumber();
+    void EndValue();
+    void Notify(bool proceed);
+    void SetError(int err);
+
+    JSONEventHandler& mHandler;
+    size_t            mMaxDepth;
+    State             mState  = State::eValue;
+    int               mError  = 0;
+    uint64_t          mOffset = 0;
+    // Open containers: '{' or '['.
+    std::string mStack;
+    // Current string or number token.
+    std::string mToken;
+    bool        mIsKey = false;
+    // 0: no escape, 1: after backslash, 2..5: inside \u escape with (mEscape - 2) parsed hex digits.
+    int              mEscape        = 0;
+    uint32_t         mCodeUnit      = 0;
+    uint32_t         mHighSurrogate = 0;
+    std::string_view mLiteral;
+    size_t           mLiteralPos = 0;
+};
+
+/**
+ * Parses JSON file by chunks.
+ *
+ * @param path file path.
+ * @param handler event handler.
+ * @param chunkSize read chunk size.
+ * @return int 0 on success (including stop by handler) or errno value on failure.
+ */
+int ParseJSONFile(const std::string& path, JSONEventHandler& handler, size_t chunkSize = 64 * 1024);
+
+} // namespace aos::common::utils
+
+#endif
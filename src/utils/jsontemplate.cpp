@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+
+#include "jsontemplate.hpp"
+
+namespace aos::common::utils {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Consts
+ **********************************************************************************************************************/
+
+constexpr std::string_view cPlaceholderBegin = "\"@@";
+constexpr std::string_view cPlaceholderEnd   = "@@\"";
+constexpr std::string_view cStringPrefix     = "str:";
+constexpr std::string_view cRawPrefix        = "raw:";
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+size_t SkipString(std::string_view json, size_t pos)
+{
+    // Returns position of the closing quote of the string opened at pos.
+    for (pos++; pos < json.size(); pos++) {
+        if (json[pos] == '\\') {
+            pos++;
+        } else if (json[pos] == '"') {
+            break;
+        }
+    }
+
+    return pos;
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+void AppendJSONString(std::string& out, std::string_view value)
+{
+    static constexpr char cHex[] = "0123456789abcdef";
+
+    out += '"';
+
+    auto begin = value.data();
+    auto end   = begin + value.size();
+
+    for (auto chr = begin; chr != end; chr++) {
+        auto byte = static_cast<unsigned char>(*chr);
+
+        if (byte >= 0x20 && byte != '"' && byte != '\\') {
+            continue;
+        }
+
+        // Copy unescaped run at once.
+        out.append(begin, chr);
+        begin = chr + 1;
+
+        switch (byte) {
+        case '"':
+            out += "\\\"";
+            break;
+
+        case '\\':
+            out += "\\\\";
+            break;
+
+        case '\n':
+            out += "\\n";
+            break;
+
+        case '\r':
+            out += "\\r";
+            break;
+
+        case '\t':
+            out += "\\t";
+            break;
+
+        default:
+            out += "\\u00";
+            out += cHex[byte >> 4];
+            out += cHex[byte & 0xf];
+        }
+    }
+
+    out.append(begin, end);
+    out += '"';
+}
+
+int JSONTemplate::Compile(std::string skeleton)
+{
+    mSkeleton = std::move(skeleton);
+    mSegments.clear();
+    mSlots.clear();
+
+    if (auto err = Split(); err != 0) {
+        // Partially compiled template must not be rendered.
+        mSkeleton.clear();
+        mSegments.clear();
+        mSlots.clear();
+
+        return err;
+    }
+
+    return 0;
+}
+
+int JSONTemplate::GetSlot(std::string_view name) const
+{
+    for (size_t i = 0; i < mSlots.size(); i++) {
+        if (mSlots[i].mName == name) {
+            return static_cast<int>(i);
+        }
+    }
+
+    return -1;
+}
+
+void JSONTemplate::Render(const std::vector<std::string_view>& values, std::string& out) const
+{
+    auto size = mSkeleton.size();
+
+    for (const auto& value : values) {
+        size += value.size() + 2;
+    }
+
+    out.clear();
+    out.reserve(size);
+
+    for (const auto& segment : mSegments) {
+        out.append(mSkeleton, segment.mOffset, segment.mSize);
+
+        if (segment.mSlot < 0) {
+            continue;
+        }
+
+        auto value = static_cast<size_t>(segment.mSlot) < values.size() ? values[segment.mSlot] : std::string_view();
+
+        if (mSlots[segment.mSlot].mType == JSONSlotType::eString) {
+            AppendJSONString(out, value);
+        } else {
+            out.append(value.empty() ? std::string_view("null") : value);
+        }
+    }
+}
+
+/***********************************************************************************************************************
+ * Private
+ **********************************************************************************************************************/
+
+int JSONTemplate::Split()
+{
+    std::string_view skeletonView(mSkeleton);
+    size_t           offset = 0;
+
+    for (size_t pos = 0; pos < skeletonView.size(); pos++) {
+        if (skeletonView[pos] != '"') {
+            continue;
+        }
+
+        // Placeholder is a whole JSON string: "@@ inside other string, e.g. after escaped quote, is a literal.
+        if (skeletonView.compare(pos, cPlaceholderBegin.size(), cPlaceholderBegin) != 0) {
+            pos = SkipString(skeletonView, pos);
+
+            continue;
+        }
+
+        auto end = skeletonView.find(cPlaceholderEnd, pos + cPlaceholderBegin.size());
+        if (end == std::string_view::npos) {
+            return EINVAL;
+        }
+
+        auto placeholder = skeletonView.substr(pos + cPlaceholderBegin.size(), end - pos - cPlaceholderBegin.size());
+
+        if (placeholder.find_first_of("\\\"") != std::string_view::npos) {
+            return EINVAL;
+        }
+
+        JSONSlotType type;
+
+        if (placeholder.substr(0, cStringPrefix.size()) == cStringPrefix) {
+            type = JSONSlotType::eString;
+        } else if (placeholder.substr(0, cRawPrefix.size()) == cRawPrefix) {
+            type = JSONSlotType::eRaw;
+        } else {
+            return EINVAL;
+        }
+
+        auto name = placeholder.substr(cStringPrefix.size());
+        auto slot = GetSlot(name);
+
+        if (slot < 0) {
+            slot = static_cast<int>(mSlots.size());
+            mSlots.push_back({std::string(name), type});
+        } else if (mSlots[slot].mType != type) {
+            return EINVAL;
+        }
+
+        mSegments.push_back({offset, pos - offset, slot});
+        offset = end + cPlaceholderEnd.size();
+        pos    = offset - 1;
+    }
+
+    mSegments.push_back({offset, mSkeleton.size() - offset, -1});
+
+    return 0;
+}
+
+} // namespace aos::common::utils
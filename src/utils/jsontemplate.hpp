@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef JSONTEMPLATE_HPP_
+#define JSONTEMPLATE_HPP_
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aos::common::utils {
+
+/**
+ * JSON template slot type.
+ */
+enum class JSONSlotType {
+    // Value is escaped and quoted as JSON string.
+    eString,
+    // Value is already serialized JSON: number, array or object.
+    eRaw,
+};
+
+/**
+ * Precompiled JSON document with typed slots.
+ *
+ * Skeleton is a serialized JSON document where slot placeholders are JSON strings of "@@str:<name>@@" or
+ * "@@raw:<name>@@" form, e.g. serialized runtime spec with placeholders for instance ID, env, mounts and cgroup path.
+ * Compile splits skeleton into literal segments once; Render only splices slot values between them, so rendering cost
+ * doesn't depend on the document structure.
+ */
+class JSONTemplate {
+public:
+    /**
+     * Compiles template.
+     *
+     * @param skeleton serialized JSON skeleton with slot placeholders.
+     * @return int 0 on success or EINVAL on malformed placeholder or conflicting slot types, template is empty then.
+     */
+    int Compile(std::string skeleton);
+
+    /**
+     * Returns slot index by name.
+     *
+     * @param name slot name.
+     * @return int slot index or -1 if not found.
+     */
+    int GetSlot(std::string_view name) const;
+
+    /**
+     * Returns number of slots.
+     *
+     * @return size_t.
+     */
+    size_t GetSlotCount() const { return mSlots.size(); }
+
+    /**
+     * Renders document.
+     *
+     * @param values slot values indexed by slot index, missing values are rendered as empty string or null.
+     * @param[out] out rendered document.
+     */
+    void Render(const std::vector<std::string_view>& values, std::string& out) const;
+
+private:
+    struct Slot {
+        std::string  mName;
+        JSONSlotType mType;
+    };
+
+    struct Segment {
+        size_t mOffset;
+        size_t mSize;
+        // Slot rendered after the segment, -1 for the last segment.
+        int mSlot;
+    };
+
+    int Split();
+
+    std::string          mSkeleton;
+    std::vector<Segment> mSegments;
+    std::vector<Slot>    mSlots;
+};
+
+/**
+ * Appends string as escaped and quoted JSON string.
+ *
+ * @param out output.
+ * @param value value.
+ */
+void AppendJSONString(std::string& out, std::string_view value);
+
+} // namespace aos::common::utils
+
+#endif
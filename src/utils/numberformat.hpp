@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef NUMBERFORMAT_HPP_
+#define NUMBERFORMAT_HPP_
+
+#include <cerrno>
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace aos::common::utils {
+
+/**
+ * Max formatted number length: enough for any 64-bit integer and shortest round-trip double representation.
+ */
+constexpr size_t cMaxNumberLen = 32;
+
+/**
+ * Formats number into caller provided buffer without allocations.
+ *
+ * Integers are formatted as decimal, floating point values in shortest round-trip representation or with fixed
+ * precision if specified.
+ *
+ * @param begin buffer begin.
+ * @param end buffer end.
+ * @param value value.
+ * @param precision fixed precision for floating point values, negative for shortest representation.
+ * @return char* end of written data or nullptr if buffer is too small.
+ */
+template <typename T>
+char* FormatNumber(char* begin, char* end, T value, int precision = -1)
+{
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "arithmetic type expected");
+
+    std::to_chars_result result;
+
+    if constexpr (std::is_floating_point_v<T>) {
+        result = precision < 0 ? std::to_chars(begin, end, value)
+                               : std::to_chars(begin, end, value, std::chars_format::fixed, precision);
+    } else {
+        (void)precision;
+
+        result = std::to_chars(begin, end, value);
+    }
+
+    return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+/**
+ * Appends formatted number to string.
+ *
+ * @param str string.
+ * @param value value.
+ * @param precision fixed precision for floating point values, negative for shortest representation.
+ */
+template <typename T>
+void AppendNumber(std::string& str, T value, int precision = -1)
+{
+    auto size = str.size();
+
+    // Format in place: no allocation if string has enough capacity. Only huge fixed precision values need more than
+    // one iteration.
+    for (auto capacity = cMaxNumberLen;; capacity *= 2) {
+        str.resize(size + capacity);
+
+        if (auto end = FormatNumber(str.data() + size, str.data() + str.size(), value, precision); end) {
+            str.resize(static_cast<size_t>(end - str.data()));
+
+            return;
+        }
+    }
+}
+
+/**
+ * Formatted number kept on stack.
+ *
+ * Integers and shortest floating point representation always fit. Fixed precision value which does not fit, e.g. 1e300
+ * with any precision, is reported with EOVERFLOW error and empty view.
+ *
+ * Usage: out << NumberString(value).View().
+ */
+class NumberString {
+public:
+    /**
+     * Formats number.
+     *
+     * @param value value.
+     * @param precision fixed precision for floating point values, negative for shortest representation.
+     */
+    template <typename T>
+    explicit NumberString(T value, int precision = -1)
+    {
+        auto end = FormatNumber(mBuffer, mBuffer + sizeof(mBuffer), value, precision);
+
+        if (end == nullptr) {
+            mError = EOVERFLOW;
+
+            return;
+        }
+
+        mSize = static_cast<size_t>(end - mBuffer);
+    }
+
+    /**
+     * Returns formatting error.
+     *
+     * @return int 0 on success or EOVERFLOW if number does not fit into the buffer.
+     */
+    int GetError() const { return mError; }
+
+    /**
+     * Returns formatted number.
+     *
+     * @return std::string_view.
+     */
+    std::string_view View() const { return std::string_view(mBuffer, mSize); }
+
+private:
+    char   mBuffer[cMaxNumberLen];
+    size_t mSize  = 0;
+    int    mError = 0;
+};
+
+} // namespace aos::common::utils
+
+#endif
@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef OBJECTPOOL_HPP_
+#define OBJECTPOOL_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aos::common::utils {
+
+namespace detail {
+
+template <typename T, typename = void>
+struct HasClear : std::false_type { };
+
+template <typename T>
+struct HasClear<T, std::void_t<decltype(std::declval<T&>().Clear())>> : std::true_type { };
+
+template <typename T, typename = void>
+struct HasStdClear : std::false_type { };
+
+template <typename T>
+struct HasStdClear<T, std::void_t<decltype(std::declval<T&>().clear())>> : std::true_type { };
+
+} // namespace detail
+
+/**
+ * Default pool reset policy: calls Clear()/clear() if available, otherwise assigns a default value.
+ *
+ * Clear() keeps already allocated capacity, which is what makes recycling cheaper than construction.
+ */
+template <typename T>
+struct DefaultPoolReset {
+    void operator()(T& object) const
+    {
+        if constexpr (detail::HasClear<T>::value) {
+            object.Clear();
+        } else if constexpr (detail::HasStdClear<T>::value) {
+            object.clear();
+        } else {
+            object = T {};
+        }
+    }
+};
+
+/**
+ * Pool statistics.
+ */
+struct ObjectPoolStats {
+    size_t mCreated  = 0;
+    size_t mReused   = 0;
+    size_t mReleased = 0;
+    size_t mDropped  = 0;
+    size_t mIdle     = 0;
+};
+
+/**
+ * Thread-safe typed object pool.
+ *
+ * Acquired objects are returned as RAII handles which give the object back to the pool on destruction. Returned
+ * objects are kept up to the configured idle limit and reset with the reset policy; the rest are freed without reset.
+ * Reset runs without the pool lock, so the policy may be called concurrently from releasing threads; an object which
+ * reset throws for is freed. Handles may safely outlive the pool: in this case the object is simply destroyed.
+ */
+template <typename T, typename Reset = DefaultPoolReset<T>>
+class ObjectPool {
+    struct Storage;
+
+public:
+    /**
+     * Returns object to the pool on destruction.
+     */
+    class Deleter {
+    public:
+        Deleter() = default;
+
+        explicit Deleter(std::weak_ptr<Storage> storage)
+            : mStorage(std::move(storage))
+        {
+        }
+
+        void operator()(T* object) const
+        {
+            std::unique_ptr<T> holder(object);
+
+            if (auto storage = mStorage.lock()) {
+                storage->Release(std::move(holder));
+            }
+        }
+
+    private:
+        std::weak_ptr<Storage> mStorage;
+    };
+
+    using Handle = std::unique_ptr<T, Deleter>;
+
+    /**
+     * Creates object pool.
+     *
+     * @param maxIdle max number of idle objects kept for reuse.
+     * @param reset reset policy applied to released objects.
+     */
+    explicit ObjectPool(size_t maxIdle, Reset reset = Reset {})
+        : mStorage(std::make_shared<Storage>(maxIdle, std::move(reset)))
+    {
+    }
+
+    ObjectPool(const ObjectPool&)            = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /**
+     * Pre-creates idle objects.
+     *
+     * @param count number of objects to create, capped by max idle count.
+     */
+    void Reserve(size_t count)
+    {
+        std::lock_guard lock {mStorage->mMutex};
+
+        while (mStorage->mIdle.size() < count && mStorage->mIdle.size() + mStorage->mResetting < mStorage->mMaxIdle) {
+            mStorage->mIdle.push_back(std::make_unique<T>());
+            mStorage->mStats.mCreated++;
+        }
+    }
+
+    /**
+     * Acquires object from the pool or creates new one if the pool is empty.
+     *
+     * @return Handle.
+     */
+    Handle Acquire()
+    {
+        std::unique_ptr<T> object;
+
+        {
+            std::lock_guard lock {mStorage->mMutex};
+
+            if (!mStorage->mIdle.empty()) {
+                object = std::move(mStorage->mIdle.back());
+                mStorage->mIdle.pop_back();
+                mStorage->mStats.mReused++;
+            } else {
+                mStorage->mStats.mCreated++;
+            }
+        }
+
+        if (!object) {
+            object = std::make_unique<T>();
+        }
+
+        return Handle(object.release(), Deleter(mStorage));
+    }
+
+    /**
+     * Frees all idle objects.
+     */
+    void Shrink()
+    {
+        std::vector<std::unique_ptr<T>> idle;
+
+        {
+            std::lock_guard lock {mStorage->mMutex};
+
+            idle.swap(mStorage->mIdle);
+        }
+    }
+
+    /**
+     * Returns pool statistics.
+     *
+     * @return ObjectPoolStats.
+     */
+    ObjectPoolStats GetStats() const
+    {
+        std::lock_guard lock {mStorage->mMutex};
+
+        auto stats  = mStorage->mStats;
+        stats.mIdle = mStorage->mIdle.size();
+
+        return stats;
+    }
+
+private:
+    struct Storage {
+        Storage(size_t maxIdle, Reset reset)
+            : mMaxIdle(maxIdle)
+            , mReset(std::move(reset))
+        {
+            mIdle.reserve(maxIdle);
+        }
+
+        void Release(std::unique_ptr<T> object)
+        {
+            {
+                std::lock_guard lock {mMutex};
+
+                mStats.mReleased++;
+
+                // Objects which are not kept are freed without reset.
+                if (mIdle.size() + mResetting >= mMaxIdle) {
+                    mStats.mDropped++;
+
+                    return;
+                }
+
+                mResetting++;
+            }
+
+            auto reset = true;
+
+            // Reset outside of the lock: clearing big structures may take a while.
+            try {
+                mReset(*object);
+            } catch (...) {
+                reset = false;
+            }
+
+            std::lock_guard lock {mMutex};
+
+            mResetting--;
+
+            if (!reset) {
+                mStats.mDropped++;
+
+                return;
+            }
+
+            mIdle.push_back(std::move(object));
+        }
+
+        mutable std::mutex mMutex;
+        size_t             mMaxIdle;
+        Reset              mReset;
+        // Idle slots taken by objects being reset.
+        size_t                          mResetting = 0;
+        std::vector<std::unique_ptr<T>> mIdle;
+        ObjectPoolStats                 mStats;
+    };
+
+    std::shared_ptr<Storage> mStorage;
+};
+
+} // namespace aos::common::utils
+
+#endif
@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "pressurewatcher.hpp"
+
+namespace aos::common::utils {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Consts
+ **********************************************************************************************************************/
+
+constexpr auto     cMaxEvents  = 16;
+constexpr uint64_t cEventFDKey = 0;
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+const char* GetResourceName(PressureResource resource)
+{
+    switch (resource) {
+    case PressureResource::eCPU:
+        return "cpu";
+
+    case PressureResource::eIO:
+        return "io";
+
+    default:
+        return "memory";
+    }
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+PressureWatcher::PressureWatcher()
+{
+    mEpollFD = epoll_create1(EPOLL_CLOEXEC);
+    if (mEpollFD < 0) {
+        mInitError = errno;
+
+        return;
+    }
+
+    mEventFD = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (mEventFD < 0) {
+        mInitError = errno;
+
+        return;
+    }
+
+    epoll_event event {};
+
+    event.events   = EPOLLIN;
+    event.data.u64 = cEventFDKey;
+
+    if (epoll_ctl(mEpollFD, EPOLL_CTL_ADD, mEventFD, &event) != 0) {
+        mInitError = errno;
+    }
+}
+
+PressureWatcher::~PressureWatcher()
+{
+    for (const auto& [key, trigger] : mTriggers) {
+        close(trigger.mFD);
+    }
+
+    if (mEventFD >= 0) {
+        close(mEventFD);
+    }
+
+    if (mEpollFD >= 0) {
+        close(mEpollFD);
+    }
+}
+
+int PressureWatcher::AddSystemTrigger(const std::string& id, const PressureTrigger& trigger)
+{
+    return AddTrigger(id, std::string("/proc/pressure/") + GetResourceName(trigger.mResource), trigger);
+}
+
+int PressureWatcher::AddCGroupTrigger(
+    const std::string& id, const std::string& cgroupPath, const PressureTrigger& trigger)
+{
+    return AddTrigger(id, cgroupPath + "/" + GetResourceName(trigger.mResource) + ".pressure", trigger);
+}
+
+int PressureWatcher::Remove(const std::string& id)
+{
+    std::lock_guard lock {mMutex};
+
+    auto found = false;
+
+    for (auto it = mTriggers.begin(); it != mTriggers.end();) {
+        if (it->second.mID != id) {
+            it++;
+
+            continue;
+        }
+
+        // Removed from epoll set before close, under the lock Wait takes to resolve events.
+        epoll_ctl(mEpollFD, EPOLL_CTL_DEL, it->second.mFD, nullptr);
+        close(it->second.mFD);
+
+        it    = mTriggers.erase(it);
+        found = true;
+    }
+
+    return found ? 0 : ENOENT;
+}
+
+int PressureWatcher::Wait(std::chrono::milliseconds timeout, std::vector<PressureEvent>& events)
+{
+    events.clear();
+
+    if (mInitError != 0) {
+        return mInitError;
+    }
+
+    epoll_event epollEvents[cMaxEvents];
+
+    auto count = epoll_wait(mEpollFD, epollEvents, cMaxEvents, static_cast<int>(timeout.count()));
+    if (count < 0) {
+        return errno == EINTR ? 0 : errno;
+    }
+
+    std::lock_guard lock {mMutex};
+
+    for (int i = 0; i < count; i++) {
+        auto key = epollEvents[i].data.u64;
+
+        if (key == cEventFDKey) {
+            uint64_t value;
+
+            while (read(mEventFD, &value, sizeof(value)) > 0) { }
+
+            continue;
+        }
+
+        // Trigger may be removed while waiting: its key is never reused.
+        auto it = mTriggers.find(key);
+        if (it == mTriggers.end()) {
+            continue;
+        }
+
+        if ((epollEvents[i].events & (EPOLLERR | EPOLLHUP)) == 0) {
+            events.push_back({it->second.mID, it->second.mResource, 0});
+
+            continue;
+        }
+
+        // Monitored cgroup is gone: error is level triggered, so the trigger is dropped to not wake up on each Wait.
+        events.push_back({it->second.mID, it->second.mResource, ENODEV});
+
+        epoll_ctl(mEpollFD, EPOLL_CTL_DEL, it->second.mFD, nullptr);
+        close(it->second.mFD);
+
+        mTriggers.erase(it);
+    }
+
+    return 0;
+}
+
+void PressureWatcher::Interrupt()
+{
+    uint64_t value = 1;
+
+    if (write(mEventFD, &value, sizeof(value)) < 0) {
+        // Counter overflow means wakeup is already pending.
+    }
+}
+
+/***********************************************************************************************************************
+ * Private
+ **********************************************************************************************************************/
+
+int PressureWatcher::AddTrigger(const std::string& id, const std::string& path, const PressureTrigger& trigger)
+{
+    if (mInitError != 0) {
+        return mInitError;
+    }
+
+    auto fd = open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        return errno;
+    }
+
+    char triggerStr[64];
+
+    auto len = snprintf(triggerStr, sizeof(triggerStr), "%s %lld %lld", trigger.mFull ? "full" : "some",
+        static_cast<long long>(trigger.mStall.count()), static_cast<long long>(trigger.mWindow.count()));
+
+    // Trigger string must be written with terminating zero.
+    if (write(fd, triggerStr, len + 1) < 0) {
+        auto err = errno;
+
+        close(fd);
+
+        return err;
+    }
+
+    std::lock_guard lock {mMutex};
+
+    epoll_event event {};
+
+    auto key = mNextKey++;
+
+    event.events   = EPOLLPRI;
+    event.data.u64 = key;
+
+    if (epoll_ctl(mEpollFD, EPOLL_CTL_ADD, fd, &event) != 0) {
+        auto err = errno;
+
+        close(fd);
+
+        return err;
+    }
+
+    mTriggers[key] = Trigger {fd, id, trigger.mResource};
+
+    return 0;
+}
+
+} // namespace aos::common::utils
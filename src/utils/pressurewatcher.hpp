@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PRESSUREWATCHER_HPP_
+#define PRESSUREWATCHER_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace aos::common::utils {
+
+/**
+ * Pressure resource.
+ */
+enum class PressureResource { eCPU, eMemory, eIO };
+
+/**
+ * Pressure trigger.
+ *
+ * Event is generated when tasks are stalled on the resource for more than mStall within mWindow. See kernel PSI
+ * documentation: window must be in 500ms..10s range, and a multiple of 2s for unprivileged triggers.
+ */
+struct PressureTrigger {
+    PressureResource          mResource = PressureResource::eMemory;
+    bool                      mFull     = false;
+    std::chrono::microseconds mStall {150000};
+    std::chrono::microseconds mWindow {2000000};
+};
+
+/**
+ * Pressure event.
+ */
+struct PressureEvent {
+    std::string      mID;
+    PressureResource mResource = PressureResource::eMemory;
+    int              mError    = 0;
+};
+
+/**
+ * Watches system and cgroup v2 pressure stall information (PSI) triggers.
+ *
+ * Intended to drive monitoring loops: Wait() is called with regular low rate sampling interval and returns earlier as
+ * soon as any registered trigger fires, so monitoring can sample immediately on pressure.
+ *
+ * Add/Remove/Interrupt may be called from any thread, Wait should be called from one thread at a time.
+ * Methods return 0 on success or errno value on failure.
+ */
+class PressureWatcher {
+public:
+    /**
+     * Creates pressure watcher.
+     */
+    PressureWatcher();
+
+    /**
+     * Destroys pressure watcher.
+     */
+    ~PressureWatcher();
+
+    PressureWatcher(const PressureWatcher&)            = delete;
+    PressureWatcher& operator=(const PressureWatcher&) = delete;
+
+    /**
+     * Returns watcher init status.
+     *
+     * @return int.
+     */
+    int GetInitError() const { return mInitError; }
+
+    /**
+     * Adds system wide trigger using /proc/pressure.
+     *
+     * @param id trigger ID reported in events.
+     * @param trigger trigger.
+     * @return int.
+     */
+    int AddSystemTrigger(const std::string& id, const PressureTrigger& trigger);
+
+    /**
+     * Adds cgroup trigger using <cgroup>/<resource>.pressure.
+     *
+     * @param id trigger ID reported in events.
+     * @param cgroupPath cgroup directory path.
+     * @param trigger trigger.
+     * @return int.
+     */
+    int AddCGroupTrigger(const std::string& id, const std::string& cgroupPath, const PressureTrigger& trigger);
+
+    /**
+     * Removes all triggers with specified ID.
+     *
+     * @param id trigger ID.
+     * @return int.
+     */
+    int Remove(const std::string& id);
+
+    /**
+     * Waits for pressure events.
+     *
+     * Returns 0 with empty events on timeout or interrupt. Trigger which file fails, e.g. because its cgroup is
+     * removed, is reported once with ENODEV error and removed.
+     *
+     * @param timeout wait timeout.
+     * @param[out] events fired triggers.
+     * @return int.
+     */
+    int Wait(std::chrono::milliseconds timeout, std::vector<PressureEvent>& events);
+
+    /**
+     * Interrupts pending Wait call.
+     */
+    void Interrupt();
+
+private:
+    struct Trigger {
+        int              mFD;
+        std::string      mID;
+        PressureResource mResource;
+    };
+
+    int AddTrigger(const std::string& id, const std::string& path, const PressureTrigger& trigger);
+
+    int                                   mInitError = 0;
+    int                                   mEpollFD   = -1;
+    int                                   mEventFD   = -1;
+    std::mutex                            mMutex;
+    // Triggers are keyed by unique number instead of fd: fd may be reused while Wait handles stale events.
+    std::unordered_map<uint64_t, Trigger> mTriggers;
+    uint64_t                              mNextKey = 1;
+};
+
+} // namespace aos::common::utils
+
+#endif
@@ -0,0 +1,397 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <ctime>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "resourcesampler.hpp"
+
+namespace aos::common::utils {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Consts
+ **********************************************************************************************************************/
+
+constexpr auto cInitialBufferSize = 4096;
+constexpr auto cMaxBufferSize     = 1024 * 1024;
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+int OpenFile(const std::string& path)
+{
+    return open(path.c_str(), O_RDONLY | O_CLOEXEC);
+}
+
+uint64_t GetMonotonicUSec()
+{
+    timespec ts {};
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000 + static_cast<uint64_t>(ts.tv_nsec) / 1000;
+}
+
+void SkipSpaces(std::string_view& str)
+{
+    while (!str.empty() && (str.front() == ' ' || str.front() == '\t')) {
+        str.remove_prefix(1);
+    }
+}
+
+void SkipField(std::string_view& str)
+{
+    SkipSpaces(str);
+
+    while (!str.empty() && str.front() != ' ' && str.front() != '\n') {
+        str.remove_prefix(1);
+    }
+}
+
+// Returns EFBIG if file has more data after offset.
+int CheckEndOfFile(int fd, size_t offset)
+{
+    char next;
+
+    while (true) {
+        auto n = pread(fd, &next, sizeof(next), static_cast<off_t>(offset));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (n < 0) {
+            return errno;
+        }
+
+        return n == 0 ? 0 : EFBIG;
+    }
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Parsers
+ **********************************************************************************************************************/
+
+namespace resourcesampler {
+
+bool ParseUInt(std::string_view& str, uint64_t& value)
+{
+    size_t pos = 0;
+
+    value = 0;
+
+    while (pos < str.size() && str[pos] >= '0' && str[pos] <= '9') {
+        value = value * 10 + static_cast<uint64_t>(str[pos] - '0');
+        pos++;
+    }
+
+    if (pos == 0) {
+        return false;
+    }
+
+    str.remove_prefix(pos);
+
+    return true;
+}
+
+bool FindKeyValue(std::string_view content, std::string_view key, uint64_t& value)
+{
+    while (!content.empty()) {
+        auto line = content.substr(0, content.find('\n'));
+
+        content.remove_prefix(std::min(line.size() + 1, content.size()));
+
+        if (line.size() > key.size() && line.compare(0, key.size(), key) == 0 && line[key.size()] == ' ') {
+            line.remove_prefix(key.size());
+            SkipSpaces(line);
+
+            return ParseUInt(line, value);
+        }
+    }
+
+    return false;
+}
+
+uint64_t SumNestedKeyValue(std::string_view content, std::string_view key)
+{
+    uint64_t sum = 0;
+
+    for (auto pos = content.find(key); pos != std::string_view::npos; pos = content.find(key, pos + 1)) {
+        if ((pos != 0 && content[pos - 1] != ' ') || pos + key.size() >= content.size()
+            || content[pos + key.size()] != '=') {
+            continue;
+        }
+
+        auto     valueStr = content.substr(pos + key.size() + 1);
+        uint64_t value    = 0;
+
+        if (ParseUInt(valueStr, value)) {
+            sum += value;
+        }
+    }
+
+    return sum;
+}
+
+bool ParseProcStat(std::string_view content, uint64_t& cpuTicks, uint64_t& rssPages)
+{
+    // Process name may contain spaces and parentheses: fields start after the last ')'.
+    auto pos = content.rfind(')');
+    if (pos == std::string_view::npos) {
+        return false;
+    }
+
+    content.remove_prefix(pos + 1);
+
+    // Field numbers as in proc(5): state is field 3, utime 14, stime 15, rss 24.
+    uint64_t utime = 0, stime = 0;
+
+    for (int field = 3; field <= 24; field++) {
+        switch (field) {
+        case 14:
+        case 15:
+        case 24: {
+            SkipSpaces(content);
+
+            auto& value = field == 14 ? utime : (field == 15 ? stime : rssPages);
+
+            if (!ParseUInt(content, value)) {
+                return false;
+            }
+
+            break;
+        }
+
+        default:
+            SkipField(content);
+        }
+    }
+
+    cpuTicks = utime + stime;
+
+    return true;
+}
+
+} // namespace resourcesampler
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+ResourceSampler::ResourceSampler()
+    : mBuffer(cInitialBufferSize)
+{
+    auto clockTicks = sysconf(_SC_CLK_TCK);
+    auto pageSize   = sysconf(_SC_PAGESIZE);
+
+    mClockTicks = clockTicks > 0 ? static_cast<uint64_t>(clockTicks) : 100;
+    mPageSize   = pageSize > 0 ? static_cast<uint64_t>(pageSize) : 4096;
+}
+
+ResourceSampler::~ResourceSampler()
+{
+    for (auto& source : mSources) {
+        CloseSource(source);
+    }
+}
+
+int ResourceSampler::AddCGroup(const std::string& id, const std::string& path)
+{
+    Source source {id, SourceType::eCGroup};
+
+    if (source.mCPUFD = OpenFile(path + "/cpu.stat"); source.mCPUFD < 0) {
+        return errno;
+    }
+
+    if (source.mRAMFD = OpenFile(path + "/memory.current"); source.mRAMFD < 0) {
+        auto err = errno;
+
+        CloseSource(source);
+
+        return err;
+    }
+
+    // io controller may be disabled for the group: IO usage is reported as zero in this case.
+    source.mIOFD = OpenFile(path + "/io.stat");
+
+    Remove(id);
+    mSources.push_back(std::move(source));
+
+    return 0;
+}
+
+int ResourceSampler::AddProcess(const std::string& id, pid_t pid)
+{
+    Source source {id, SourceType::eProcess};
+
+    auto procPath = "/proc/" + std::to_string(pid);
+
+    if (source.mCPUFD = OpenFile(procPath + "/stat"); source.mCPUFD < 0) {
+        return errno;
+    }
+
+    // /proc/<pid>/io requires ptrace access: IO usage is reported as zero if not permitted.
+    source.mIOFD = OpenFile(procPath + "/io");
+
+    Remove(id);
+    mSources.push_back(std::move(source));
+
+    return 0;
+}
+
+int ResourceSampler::Remove(const std::string& id)
+{
+    auto it = std::find_if(mSources.begin(), mSources.end(), [&id](const Source& source) { return source.mID == id; });
+    if (it == mSources.end()) {
+        return ENOENT;
+    }
+
+    CloseSource(*it);
+    mSources.erase(it);
+
+    return 0;
+}
+
+void ResourceSampler::Sample(std::vector<ResourceSample>& samples)
+{
+    samples.resize(mSources.size());
+
+    for (size_t i = 0; i < mSources.size(); i++) {
+        auto& source = mSources[i];
+        auto& sample = samples[i];
+
+        sample.mID    = source.mID;
+        sample.mUsage = ResourceUsage {};
+        sample.mError = source.mType == SourceType::eCGroup ? SampleCGroup(source, sample.mUsage)
+                                                            : SampleProcess(source, sample.mUsage);
+
+        if (sample.mError != 0) {
+            continue;
+        }
+
+        auto now = GetMonotonicUSec();
+
+        if (source.mPrevTimestampUSec != 0 && now > source.mPrevTimestampUSec
+            && sample.mUsage.mCPUTimeUSec >= source.mPrevCPUTimeUSec) {
+            sample.mUsage.mCPU = static_cast<double>(sample.mUsage.mCPUTimeUSec - source.mPrevCPUTimeUSec) * 100.0
+                / static_cast<double>(now - source.mPrevTimestampUSec);
+        }
+
+        source.mPrevCPUTimeUSec   = sample.mUsage.mCPUTimeUSec;
+        source.mPrevTimestampUSec = now;
+    }
+}
+
+/***********************************************************************************************************************
+ * Private
+ **********************************************************************************************************************/
+
+void ResourceSampler::CloseSource(Source& source)
+{
+    for (auto fd : {&source.mCPUFD, &source.mRAMFD, &source.mIOFD}) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+int ResourceSampler::ReadFile(int fd, std::string_view& content)
+{
+    while (true) {
+        auto size = pread(fd, mBuffer.data(), mBuffer.size(), 0);
+        if (size < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return errno;
+        }
+
+        // Buffer is filled completely: content may be truncated, grow and read again.
+        if (static_cast<size_t>(size) == mBuffer.size() && mBuffer.size() < cMaxBufferSize) {
+            mBuffer.resize(mBuffer.size() * 2);
+
+            continue;
+        }
+
+        // Content which does not fit into max size buffer is reported as error instead of parsing truncated data.
+        if (static_cast<size_t>(size) == mBuffer.size()) {
+            if (auto err = CheckEndOfFile(fd, mBuffer.size()); err != 0) {
+                return err;
+            }
+        }
+
+        content = std::string_view(mBuffer.data(), static_cast<size_t>(size));
+
+        return 0;
+    }
+}
+
+int ResourceSampler::SampleCGroup(const Source& source, ResourceUsage& usage)
+{
+    std::string_view content;
+
+    if (auto err = ReadFile(source.mCPUFD, content); err != 0) {
+        return err;
+    }
+
+    if (!resourcesampler::FindKeyValue(content, "usage_usec", usage.mCPUTimeUSec)) {
+        return EINVAL;
+    }
+
+    if (auto err = ReadFile(source.mRAMFD, content); err != 0) {
+        return err;
+    }
+
+    if (!resourcesampler::ParseUInt(content, usage.mRAM)) {
+        return EINVAL;
+    }
+
+    if (source.mIOFD >= 0 && ReadFile(source.mIOFD, content) == 0) {
+        usage.mIOReadBytes  = resourcesampler::SumNestedKeyValue(content, "rbytes");
+        usage.mIOWriteBytes = resourcesampler::SumNestedKeyValue(content, "wbytes");
+    }
+
+    return 0;
+}
+
+int ResourceSampler::SampleProcess(const Source& source, ResourceUsage& usage)
+{
+    std::string_view content;
+
+    if (auto err = ReadFile(source.mCPUFD, content); err != 0) {
+        // ESRCH means the process has exited.
+        return err;
+    }
+
+    uint64_t cpuTicks = 0, rssPages = 0;
+
+    if (!resourcesampler::ParseProcStat(content, cpuTicks, rssPages)) {
+        return EINVAL;
+    }
+
+    usage.mCPUTimeUSec = cpuTicks * 1000000 / mClockTicks;
+    usage.mRAM         = rssPages * mPageSize;
+
+    if (source.mIOFD >= 0 && ReadFile(source.mIOFD, content) == 0) {
+        resourcesampler::FindKeyValue(content, "read_bytes:", usage.mIOReadBytes);
+        resourcesampler::FindKeyValue(content, "write_bytes:", usage.mIOWriteBytes);
+    }
+
+    return 0;
+}
+
+} // namespace aos::common::utils
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef RESOURCESAMPLER_HPP_
+#define RESOURCESAMPLER_HPP_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace aos::common::utils {
+
+/**
+ * Resource usage sample.
+ */
+struct ResourceUsage {
+    uint64_t mCPUTimeUSec  = 0;
+    double   mCPU          = 0.0;
+    uint64_t mRAM          = 0;
+    uint64_t mIOReadBytes  = 0;
+    uint64_t mIOWriteBytes = 0;
+};
+
+/**
+ * Resource usage sample of a single source.
+ */
+struct ResourceSample {
+    std::string   mID;
+    ResourceUsage mUsage;
+    int           mError = 0;
+};
+
+/**
+ * Samples CPU, RAM and IO usage of processes and cgroup v2 groups.
+ *
+ * Source files are opened once on registration and re-read with pread() on each sample, avoiding open/close and
+ * stream overhead per cycle. CPU usage is calculated as percent of one CPU core between two consecutive samples.
+ *
+ * Methods return 0 on success or errno value on failure.
+ */
+class ResourceSampler {
+public:
+    /**
+     * Creates resource sampler.
+     */
+    ResourceSampler();
+
+    /**
+     * Destroys resource sampler.
+     */
+    ~ResourceSampler();
+
+    ResourceSampler(const ResourceSampler&)            = delete;
+    ResourceSampler& operator=(const ResourceSampler&) = delete;
+
+    /**
+     * Adds cgroup v2 group to sample.
+     *
+     * @param id source ID.
+     * @param path cgroup directory path, e.g. /sys/fs/cgroup/system.slice/foo.service.
+     * @return int.
+     */
+    int AddCGroup(const std::string& id, const std::string& path);
+
+    /**
+     * Adds process to sample.
+     *
+     * @param id source ID.
+     * @param pid process ID.
+     * @return int.
+     */
+    int AddProcess(const std::string& id, pid_t pid);
+
+    /**
+     * Removes source.
+     *
+     * @param id source ID.
+     * @return int.
+     */
+    int Remove(const std::string& id);
+
+    /**
+     * Samples all registered sources in one pass.
+     *
+     * Per source errors are reported in ResourceSample::mError and don't interrupt the pass. Source file larger than
+     * 1 MiB is reported with EFBIG error.
+     *
+     * @param[out] samples samples. Vector is reused: existing capacity is kept.
+     */
+    void Sample(std::vector<ResourceSample>& samples);
+
+private:
+    enum class SourceType { eCGroup, eProcess };
+
+    struct Source {
+        std::string mID;
+        SourceType  mType;
+        int         mCPUFD             = -1;
+        int         mRAMFD             = -1;
+        int         mIOFD              = -1;
+        uint64_t    mPrevCPUTimeUSec   = 0;
+        uint64_t    mPrevTimestampUSec = 0;
+    };
+
+    static void CloseSource(Source& source);
+
+    int ReadFile(int fd, std::string_view& content);
+    int SampleCGroup(const Source& source, ResourceUsage& usage);
+    int SampleProcess(const Source& source, ResourceUsage& usage);
+
+    std::vector<Source> mSources;
+    std::vector<char>   mBuffer;
+    uint64_t            mClockTicks;
+    uint64_t            mPageSize;
+};
+
+namespace resourcesampler {
+
+/**
+ * Parses unsigned decimal value.
+ *
+ * @param str string, on success advanced past parsed digits.
+ * @param[out] value parsed value.
+ * @return bool.
+ */
+bool ParseUInt(std::string_view& str, uint64_t& value);
+
+/**
+ * Finds value of key in flat keyed file, e.g. "usage_usec 123\n".
+ *
+ * @param content file content.
+ * @param key key.
+ * @param[out] value value.
+ * @return bool.
+ */
+bool FindKeyValue(std::string_view content, std::string_view key, uint64_t& value);
+
+/**
+ * Sums key values across all lines of nested keyed file, e.g. "8:0 rbytes=1 wbytes=2\n".
+ *
+ * @param content file content.
+ * @param key key.
+ * @return uint64_t.
+ */
+uint64_t SumNestedKeyValue(std::string_view content, std::string_view key);
+
+/**
+ * Parses /proc/<pid>/stat content.
+ *
+ * @param content file content.
+ * @param[out] cpuTicks utime + stime in clock ticks.
+ * @param[out] rssPages resident set size in pages.
+ * @return bool.
+ */
+bool ParseProcStat(std::string_view content, uint64_t& cpuTicks, uint64_t& rssPages);
+
+} // namespace resourcesampler
+
+} // namespace aos::common::utils
+
+#endif
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SNAPSHOTDIFFER_HPP_
+#define SNAPSHOTDIFFER_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace aos::common::utils {
+
+/**
+ * Snapshot delta.
+ *
+ * Receiver applies full snapshot by replacing its state and delta by updating and removing items. Delta sequence
+ * numbers are consecutive: a gap means lost delta and receiver should request full snapshot.
+ */
+template <typename Key, typename Value>
+struct SnapshotDelta {
+    uint64_t           mSequence = 0;
+    bool               mFull     = false;
+    std::vector<Value> mUpdated;
+    std::vector<Key>   mRemoved;
+
+    /**
+     * Clears delta keeping allocated capacity.
+     */
+    void Clear()
+    {
+        mSequence = 0;
+        mFull     = false;
+        mUpdated.clear();
+        mRemoved.clear();
+    }
+};
+
+/**
+ * Computes per key changes between consecutive status snapshots.
+ *
+ * Previous snapshot is kept in a hash map; each item of the current snapshot is compared with its previous value
+ * and only added or changed items are copied into the delta. Full snapshot is produced for the first cycle, every
+ * full interval cycles and on explicit request, e.g. after reconnect.
+ *
+ * Value should be equality comparable, KeyOf should return unique item key. Not thread safe.
+ */
+template <typename Key, typename Value, typename KeyOf, typename Hash = std::hash<Key>>
+class SnapshotDiffer {
+public:
+    using Delta = SnapshotDelta<Key, Value>;
+
+    /**
+     * Creates snapshot differ.
+     *
+     * @param fullInterval number of cycles between full snapshots, 0 to send full snapshot on request only.
+     * @param keyOf item key getter.
+     */
+    explicit SnapshotDiffer(size_t fullInterval, KeyOf keyOf = KeyOf {})
+        : mFullInterval(fullInterval)
+        , mKeyOf(std::move(keyOf))
+    {
+    }
+
+    /**
+     * Compares current snapshot with previous one.
+     *
+     * @param current current snapshot.
+     * @param[out] delta snapshot delta.
+     * @return bool true if delta should be sent, false if nothing is changed.
+     */
+    bool Diff(const std::vector<Value>& current, Delta& delta)
+    {
+        delta.Clear();
+
+        mCycle++;
+
+        auto full = mFullRequested || (mFullInterval != 0 && mCycle % mFullInterval == 0);
+
+        for (const auto& value : current) {
+            // Lookup first: unchanged items, the common case, are neither copied nor allocated.
+            decltype(auto) key     = mKeyOf(value);
+            auto           it      = mPrevious.find(key);
+            auto           changed = it == mPrevious.end();
+
+            if (changed) {
+                mPrevious.emplace(key, Entry {value, mCycle});
+            } else {
+                it->second.mSeen = mCycle;
+
+                if (!(it->second.mValue == value)) {
+                    it->second.mValue = value;
+                    changed           = true;
+                }
+            }
+
+            if (changed || full) {
+                delta.mUpdated.push_back(value);
+            }
+        }
+
+        for (auto it = mPrevious.begin(); it != mPrevious.end();) {
+            if (it->second.mSeen == mCycle) {
+                it++;
+
+                continue;
+            }
+
+            if (!full) {
+                delta.mRemoved.push_back(it->first);
+            }
+
+            it = mPrevious.erase(it);
+        }
+
+        if (!full && delta.mUpdated.empty() && delta.mRemoved.empty()) {
+            return false;
+        }
+
+        mFullRequested  = false;
+        delta.mFull     = full;
+        delta.mSequence = ++mSequence;
+
+        return true;
+    }
+
+    /**
+     * Requests full snapshot on next cycle.
+     */
+    void RequestFull() { mFullRequested = true; }
+
+    /**
+     * Returns sequence number of last produced delta.
+     *
+     * @return uint64_t.
+     */
+    uint64_t GetSequence() const { return mSequence; }
+
+private:
+    struct Entry {
+        Value    mValue;
+        uint64_t mSeen;
+    };
+
+    size_t                               mFullInterval;
+    KeyOf                                mKeyOf;
+    std::unordered_map<Key, Entry, Hash> mPrevious;
+    uint64_t                             mCycle         = 0;
+    uint64_t                             mSequence      = 0;
+    bool                                 mFullRequested = true;
+};
+
+} // namespace aos::common::utils
+
+#endif
@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SPSCQUEUE_HPP_
+#define SPSCQUEUE_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace aos::common::utils {
+
+/**
+ * Bounded single producer single consumer queue.
+ *
+ * Ring buffer with producer and consumer indexes on separate cache lines; each side caches the other side index and
+ * reloads it only when the ring looks full or empty. Try* operations are wait-free. Blocking operations spin briefly
+ * and then sleep on condition variable; the other side takes the mutex only if a waiter is flagged, so the fast path
+ * has no locks and no syscalls.
+ *
+ * Exactly one thread may push and one thread may pop. Close may be called from any thread: blocked calls return,
+ * pop still drains remaining items.
+ */
+template <typename T>
+class SPSCQueue {
+public:
+    /**
+     * Creates SPSC queue.
+     *
+     * @param capacity queue capacity, rounded up to power of two.
+     */
+    explicit SPSCQueue(size_t capacity)
+    {
+        size_t size = 1;
+
+        while (size < capacity) {
+            size <<= 1;
+        }
+
+        mMask  = size - 1;
+        mSlots = std::make_unique<T[]>(size);
+    }
+
+    SPSCQueue(const SPSCQueue&)            = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    /**
+     * Returns queue capacity.
+     *
+     * @return size_t.
+     */
+    size_t Capacity() const { return mMask + 1; }
+
+    /**
+     * Pushes items without waiting.
+     *
+     * @param items items to move into the queue.
+     * @param count number of items.
+     * @return size_t number of pushed items.
+     */
+    size_t TryPushBatch(T* items, size_t count)
+    {
+        auto tail = mTail.load(std::memory_order_relaxed);
+
+        if (Capacity() - (tail - mCachedHead) < count) {
+            mCachedHead = mHead.load(std::memory_order_acquire);
+        }
+
+        count = std::min(count, Capacity() - (tail - mCachedHead));
+
+        for (size_t i = 0; i < count; i++) {
+            mSlots[(tail + i) & mMask] = std::move(items[i]);
+        }
+
+        if (count != 0) {
+            mTail.store(tail + count, std::memory_order_release);
+            Notify(mConsumerWaiting, mNotEmpty);
+        }
+
+        return count;
+    }
+
+    /**
+     * Pushes item without waiting.
+     *
+     * @param item item.
+     * @return bool false if queue is full.
+     */
+    bool TryPush(T&& item) { return TryPushBatch(&item, 1) == 1; }
+
+    /**
+     * Pops items without waiting.
+     *
+     * @param[out] items output items.
+     * @param maxCount max number of items.
+     * @return size_t number of popped items.
+     */
+    size_t TryPopBatch(T* items, size_t maxCount)
+    {
+        auto head = mHead.load(std::memory_order_relaxed);
+
+        if (mCachedTail - head < maxCount) {
+            mCachedTail = mTail.load(std::memory_order_acquire);
+        }
+
+        auto count = std::min(maxCount, mCachedTail - head);
+
+        for (size_t i = 0; i < count; i++) {
+            items[i] = std::move(mSlots[(head + i) & mMask]);
+        }
+
+        if (count != 0) {
+            mHead.store(head + count, std::memory_order_release);
+            Notify(mProducerWaiting, mNotFull);
+        }
+
+        return count;
+    }
+
+    /**
+     * Pops item without waiting.
+     *
+     * @param[out] item item.
+     * @return bool false if queue is empty.
+     */
+    bool TryPop(T& item) { return TryPopBatch(&item, 1) == 1; }
+
+    /**
+     * Pushes all items, waits while queue is full.
+     *
+     * @param items items to move into the queue.
+     * @param count number of items.
+     * @return bool false if queue is closed.
+     */
+    bool PushBatch(T* items, size_t count)
+    {
+        for (;;) {
+            if (IsClosed()) {
+                return false;
+            }
+
+            auto pushed = TryPushBatch(items, count);
+
+            items += pushed;
+            count -= pushed;
+
+            if (count == 0) {
+                return true;
+            }
+
+            if (!Wait(mProducerWaiting, mNotFull, [this] { return mTail.load() - mHead.load() < Capacity(); })) {
+                return false;
+            }
+        }
+    }
+
+    /**
+     * Pushes item, waits while queue is full.
+     *
+     * @param item item.
+     * @return bool false if queue is closed.
+     */
+    bool Push(T&& item) { return PushBatch(&item, 1); }
+
+    /**
+     * Pops available items, waits while queue is empty.
+     *
+     * @param[out] items output items.
+     * @param maxCount max number of items.
+     * @return size_t number of popped items, 0 if queue is closed and empty.
+     */
+    size_t PopBatch(T* items, size_t maxCount)
+    {
+        for (;;) {
+            if (auto count = TryPopBatch(items, maxCount); count != 0) {
+                return count;
+            }
+
+            if (!Wait(mConsumerWaiting, mNotEmpty, [this] { return mTail.load() != mHead.load(); })) {
+                return TryPopBatch(items, maxCount);
+            }
+        }
+    }
+
+    /**
+     * Pops item, waits while queue is empty.
+     *
+     * @param[out] item item.
+     * @return bool false if queue is closed and empty.
+     */
+    bool Pop(T& item) { return PopBatch(&item, 1) == 1; }
+
+    /**
+     * Closes queue: wakes up blocked calls.
+     */
+    void Close()
+    {
+        std::lock_guard lock {mMutex};
+
+        mClosed.store(true, std::memory_order_release);
+        mNotEmpty.notify_all();
+        mNotFull.notify_all();
+    }
+
+    /**
+     * Returns true if queue is closed.
+     *
+     * @return bool.
+     */
+    bool IsClosed() const { return mClosed.load(std::memory_order_acquire); }
+
+private:
+    static constexpr size_t cCacheLineSize = 64;
+    static constexpr int    cSpinCount     = 64;
+
+    // Returns false if queue is closed.
+    template <typename Ready>
+    bool Wait(std::atomic_bool& waiting, std::condition_variable& condVar, Ready ready)
+    {
+        for (int i = 0; i < cSpinCount; i++) {
+            if (ready()) {
+                return true;
+            }
+
+            if (IsClosed()) {
+                return false;
+            }
+
+            std::this_thread::yield();
+        }
+
+        std::unique_lock lock {mMutex};
+
+        waiting.store(true, std::memory_order_seq_cst);
+        // Pairs with fence in Notify: either the other side sees the flag or we see its update.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        condVar.wait(lock, [&] { return ready() || IsClosed(); });
+
+        waiting.store(false, std::memory_order_relaxed);
+
+        return ready();
+    }
+
+    void Notify(std::atomic_bool& waiting, std::condition_variable& condVar)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (waiting.load(std::memory_order_relaxed)) {
+            std::lock_guard lock {mMutex};
+
+            condVar.notify_one();
+        }
+    }
+
+    // Consumer side.
+    alignas(cCacheLineSize) std::atomic_size_t mHead {0};
+    size_t mCachedTail = 0;
+
+    // Producer side.
+    alignas(cCacheLineSize) std::atomic_size_t mTail {0};
+    size_t mCachedHead = 0;
+
+    alignas(cCacheLineSize) std::atomic_bool mClosed {false};
+    std::atomic_bool                           mConsumerWaiting {false};
+    std::atomic_bool                           mProducerWaiting {false};
+    std::mutex                                 mMutex;
+    std::condition_variable                    mNotEmpty;
+    std::condition_variable                    mNotFull;
+    size_t                                     mMask = 0;
+    std::unique_ptr<T[]>                       mSlots;
+};
+
+} // namespace aos::common::utils
+
+#endif
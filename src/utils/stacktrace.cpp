@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+
+#include "stacktrace.hpp"
+
+namespace aos::common::utils {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+// First backtrace call loads the unwinder and allocates: do it once at startup rather than on first throw.
+const bool sBacktraceInitialized = []() {
+    void* frame;
+
+    backtrace(&frame, 1);
+
+    return true;
+}();
+
+void AppendFrame(std::string& str, size_t index, void* address)
+{
+    char buffer[64];
+
+    snprintf(buffer, sizeof(buffer), "#%zu 0x%" PRIxPTR, index, reinterpret_cast<uintptr_t>(address));
+    str += buffer;
+
+    Dl_info info {};
+
+    if (dladdr(address, &info) == 0) {
+        str += " ??\n";
+
+        return;
+    }
+
+    if (info.dli_sname) {
+        int                                    status = 0;
+        std::unique_ptr<char, decltype(&free)> demangled(
+            abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status), &free);
+
+        str += ' ';
+        str += status == 0 && demangled ? demangled.get() : info.dli_sname;
+
+        snprintf(buffer, sizeof(buffer), "+0x%" PRIxPTR,
+            reinterpret_cast<uintptr_t>(address) - reinterpret_cast<uintptr_t>(info.dli_saddr));
+        str += buffer;
+    } else {
+        str += " ??";
+    }
+
+    if (info.dli_fname) {
+        str += " (";
+        str += info.dli_fname;
+        str += ')';
+    }
+
+    str += '\n';
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Public
+ **********************************************************************************************************************/
+
+__attribute__((noinline)) StackTrace StackTrace::Capture(size_t skip)
+{
+    (void)sBacktraceInitialized;
+
+    StackTrace trace;
+
+    auto size = backtrace(trace.mFrames.data(), static_cast<int>(cMaxFrames));
+    if (size <= 0) {
+        return trace;
+    }
+
+    // Skip Capture frame itself.
+    skip++;
+
+    if (static_cast<size_t>(size) <= skip) {
+        return trace;
+    }
+
+    trace.mSize = static_cast<size_t>(size) - skip;
+
+    for (size_t i = 0; i < trace.mSize; i++) {
+        trace.mFrames[i] = trace.mFrames[i + skip];
+    }
+
+    return trace;
+}
+
+const std::string& StackTrace::ToString() const
+{
+    if (!mFormatted.empty() || mSize == 0) {
+        return mFormatted;
+    }
+
+    for (size_t i = 0; i < mSize; i++) {
+        AppendFrame(mFormatted, i, mFrames[i]);
+    }
+
+    return mFormatted;
+}
+
+} // namespace aos::common::utils
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef STACKTRACE_HPP_
+#define STACKTRACE_HPP_
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+namespace aos::common::utils {
+
+/**
+ * Lazily symbolized stack trace.
+ *
+ * Capture only stores raw return addresses; symbols are resolved and demangled on first ToString call and the result
+ * is cached. This keeps capturing cheap enough for exceptions used for control flow.
+ *
+ * ToString is not thread safe for the same instance.
+ */
+class StackTrace {
+public:
+    static constexpr size_t cMaxFrames = 32;
+
+    /**
+     * Captures current stack trace.
+     *
+     * @param skip number of innermost frames to skip, Capture itself is always skipped.
+     * @return StackTrace.
+     */
+    static StackTrace Capture(size_t skip = 0);
+
+    /**
+     * Returns number of captured frames.
+     *
+     * @return size_t.
+     */
+    size_t Size() const { return mSize; }
+
+    /**
+     * Returns captured frame address.
+     *
+     * @param index frame index.
+     * @return void*.
+     */
+    void* GetFrame(size_t index) const { return mFrames[index]; }
+
+    /**
+     * Returns formatted stack trace: one "#<index> <address> <function>+<offset> (<module>)" line per frame.
+     *
+     * @return const std::string&.
+     */
+    const std::string& ToString() const;
+
+private:
+    std::array<void*, cMaxFrames> mFrames {};
+    size_t                        mSize = 0;
+    mutable std::string           mFormatted;
+};
+
+} // namespace aos::common::utils
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "utils/atomicfile.hpp"
+
+using namespace testing;
+
+namespace aos::common::utils {
+
+namespace fs = std::filesystem;
+
+/***********************************************************************************************************************
+ * Suite
+ **********************************************************************************************************************/
+
+class AtomicFileTest : public Test {
+protected:
+    void SetUp() override
+    {
+        mDir = fs::temp_directory_path() / ("atomicfile_test_" + std::to_string(getpid()));
+
+        fs::remove_all(mDir);
+        fs::create_directories(mDir);
+    }
+
+    void TearDown() override { fs::remove_all(mDir); }
+
+    std::string ReadFile(const fs::path& path)
+    {
+        std::stringstream content;
+
+        content << std::ifstream(path).rdbuf();
+
+        return content.str();
+    }
+
+    fs::path mDir;
+};
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST_F(AtomicFileTest, WriteFileAtomically)
+{
+    auto path = (mDir / "file").string();
+
+    ASSERT_EQ(WriteFileAtomically(path, "first"), 0);
+    EXPECT_EQ(ReadFile(path), "first");
+    EXPECT_EQ(fs::status(path).permissions(), fs::perms(0644));
+
+    struct stat st {};
+
+    ASSERT_EQ(WriteFileAtomically(path, "second", 0600, &st), 0);
+    EXPECT_EQ(ReadFile(path), "second");
+    EXPECT_EQ(fs::status(path).permissions(), fs::perms(0600));
+
+    struct stat written {};
+
+    ASSERT_EQ(stat(path.c_str(), &written), 0);
+    EXPECT_EQ(st.st_ino, written.st_ino);
+    EXPECT_EQ(st.st_size, 6);
+
+    ASSERT_EQ(WriteFileAtomically(path, ""), 0);
+    EXPECT_EQ(ReadFile(path), "");
+
+    // No temporary files are left.
+    EXPECT_EQ(std::distance(fs::directory_iterator(mDir), fs::directory_iterator()), 1);
+}
+
+TEST_F(AtomicFileTest, WriteError)
+{
+    auto path = (mDir / "file").string();
+
+    ASSERT_EQ(WriteFileAtomically(path, "content"), 0);
+
+    fs::create_directory(mDir / "dir");
+    std::ofstream(mDir / "dir" / "child") << "child";
+
+    // Rename over non empty directory fails: temporary file is removed, target is kept.
+    EXPECT_NE(WriteFileAtomically((mDir / "dir").string(), "content"), 0);
+    EXPECT_TRUE(fs::is_directory(mDir / "dir"));
+    EXPECT_EQ(std::distance(fs::directory_iterator(mDir), fs::directory_iterator()), 2);
+
+    EXPECT_EQ(WriteFileAtomically((mDir / "missing" / "file").string(), "content"), ENOENT);
+}
+
+} // namespace aos::common::utils
@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "utils/configwatcher.hpp"
+
+using namespace testing;
+
+namespace aos::common::utils {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+void WriteFile(const std::filesystem::path& path, const std::string& content)
+{
+    auto tmpPath = path.string() + ".new";
+
+    std::ofstream(tmpPath) << content;
+    std::filesystem::rename(tmpPath, path);
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Suite
+ **********************************************************************************************************************/
+
+class ConfigWatcherTest : public Test {
+protected:
+    void SetUp() override
+    {
+        mDir = std::filesystem::temp_directory_path() / ("configwatcher_test_" + std::to_string(getpid()));
+
+        std::filesystem::remove_all(mDir);
+        std::filesystem::create_directories(mDir);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(mDir); }
+
+    std::filesystem::path mDir;
+};
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST_F(ConfigWatcherTest, ParseConfig)
+{
+    ConfigSections sections;
+
+    ASSERT_EQ(ParseConfig(R"({"a": {"x": 1, "y": [true, null, {}]}, "b": "str", "c/d": []})", sections), 0);
+    ASSERT_EQ(sections.size(), 3);
+
+    EXPECT_EQ(sections["a"].mJSON, R"({"x":1,"y":[true,null,{}]})");
+    EXPECT_EQ(sections["a"].mValues,
+        (std::map<std::string, std::string> {{"/x", "1"}, {"/y/0", "true"}, {"/y/1", "null"}, {"/y/2", "{}"}}));
+    EXPECT_EQ(sections["b"].mJSON, R"("str")");
+    EXPECT_EQ(sections["b"].mValues, (std::map<std::string, std::string> {{"", R"("str")"}}));
+    EXPECT_EQ(sections["c/d"].mJSON, "[]");
+
+    EXPECT_EQ(ParseConfig("[1, 2]", sections), EINVAL);
+    EXPECT_EQ(ParseConfig("1", sections), EINVAL);
+    EXPECT_EQ(ParseConfig(R"({"a": )", sections), EINVAL);
+    EXPECT_EQ(sections.size(), 3);
+}
+
+TEST_F(ConfigWatcherTest, DiffConfig)
+{
+    ConfigSections from, to;
+
+    ASSERT_EQ(ParseConfig(R"({"same": {"a": 1, "b": 2}, "changed": {"a": 1, "b": [1, 2]}, "removed": 1})", from), 0);
+    ASSERT_EQ(ParseConfig(R"({"same": {"b": 2, "a": 1}, "changed": {"a": 1, "b": [1], "c": "x"}, "added": {}})", to),
+        0);
+
+    std::vector<ConfigSectionChange> changes;
+
+    DiffConfig(from, to, changes);
+    ASSERT_EQ(changes.size(), 3);
+
+    EXPECT_EQ(changes[0].mSection, "added");
+    EXPECT_EQ(changes[0].mJSON, "{}");
+    EXPECT_EQ(changes[0].mChangedPaths, std::vector<std::string>({""}));
+
+    EXPECT_EQ(changes[1].mSection, "changed");
+    EXPECT_EQ(changes[1].mJSON, R"({"a":1,"b":[1],"c":"x"})");
+    EXPECT_EQ(changes[1].mChangedPaths, std::vector<std::string>({"/b/1", "/c"}));
+
+    EXPECT_EQ(changes[2].mSection, "removed");
+    EXPECT_TRUE(changes[2].mJSON.empty());
+}
+
+TEST_F(ConfigWatcherTest, NotifySubscribers)
+{
+    auto path = mDir / "aos.cfg";
+
+    WriteFile(path, R"({"monitoring": {"pollPeriod": "1s"}, "logging": {"level": "info"}})");
+
+    ConfigWatcher watcher(path.string());
+
+    std::mutex                       mutex;
+    std::condition_variable          condVar;
+    std::vector<ConfigSectionChange> changes;
+
+    auto subscribe = [&](const std::string& section) {
+        return watcher.Subscribe(section, [&](const ConfigSectionChange& change) {
+            std::lock_guard lock {mutex};
+
+            changes.push_back(change);
+            condVar.notify_all();
+        });
+    };
+
+    subscribe("monitoring");
+    auto loggingID = subscribe("logging");
+
+    ASSERT_EQ(watcher.Start(), 0);
+
+    std::string json;
+
+    ASSERT_EQ(watcher.GetSection("logging", json), 0);
+    EXPECT_EQ(json, R"({"level":"info"})");
+    EXPECT_EQ(watcher.GetSection("unknown", json), ENOENT);
+
+    // Invalid config is ignored.
+    WriteFile(path, R"({"monitoring": )");
+    WriteFile(path, R"({"monitoring": {"pollPeriod": "1s"}, "logging": {"level": "debug"}})");
+
+    {
+        std::unique_lock lock {mutex};
+
+        ASSERT_TRUE(condVar.wait_for(lock, std::chrono::seconds(5), [&] { return !changes.empty(); }));
+        ASSERT_EQ(changes.size(), 1);
+        EXPECT_EQ(changes[0].mSection, "logging");
+        EXPECT_EQ(changes[0].mJSON, R"({"level":"debug"})");
+        EXPECT_EQ(changes[0].mChangedPaths, std::vector<std::string>({"/level"}));
+
+        changes.clear();
+    }
+
+    watcher.Unsubscribe(loggingID);
+
+    // In place write.
+    std::ofstream(path) << R"({"monitoring": {"pollPeriod": "5s"}, "logging": {}})";
+
+    {
+        std::unique_lock lock {mutex};
+
+        ASSERT_TRUE(condVar.wait_for(lock, std::chrono::seconds(5), [&] { return !changes.empty(); }));
+        ASSERT_EQ(changes.size(), 1);
+        EXPECT_EQ(changes[0].mSection, "monitoring");
+    }
+
+    ASSERT_EQ(watcher.GetSection("logging", json), 0);
+    EXPECT_EQ(json, "{}");
+
+    watcher.Stop();
+}
+
+TEST_F(ConfigWatcherTest, StopFromSubscriber)
+{
+    auto path = mDir / "aos.cfg";
+
+    WriteFile(path, R"({"logging": {"level": "info"}})");
+
+    ConfigWatcher watcher(path.string());
+
+    std::mutex              mutex;
+    std::condition_variable condVar;
+    auto                    notified = false;
+
+    watcher.Subscribe("logging", [&](const ConfigSectionChange&) {
+        watcher.Stop();
+
+        std::lock_guard lock {mutex};
+
+        notified = true;
+        condVar.notify_all();
+    });
+
+    ASSERT_EQ(watcher.Start(), 0);
+
+    WriteFile(path, R"({"logging": {"level": "debug"}})");
+
+    std::unique_lock lock {mutex};
+
+    ASSERT_TRUE(condVar.wait_for(lock, std::chrono::seconds(5), [&] { return notified; }));
+    lock.unlock();
+
+    watcher.Stop();
+    EXPECT_EQ(watcher.Start(), 0);
+}
+
+TEST_F(ConfigWatcherTest, StartFailsOnInvalidConfig)
+{
+    ConfigWatcher missing((mDir / "missing.cfg").string());
+
+    EXPECT_EQ(missing.Start(), ENOENT);
+
+    auto path = mDir / "invalid.cfg";
+
+    WriteFile(path, "[]");
+
+    ConfigWatcher invalid(path.string());
+
+    EXPECT_EQ(invalid.Start(), EINVAL);
+}
+
+} // namespace aos::common::utils
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "utils/enumtable.hpp"
+
+using namespace testing;
+
+namespace aos::common::utils {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+enum class InstanceState { eActivating, eActive, eInactive, eFailed, eNumValues };
+
+enum class ProtoState { eUnknown, eActivating, eActive, eInactive, eFailed };
+
+constexpr EnumStringTable<InstanceState> cInstanceStates(std::array<EnumStringTable<InstanceState>::Entry, 4> {{
+    {"activating", InstanceState::eActivating},
+    {"active", InstanceState::eActive},
+    {"inactive", InstanceState::eInactive},
+    {"failed", InstanceState::eFailed},
+}});
+
+static_assert(cInstanceStates.IsValid());
+static_assert(cInstanceStates.IsPerfectHash());
+static_assert(cInstanceStates.FromString("failed") == InstanceState::eFailed);
+static_assert(cInstanceStates.ToString(InstanceState::eActive) == "active");
+
+// Value missing in the table is detected by the enum count.
+constexpr EnumStringTable<InstanceState> cIncompleteStates(std::array<EnumStringTable<InstanceState>::Entry, 3> {{
+    {"activating", InstanceState::eActivating},
+    {"active", InstanceState::eActive},
+    {"inactive", InstanceState::eInactive},
+}});
+
+static_assert(!cIncompleteStates.IsValid());
+
+constexpr EnumStringTable<InstanceState> cDuplicatedStates(std::array<EnumStringTable<InstanceState>::Entry, 4> {{
+    {"activating", InstanceState::eActivating},
+    {"active", InstanceState::eActive},
+    {"inactive", InstanceState::eInactive},
+    {"failed", InstanceState::eActive},
+}});
+
+static_assert(!cDuplicatedStates.IsValid());
+
+constexpr EnumStringTable<InstanceState> cDuplicatedNames(std::array<EnumStringTable<InstanceState>::Entry, 4> {{
+    {"activating", InstanceState::eActivating},
+    {"active", InstanceState::eActive},
+    {"inactive", InstanceState::eInactive},
+    {"active", InstanceState::eFailed},
+}});
+
+static_assert(!cDuplicatedNames.IsValid());
+
+constexpr EnumMap<InstanceState, ProtoState> cProtoStates(std::array<EnumMap<InstanceState, ProtoState>::Entry, 4> {{
+    {InstanceState::eActivating, ProtoState::eActivating},
+    {InstanceState::eActive, ProtoState::eActive},
+    {InstanceState::eInactive, ProtoState::eInactive},
+    {InstanceState::eFailed, ProtoState::eFailed},
+}});
+
+static_assert(cProtoStates.IsValid());
+static_assert(cProtoStates.IsReversible());
+static_assert(cProtoStates.Convert(InstanceState::eFailed) == ProtoState::eFailed);
+static_assert(cProtoStates.ConvertBack(ProtoState::eInactive) == InstanceState::eInactive);
+static_assert(!cProtoStates.ConvertBack(ProtoState::eUnknown));
+
+// Many to one mapping can't be converted back.
+constexpr EnumMap<InstanceState, ProtoState> cCollapsedProtoStates(
+    std::array<EnumMap<InstanceState, ProtoState>::Entry, 4> {{
+        {InstanceState::eActivating, ProtoState::eActive},
+        {InstanceState::eActive, ProtoState::eActive},
+        {InstanceState::eInactive, ProtoState::eInactive},
+        {InstanceState::eFailed, ProtoState::eFailed},
+    }});
+
+static_assert(cCollapsedProtoStates.IsValid());
+static_assert(!cCollapsedProtoStates.IsReversible());
+
+constexpr EnumMap<InstanceState, ProtoState> cIncompleteProtoStates(
+    std::array<EnumMap<InstanceState, ProtoState>::Entry, 1> {{{InstanceState::eActive, ProtoState::eActive}}});
+
+static_assert(!cIncompleteProtoStates.IsValid());
+
+// Large generated enums: names are "v0000", "v0001", ...
+template <size_t cCount>
+struct GeneratedNames {
+    static constexpr size_t cNameSize = 5;
+
+    constexpr GeneratedNames()
+    {
+        for (size_t i = 0; i < cCount; i++) {
+            mData[i * cNameSize]     = 'v';
+            mData[i * cNameSize + 1] = static_cast<char>('0' + i / 1000 % 10);
+            mData[i * cNameSize + 2] = static_cast<char>('0' + i / 100 % 10);
+            mData[i * cNameSize + 3] = static_cast<char>('0' + i / 10 % 10);
+            mData[i * cNameSize + 4] = static_cast<char>('0' + i % 10);
+        }
+    }
+
+    constexpr std::string_view Get(size_t index) const { return {&mData[index * cNameSize], cNameSize}; }
+
+    char mData[cCount * cNameSize] {};
+};
+
+template <typename Enum, size_t cCount>
+struct GeneratedTable {
+    static constexpr GeneratedNames<cCount> cNames {};
+
+    static constexpr auto CreateEntries()
+    {
+        std::array<typename EnumStringTable<Enum>::Entry, cCount> entries {};
+
+        // Reversed order: table doesn't rely on entries order. std::pair assignment is not constexpr in C++17.
+        for (size_t i = 0; i < cCount; i++) {
+            entries[i].first  = cNames.Get(cCount - 1 - i);
+            entries[i].second = static_cast<Enum>(cCount - 1 - i);
+        }
+
+        return entries;
+    }
+
+    static constexpr EnumStringTable<Enum> cTable {CreateEntries()};
+};
+
+enum class MediumEnum : uint16_t { eNumValues = 64 };
+// Too large for perfect hash seed search: binary search is used.
+enum class LargeEnum : uint16_t { eNumValues = 1000 };
+
+using MediumTable = GeneratedTable<MediumEnum, 64>;
+using LargeTable  = GeneratedTable<LargeEnum, 1000>;
+
+static_assert(MediumTable::cTable.IsValid());
+static_assert(MediumTable::cTable.IsPerfectHash());
+static_assert(MediumTable::cTable.FromString("v0063") == static_cast<MediumEnum>(63));
+
+static_assert(LargeTable::cTable.IsValid());
+static_assert(!LargeTable::cTable.IsPerfectHash());
+static_assert(LargeTable::cTable.FromString("v0000") == static_cast<LargeEnum>(0));
+static_assert(LargeTable::cTable.FromString("v0999") == static_cast<LargeEnum>(999));
+static_assert(!LargeTable::cTable.FromString("v1000"));
+
+// Duplicated name in a table too large for perfect hash.
+constexpr auto CreateDuplicatedLargeEntries()
+{
+    auto entries = LargeTable::CreateEntries();
+
+    entries[500].first = entries[0].first;
+
+    return entries;
+}
+
+constexpr EnumStringTable<LargeEnum> cDuplicatedLargeTable {CreateDuplicatedLargeEntries()};
+
+static_assert(!cDuplicatedLargeTable.IsValid());
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST(EnumTableTest, StringTable)
+{
+    for (auto state : {InstanceState::eActivating, InstanceState::eActive, InstanceState::eInactive,
+             InstanceState::eFailed}) {
+        EXPECT_EQ(cInstanceStates.FromString(cInstanceStates.ToString(state)), state);
+    }
+
+    EXPECT_FALSE(cInstanceStates.FromString("unknown"));
+    EXPECT_FALSE(cInstanceStates.FromString(""));
+    EXPECT_TRUE(cInstanceStates.ToString(InstanceState::eNumValues).empty());
+}
+
+TEST(EnumTableTest, LargeStringTable)
+{
+    for (size_t i = 0; i < 64; i++) {
+        EXPECT_EQ(MediumTable::cTable.FromString(MediumTable::cNames.Get(i)), static_cast<MediumEnum>(i));
+    }
+
+    for (size_t i = 0; i < 1000; i++) {
+        auto name = LargeTable::cNames.Get(i);
+
+        EXPECT_EQ(LargeTable::cTable.ToString(static_cast<LargeEnum>(i)), name);
+        EXPECT_EQ(LargeTable::cTable.FromString(name), static_cast<LargeEnum>(i));
+    }
+
+    EXPECT_FALSE(LargeTable::cTable.FromString("v"));
+    EXPECT_FALSE(LargeTable::cTable.FromString("w0000"));
+    EXPECT_FALSE(LargeTable::cTable.FromString("v99999"));
+}
+
+TEST(EnumTableTest, EnumMap)
+{
+    EXPECT_EQ(cProtoStates.Convert(InstanceState::eActivating), ProtoState::eActivating);
+    EXPECT_FALSE(cProtoStates.Convert(InstanceState::eNumValues));
+
+    for (auto state : {InstanceState::eActivating, InstanceState::eActive, InstanceState::eInactive,
+             InstanceState::eFailed}) {
+        EXPECT_EQ(cProtoStates.ConvertBack(*cProtoStates.Convert(state)), state);
+    }
+
+    EXPECT_FALSE(cProtoStates.ConvertBack(ProtoState::eUnknown));
+}
+
+} // namespace aos::common::utils
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "utils/exception.hpp"
+
+using namespace testing;
+
+namespace aos::common::utils {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+__attribute__((noinline)) void ThrowAosException()
+{
+    throw AosException("can't open file", ENOENT);
+}
+
+template <typename Exception, typename Func>
+double MeasureThrowCatch(Func func, size_t count, bool callWhat = false)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < count; i++) {
+        try {
+            func();
+        } catch (const Exception& e) {
+            if (callWhat) {
+                EXPECT_NE(e.what(), nullptr);
+            }
+        }
+    }
+
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+        / static_cast<double>(count);
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST(AosExceptionTest, LazyWhat)
+{
+    try {
+        ThrowAosException();
+        FAIL() << "exception expected";
+    } catch (const AosException& e) {
+        EXPECT_EQ(e.GetMessage(), "can't open file");
+        EXPECT_EQ(e.GetError(), ENOENT);
+        EXPECT_GT(e.GetStackTrace().Size(), 0);
+
+        std::string what = e.what();
+
+        EXPECT_EQ(what.rfind("can't open file: No such file or directory\n#0 ", 0), 0) << what;
+        EXPECT_EQ(e.what(), e.what());
+    }
+}
+
+TEST(AosExceptionTest, CatchAsStdException)
+{
+    try {
+        throw AosException("failed");
+    } catch (const std::exception& e) {
+        EXPECT_EQ(std::string(e.what()).rfind("failed\n", 0), 0);
+    }
+}
+
+// Run with --gtest_also_run_disabled_tests.
+TEST(AosExceptionTest, DISABLED_ThrowCatchBenchmark)
+{
+    constexpr size_t cCount = 100000;
+
+    auto plain = MeasureThrowCatch<std::runtime_error>([] { throw std::runtime_error("parse error"); }, cCount);
+    auto aos   = MeasureThrowCatch<AosException>([] { throw AosException("parse error", EINVAL); }, cCount);
+    auto what  = MeasureThrowCatch<AosException>([] { throw AosException("parse error", EINVAL); }, cCount / 10, true);
+
+    printf("throw/catch: std::runtime_error %.0f ns, AosException %.0f ns, AosException with what() %.0f ns\n", plain,
+        aos, what);
+}
+
+} // namespace aos::common::utils
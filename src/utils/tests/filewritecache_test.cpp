@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "utils/filewritecache.hpp"
+
+using namespace testing;
+
+namespace aos::common::utils {
+
+namespace fs = std::filesystem;
+
+/***********************************************************************************************************************
+ * Suite
+ **********************************************************************************************************************/
+
+class FileWriteCacheTest : public Test {
+protected:
+    void SetUp() override
+    {
+        mDir = fs::temp_directory_path() / ("filewritecache_test_" + std::to_string(getpid()));
+
+        fs::remove_all(mDir);
+        fs::create_directories(mDir);
+    }
+
+    void TearDown() override { fs::remove_all(mDir); }
+
+    static std::string ReadFile(const fs::path& path)
+    {
+        std::stringstream content;
+
+        content << std::ifstream(path).rdbuf();
+
+        return content.str();
+    }
+
+    fs::path mDir;
+};
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST_F(FileWriteCacheTest, WriteIfChanged)
+{
+    FileWriteCache cache;
+    bool           written = false;
+    const auto     path    = (mDir / "config.json").string();
+
+    ASSERT_EQ(cache.WriteIfChanged(path, "{}", written), 0);
+    EXPECT_TRUE(written);
+    EXPECT_EQ(ReadFile(path), "{}");
+    EXPECT_EQ(fs::status(path).permissions() & fs::perms::all, static_cast<fs::perms>(0644));
+
+    ASSERT_EQ(cache.WriteIfChanged(path, "{}", written), 0);
+    EXPECT_FALSE(written);
+
+    ASSERT_EQ(cache.WriteIfChanged(path, R"({"a":1})", written), 0);
+    EXPECT_TRUE(written);
+    EXPECT_EQ(ReadFile(path), R"({"a":1})");
+
+    // External change is detected.
+    std::ofstream(path) << "{}";
+
+    ASSERT_EQ(cache.WriteIfChanged(path, R"({"a":1})", written), 0);
+    EXPECT_TRUE(written);
+    EXPECT_EQ(ReadFile(path), R"({"a":1})");
+
+    // Unknown file with the same content is compared once.
+    FileWriteCache other;
+
+    ASSERT_EQ(other.WriteIfChanged(path, R"({"a":1})", written), 0);
+    EXPECT_FALSE(written);
+
+    auto stats = cache.GetStats();
+
+    EXPECT_EQ(stats.mWrites, 3u);
+    EXPECT_EQ(stats.mSkipped, 1u);
+
+    // No temporary files left.
+    EXPECT_EQ(std::distance(fs::directory_iterator(mDir), fs::directory_iterator()), 1);
+}
+
+TEST_F(FileWriteCacheTest, CachedStateSkipsReadBack)
+{
+    FileWriteCache cache;
+    bool           written = false;
+    const auto     path    = (mDir / "config.json").string();
+
+    ASSERT_EQ(cache.WriteIfChanged(path, "{}", written), 0);
+
+    // External change which keeps size, inode and modification time: the file is not read, cached hash is used.
+    struct stat st {};
+
+    ASSERT_EQ(stat(path.c_str(), &st), 0);
+
+    std::ofstream(path) << "[]";
+
+    const struct timespec times[] = {st.st_atim, st.st_mtim};
+
+    ASSERT_EQ(utimensat(AT_FDCWD, path.c_str(), times, 0), 0);
+
+    ASSERT_EQ(cache.WriteIfChanged(path, "[]", written), 0);
+    EXPECT_TRUE(written);
+}
+
+TEST_F(FileWriteCacheTest, KeepsMode)
+{
+    FileWriteCache cache;
+    bool           written = false;
+    const auto     path    = (mDir / "secret").string();
+
+    std::ofstream(path) << "old";
+    fs::permissions(path, static_cast<fs::perms>(0600));
+
+    ASSERT_EQ(cache.WriteIfChanged(path, "new", written), 0);
+    EXPECT_TRUE(written);
+    EXPECT_EQ(fs::status(path).permissions() & fs::perms::all, static_cast<fs::perms>(0600));
+
+    ASSERT_EQ(cache.WriteIfChanged(path, "newer", written), 0);
+    EXPECT_EQ(fs::status(path).permissions() & fs::perms::all, static_cast<fs::perms>(0600));
+}
+
+TEST_F(FileWriteCacheTest, WriteError)
+{
+    FileWriteCache cache;
+    bool           written = true;
+
+    EXPECT_EQ(cache.WriteIfChanged((mDir / "missing" / "config.json").string(), "{}", written), ENOENT);
+    EXPECT_FALSE(written);
+}
+
+TEST_F(FileWriteCacheTest, ConcurrentWriters)
+{
+    constexpr auto cThreadCount = 4;
+    constexpr auto cWriteCount  = 200;
+
+    FileWriteCache           cache;
+    const auto               path = (mDir / "state").string();
+    std::vector<std::thread> threads;
+
+    for (auto i = 0; i < cThreadCount; i++) {
+        threads.emplace_back([&, i]() {
+            for (auto j = 0; j < cWriteCount; j++) {
+                bool written = false;
+
+                EXPECT_EQ(cache.WriteIfChanged(path, std::string(static_cast<size_t>(i + 1), 'a' + j % 2), written), 0);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Cached state matches the file: rewriting the last content is skipped, other content is written.
+    auto content = ReadFile(path);
+    bool written = true;
+
+    ASSERT_EQ(cache.WriteIfChanged(path, content, written), 0);
+    EXPECT_FALSE(written);
+
+    ASSERT_EQ(cache.WriteIfChanged(path, content + "b", written), 0);
+    EXPECT_TRUE(written);
+    EXPECT_EQ(ReadFile(path), content + "b");
+
+    EXPECT_EQ(std::distance(fs::directory_iterator(mDir), fs::directory_iterator()), 1);
+}
+
+TEST_F(FileWriteCacheTest, Invalidate)
+{
+    FileWriteCache cache;
+    bool           written = false;
+    const auto     path    = (mDir / "config.json").string();
+
+    ASSERT_EQ(cache.WriteIfChanged(path, "{}", written), 0);
+
+    fs::remove(path);
+    cache.Invalidate(path);
+
+    ASSERT_EQ(cache.WriteIfChanged(path, "{}", written), 0);
+    EXPECT_TRUE(written);
+    EXPECT_EQ(ReadFile(path), "{}");
+}
+
+} // namespace aos::common::utils
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utils/jsonpath.hpp"
+#include "utils/jsonstreamparser.hpp"
+
+using namespace testing;
+
+namespace aos::common::utils {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Consts
+ **********************************************************************************************************************/
+
+constexpr auto cManifest = R"({
+    "schemaVersion": 2,
+    "config": {"digest": "sha256:c", "size": 7, "Env": ["PATH=/bin", "A=\"q\""]},
+    "layers": [
+        {"digest": "sha256:l0", "size": 1, "annotations": {"a": null, "b": [true, false]}},
+        {"digest": "sha256:l1", "size": 2.5e3}
+    ],
+    "rootfs": {"diff_ids": ["sha256:d0", "sha256:d1"]},
+    "tail": "x"
+})";
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+// Parses document in chunks, returns number of consumed bytes.
+uint64_t Parse(JSONPathQuery& query, std::string_view json, size_t chunkSize = SIZE_MAX)
+{
+    JSONStreamParser parser(query);
+
+    query.Reset();
+
+    for (size_t pos = 0; pos < json.size() && !parser.IsStopped(); pos += chunkSize) {
+        EXPECT_EQ(parser.Feed(json.substr(pos, chunkSize)), 0);
+    }
+
+    if (!parser.IsStopped()) {
+        EXPECT_EQ(parser.Finish(), 0);
+    }
+
+    return parser.GetOffset();
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST(JSONPathQueryTest, Compile)
+{
+    JSONPathQuery query;
+
+    EXPECT_EQ(query.Compile({"", "a", "a.b", "a[0]", "a[*].b", "[1][2]", "a[0][*]"}), 0);
+
+    for (const auto& path : {"a.", ".a", "a..b", "a[", "a[]", "a[-1]", "a[x]", "a[1]b"}) {
+        EXPECT_EQ(query.Compile({path}), EINVAL) << path;
+    }
+}
+
+TEST(JSONPathQueryTest, Matches)
+{
+    JSONPathQuery query;
+
+    ASSERT_EQ(query.Compile({"schemaVersion", "config.Env", "rootfs.diff_ids[1]", "layers[*].digest",
+                  "layers[0].annotations", "layers[*].size", "missing", "config.Env[5]"}),
+        0);
+
+    for (auto chunkSize : {size_t(1), size_t(7), SIZE_MAX}) {
+        Parse(query, cManifest, chunkSize);
+
+        EXPECT_FALSE(query.IsComplete());
+        EXPECT_EQ(query.GetMatches(0), std::vector<std::string>({"2"}));
+        EXPECT_EQ(query.GetMatches(1), std::vector<std::string>({R"(["PATH=/bin","A=\"q\""])"}));
+        EXPECT_EQ(query.GetMatches(2), std::vector<std::string>({R"("sha256:d1")"}));
+        EXPECT_EQ(query.GetMatches(3), std::vector<std::string>({R"("sha256:l0")", R"("sha256:l1")"}));
+        EXPECT_EQ(query.GetMatches(4), std::vector<std::string>({R"({"a":null,"b":[true,false]})"}));
+        EXPECT_EQ(query.GetMatches(5), std::vector<std::string>({"1", "2.5e3"}));
+        EXPECT_TRUE(query.GetMatches(6).empty());
+        EXPECT_TRUE(query.GetMatches(7).empty());
+    }
+}
+
+TEST(JSONPathQueryTest, Root)
+{
+    JSONPathQuery query;
+
+    ASSERT_EQ(query.Compile({""}), 0);
+
+    Parse(query, R"( {"a" : [1, {"b": "é\n"}], "c": {}} )");
+
+    EXPECT_TRUE(query.IsComplete());
+    EXPECT_EQ(query.GetMatches(0), std::vector<std::string>({"{\"a\":[1,{\"b\":\"\xc3\xa9\\n\"}],\"c\":{}}"}));
+
+    Parse(query, R"("str")");
+
+    EXPECT_EQ(query.GetMatches(0), std::vector<std::string>({R"("str")"}));
+}
+
+TEST(JSONPathQueryTest, StopsWhenComplete)
+{
+    JSONPathQuery query;
+
+    ASSERT_EQ(query.Compile({"schemaVersion", "config.digest"}), 0);
+
+    auto offset = Parse(query, cManifest);
+
+    EXPECT_TRUE(query.IsComplete());
+    EXPECT_EQ(query.GetMatches(1), std::vector<std::string>({R"("sha256:c")"}));
+    EXPECT_LT(offset, std::string_view(cManifest).find("Env"));
+
+    // Wildcard query completes when its array is closed.
+    ASSERT_EQ(query.Compile({"layers[*].digest"}), 0);
+
+    offset = Parse(query, cManifest);
+
+    EXPECT_TRUE(query.IsComplete());
+    EXPECT_EQ(query.GetMatches(0).size(), 2);
+    EXPECT_LT(offset, std::string_view(cManifest).find("rootfs"));
+}
+
+TEST(JSONPathQueryTest, Reset)
+{
+    JSONPathQuery query;
+
+    ASSERT_EQ(query.Compile({"a"}), 0);
+
+    Parse(query, R"({"a": 1})");
+    ASSERT_EQ(query.GetMatches(0), std::vector<std::string>({"1"}));
+
+    Parse(query, R"({"a": 2})");
+    EXPECT_EQ(query.GetMatches(0), std::vector<std::string>({"2"}));
+}
+
+} // namespace aos::common::utils
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <filesystem>
+#include <fstream>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "utils/jsonstreamparser.hpp"
+
+using namespace testing;
+
+namespace aos::common::utils {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+// Records events as space separated tokens: { } [ ] k:<key> s:<string> n:<number> true false null.
+class EventRecorder : public JSONEventHandler {
+public:
+    explicit EventRecorder(size_t stopAfter = SIZE_MAX)
+        : mStopAfter(stopAfter)
+    {
+    }
+
+    bool OnObjectBegin() override { return Add("{"); }
+    bool OnObjectEnd() override { return Add("}"); }
+    bool OnArrayBegin() override { return Add("["); }
+    bool OnArrayEnd() override { return Add("]"); }
+    bool OnKey(std::string_view key) override { return Add("k:" + std::string(key)); }
+
+    bool OnScalar(JSONScalarType type, std::string_view value) override
+    {
+        switch (type) {
+        case JSONScalarType::eString:
+            return Add("s:" + std::string(value));
+
+        case JSONScalarType::eNumber:
+            return Add("n:" + std::string(value));
+
+        default:
+            return Add(std::string(value));
+        }
+    }
+
+    const std::string& GetEvents() const { return mEvents; }
+
+private:
+    bool Add(const std::string& event)
+    {
+        if (!mEvents.empty()) {
+            mEvents += ' ';
+        }
+
+        mEvents += event;
+
+        return ++mCount < mStopAfter;
+    }
+
+    size_t      mStopAfter;
+    size_t      mCount = 0;
+    std::string mEvents;
+};
+
+int Parse(std::string_view json, std::string& events, size_t chunkSize = SIZE_MAX)
+{
+    EventRecorder    recorder;
+    JSONStreamParser parser(recorder);
+
+    for (size_t pos = 0; pos < json.size(); pos += chunkSize) {
+        if (auto err = parser.Feed(json.substr(pos, chunkSize)); err != 0) {
+            events = recorder.GetEvents();
+
+            return err;
+        }
+    }
+
+    auto err = parser.Finish();
+
+    events = recorder.GetEvents();
+
+    return err;
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST(JSONStreamParserTest, Events)
+{
+    const std::string json
+        = R"( {"id":"app","args":["-v",""],"limits":{"cpu":-1.5e+3,"mem":0},"on":true,"off":false,"x":null,"e":{}} )";
+    const std::string expected
+        = "{ k:id s:app k:args [ s:-v s: ] k:limits { k:cpu n:-1.5e+3 k:mem n:0 } k:on true k:off false k:x null k:e { "
+          "} }";
+
+    // Any chunking produces the same events.
+    for (size_t chunkSize : {json.size(), size_t(1), size_t(2), size_t(7)}) {
+        std::string events;
+
+        ASSERT_EQ(Parse(json, events, chunkSize), 0) << "chunk size " << chunkSize;
+        EXPECT_EQ(events, expected) << "chunk size " << chunkSize;
+    }
+}
+
+TEST(JSONStreamParserTest, RootScalars)
+{
+    std::string events;
+
+    EXPECT_EQ(Parse("42", events, 1), 0);
+    EXPECT_EQ(events, "n:42");
+
+    EXPECT_EQ(Parse(" -0.5 ", events), 0);
+    EXPECT_EQ(events, "n:-0.5");
+
+    EXPECT_EQ(Parse("\"str\"", events, 1), 0);
+    EXPECT_EQ(events, "s:str");
+
+    EXPECT_EQ(Parse("null", events, 1), 0);
+    EXPECT_EQ(events, "null");
+}
+
+TEST(JSONStreamParserTest, Escapes)
+{
+    std::string events;
+
+    EXPECT_EQ(Parse(R"(["\"\\\/\b\f\n\r\t", "\u0041\u00e9\u20ac", "\ud83d\ude00"])", events, 1), 0);
+    EXPECT_EQ(events, "[ s:\"\\/\b\f\n\r\t s:A\u00e9\u20ac s:\U0001F600 ]");
+
+    // Lone and mismatched surrogates.
+    EXPECT_EQ(Parse(R"("\ud83d")", events), EINVAL);
+    EXPECT_EQ(Parse(R"("\ude00")", events), EINVAL);
+    EXPECT_EQ(Parse(R"("\ud83d\n")", events), EINVAL);
+    EXPECT_EQ(Parse(R"("\ud83d\u0041")", events), EINVAL);
+
+    EXPECT_EQ(Parse(R"("\x")", events), EINVAL);
+    EXPECT_EQ(Parse(R"("\u12g4")", events), EINVAL);
+    EXPECT_EQ(Parse("\"a\nb\"", events), EINVAL);
+}
+
+TEST(JSONStreamParserTest, Malformed)
+{
+    for (auto json : {"", "{", "[1,]", "[1 2]", "{\"a\"}", "{\"a\":1,}", "{1:2}", "[1}", "{\"a\":1]", "01", "1.", "-",
+             "1e", ".5", "+1", "tru", "trux", "nul", "[] []", "\"abc", "{\"a\" 1}"}) {
+        std::string events;
+
+        EXPECT_EQ(Parse(json, events), EINVAL) << json;
+        EXPECT_EQ(Parse(json, events, 1), EINVAL) << json;
+    }
+}
+
+TEST(JSONStreamParserTest, ErrorOffset)
+{
+    EventRecorder    recorder;
+    JSONStreamParser parser(recorder);
+
+    EXPECT_EQ(parser.Feed(R"({"a":[1,)"), 0);
+    EXPECT_EQ(parser.Feed(R"( 2, x])"), EINVAL);
+    EXPECT_EQ(parser.GetOffset(), 12u);
+
+    // Error is sticky.
+    EXPECT_EQ(parser.Feed("]}"), EINVAL);
+    EXPECT_EQ(parser.Finish(), EINVAL);
+
+    parser.Reset();
+
+    EXPECT_EQ(parser.Feed("[]"), 0);
+    EXPECT_EQ(parser.Finish(), 0);
+    EXPECT_TRUE(parser.IsDone());
+    EXPECT_EQ(parser.GetOffset(), 2u);
+}
+
+TEST(JSONStreamParserTest, MaxDepth)
+{
+    EventRecorder    recorder;
+    JSONStreamParser parser(recorder, 3);
+
+    EXPECT_EQ(parser.Feed("[[[]]]"), 0);
+    EXPECT_EQ(parser.Finish(), 0);
+
+    parser.Reset();
+
+    EXPECT_EQ(parser.Feed("[[{\"a\":[]}]]"), E2BIG);
+    EXPECT_EQ(parser.GetOffset(), 7u);
+}
+
+TEST(JSONStreamParserTest, StopByHandler)
+{
+    EventRecorder    recorder(3);
+    JSONStreamParser parser(recorder);
+
+    EXPECT_EQ(parser.Feed(R"({"a":1,"b":2})"), 0);
+    EXPECT_TRUE(parser.IsStopped());
+    EXPECT_EQ(parser.Finish(), 0);
+    EXPECT_EQ(recorder.GetEvents(), "{ k:a n:1");
+}
+
+TEST(JSONStreamParserTest, ParseJSONFile)
+{
+    const auto path
+        = std::filesystem::temp_directory_path() / ("jsonstreamparser_test_" + std::to_string(getpid()) + ".json");
+
+    std::ofstream(path) << R"({"list":[1,2,3],"name":"test"})";
+
+    EventRecorder recorder;
+
+    EXPECT_EQ(ParseJSONFile(path.string(), recorder, 3), 0);
+    EXPECT_EQ(recorder.GetEvents(), "{ k:list [ n:1 n:2 n:3 ] k:name s:test }");
+
+    EventRecorder stopped(2);
+
+    EXPECT_EQ(ParseJSONFile(path.string(), stopped, 3), 0);
+    EXPECT_EQ(stopped.GetEvents(), "{ k:list");
+
+    std::ofstream(path) << R"({"list":[1,2,3)";
+
+    EventRecorder truncated;
+
+    EXPECT_EQ(ParseJSONFile(path.string(), truncated), EINVAL);
+
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(ParseJSONFile(path.string(), truncated), ENOENT);
+}
+
+} // namespace aos::common::utils
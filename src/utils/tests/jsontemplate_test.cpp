@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+
+#include <gtest/gtest.h>
+
+#include "utils/jsontemplate.hpp"
+
+using namespace testing;
+
+namespace aos::common::utils {
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST(JSONTemplateTest, Render)
+{
+    JSONTemplate jsonTemplate;
+
+    // Slot type conflict.
+    ASSERT_EQ(jsonTemplate.Compile(R"({"id":"@@str:id@@","args":["@@raw:id@@"]})"), EINVAL);
+
+    ASSERT_EQ(jsonTemplate.Compile(R"({"id":"@@str:id@@","env":"@@raw:env@@","args":["@@str:id@@"]})"), 0);
+    ASSERT_EQ(jsonTemplate.GetSlotCount(), 2u);
+    ASSERT_EQ(jsonTemplate.GetSlot("id"), 0);
+    ASSERT_EQ(jsonTemplate.GetSlot("env"), 1);
+    EXPECT_EQ(jsonTemplate.GetSlot("unknown"), -1);
+
+    std::string out;
+
+    jsonTemplate.Render({"in\"st\n", R"(["A=1"])"}, out);
+    EXPECT_EQ(out, R"({"id":"in\"st\n","env":["A=1"],"args":["in\"st\n"]})");
+
+    jsonTemplate.Render({}, out);
+    EXPECT_EQ(out, R"({"id":"","env":null,"args":[""]})");
+}
+
+TEST(JSONTemplateTest, PlaceholderInsideString)
+{
+    JSONTemplate jsonTemplate;
+
+    // "@@ after escaped quote is a part of the string value, not a placeholder.
+    const std::string skeleton = R"({"cmd":"echo \"@@str:id@@\"","id":"@@str:id@@","path":"C:\\","x":"@@raw:x@@"})";
+
+    ASSERT_EQ(jsonTemplate.Compile(skeleton), 0);
+    ASSERT_EQ(jsonTemplate.GetSlotCount(), 2u);
+
+    std::string out;
+
+    jsonTemplate.Render({"abc", "1"}, out);
+    EXPECT_EQ(out, R"({"cmd":"echo \"@@str:id@@\"","id":"abc","path":"C:\\","x":1})");
+}
+
+TEST(JSONTemplateTest, CompileErrorClearsTemplate)
+{
+    JSONTemplate jsonTemplate;
+    std::string  out;
+
+    ASSERT_EQ(jsonTemplate.Compile(R"({"id":"@@str:id@@"})"), 0);
+
+    EXPECT_EQ(jsonTemplate.Compile(R"({"id":"@@str:id@@","bad":"@@int:x@@"})"), EINVAL);
+    EXPECT_EQ(jsonTemplate.GetSlotCount(), 0u);
+    EXPECT_EQ(jsonTemplate.GetSlot("id"), -1);
+
+    jsonTemplate.Render({"abc"}, out);
+    EXPECT_TRUE(out.empty());
+
+    EXPECT_EQ(jsonTemplate.Compile(R"({"id":"@@str:id)"), EINVAL);
+    EXPECT_EQ(jsonTemplate.GetSlotCount(), 0u);
+}
+
+TEST(JSONTemplateTest, AppendJSONString)
+{
+    std::string out;
+
+    AppendJSONString(out, std::string_view("a\\b\"c\td\x01\x1f", 9));
+    EXPECT_EQ(out, R"("a\\b\"c\td\u0001\u001f")");
+}
+
+} // namespace aos::common::utils
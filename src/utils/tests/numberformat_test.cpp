@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "utils/numberformat.hpp"
+
+using namespace testing;
+
+namespace aos::common::utils {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+template <typename T>
+std::string Format(T value, int precision = -1)
+{
+    NumberString number(value, precision);
+
+    EXPECT_EQ(number.GetError(), 0);
+
+    std::string str;
+
+    AppendNumber(str, value, precision);
+    EXPECT_EQ(str, number.View());
+
+    return str;
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST(NumberFormatTest, IntegerLimits)
+{
+    EXPECT_EQ(Format(0), "0");
+    EXPECT_EQ(Format(std::numeric_limits<int8_t>::min()), "-128");
+    EXPECT_EQ(Format(std::numeric_limits<uint8_t>::max()), "255");
+    EXPECT_EQ(Format(std::numeric_limits<int32_t>::min()), "-2147483648");
+    EXPECT_EQ(Format(std::numeric_limits<uint32_t>::max()), "4294967295");
+    EXPECT_EQ(Format(std::numeric_limits<int64_t>::min()), "-9223372036854775808");
+    EXPECT_EQ(Format(std::numeric_limits<int64_t>::max()), "9223372036854775807");
+    EXPECT_EQ(Format(std::numeric_limits<uint64_t>::max()), "18446744073709551615");
+}
+
+TEST(NumberFormatTest, FloatingPointLimits)
+{
+    EXPECT_EQ(Format(0.1), "0.1");
+    EXPECT_EQ(Format(std::numeric_limits<double>::max()), "1.7976931348623157e+308");
+    EXPECT_EQ(Format(std::numeric_limits<double>::lowest()), "-1.7976931348623157e+308");
+    EXPECT_EQ(Format(std::numeric_limits<double>::denorm_min()), "5e-324");
+    EXPECT_EQ(Format(std::numeric_limits<float>::max()), "3.4028235e+38");
+}
+
+TEST(NumberFormatTest, SpecialValues)
+{
+    EXPECT_EQ(Format(-0.0), "-0");
+    EXPECT_EQ(Format(-0.0, 2), "-0.00");
+    EXPECT_EQ(Format(std::numeric_limits<double>::infinity()), "inf");
+    EXPECT_EQ(Format(-std::numeric_limits<double>::infinity()), "-inf");
+    EXPECT_EQ(Format(std::numeric_limits<double>::quiet_NaN()), "nan");
+    EXPECT_EQ(Format(-std::numeric_limits<double>::quiet_NaN()), "-nan");
+    EXPECT_EQ(Format(std::numeric_limits<double>::infinity(), 3), "inf");
+}
+
+TEST(NumberFormatTest, Precision)
+{
+    EXPECT_EQ(Format(1.0 / 3, 3), "0.333");
+    EXPECT_EQ(Format(2.5, 0), "2");
+    EXPECT_EQ(Format(42, 3), "42");
+}
+
+TEST(NumberFormatTest, Overflow)
+{
+    auto value = std::numeric_limits<double>::max();
+
+    NumberString number(value, 2);
+
+    EXPECT_EQ(number.GetError(), EOVERFLOW);
+    EXPECT_TRUE(number.View().empty());
+
+    // Appended value is formatted in growing buffer.
+    std::string str = "value: ";
+
+    AppendNumber(str, value, 2);
+
+    EXPECT_EQ(str.size(), 7 + 309 + 3);
+    EXPECT_EQ(str.compare(0, 12, "value: 17976"), 0);
+    EXPECT_EQ(str.compare(str.size() - 3, 3, ".00"), 0);
+
+    char buffer[4];
+
+    EXPECT_EQ(FormatNumber(buffer, buffer + sizeof(buffer), 12345), nullptr);
+    EXPECT_EQ(FormatNumber(buffer, buffer + sizeof(buffer), 1234), buffer + 4);
+}
+
+} // namespace aos::common::utils
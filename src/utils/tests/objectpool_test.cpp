@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utils/objectpool.hpp"
+
+using namespace testing;
+
+namespace aos::common::utils {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+struct Buffer {
+    void Clear()
+    {
+        mData.clear();
+        mCleared++;
+    }
+
+    std::string mData;
+    size_t      mCleared = 0;
+};
+
+// Counts reset calls, fails for marked objects.
+struct CountingReset {
+    void operator()(std::string& object) const
+    {
+        (*mCount)++;
+
+        if (object == "throw") {
+            throw std::runtime_error("reset failed");
+        }
+
+        object.clear();
+    }
+
+    std::shared_ptr<std::atomic_size_t> mCount = std::make_shared<std::atomic_size_t>(0);
+};
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST(ObjectPoolTest, Reuse)
+{
+    ObjectPool<Buffer> pool(2);
+
+    Buffer* first = nullptr;
+
+    {
+        auto buffer = pool.Acquire();
+
+        buffer->mData.assign(1024, 'x');
+        first = buffer.get();
+    }
+
+    auto buffer = pool.Acquire();
+
+    // The same object is reused: cleared but keeps its capacity.
+    EXPECT_EQ(buffer.get(), first);
+    EXPECT_TRUE(buffer->mData.empty());
+    EXPECT_GE(buffer->mData.capacity(), 1024u);
+    EXPECT_EQ(buffer->mCleared, 1u);
+
+    auto stats = pool.GetStats();
+
+    EXPECT_EQ(stats.mCreated, 1u);
+    EXPECT_EQ(stats.mReused, 1u);
+    EXPECT_EQ(stats.mReleased, 1u);
+    EXPECT_EQ(stats.mIdle, 0u);
+}
+
+TEST(ObjectPoolTest, ResetsOnlyKeptObjects)
+{
+    CountingReset                          reset;
+    ObjectPool<std::string, CountingReset> pool(2, reset);
+    std::vector<decltype(pool)::Handle>    handles;
+
+    for (auto i = 0; i < 5; i++) {
+        handles.push_back(pool.Acquire());
+    }
+
+    handles.clear();
+
+    EXPECT_EQ(*reset.mCount, 2u);
+
+    auto stats = pool.GetStats();
+
+    EXPECT_EQ(stats.mReleased, 5u);
+    EXPECT_EQ(stats.mDropped, 3u);
+    EXPECT_EQ(stats.mIdle, 2u);
+
+    // Object which reset fails for is not kept.
+    auto object = pool.Acquire();
+
+    *object = "throw";
+    object.reset();
+
+    EXPECT_EQ(pool.GetStats().mIdle, 1u);
+    EXPECT_EQ(pool.GetStats().mDropped, 4u);
+}
+
+TEST(ObjectPoolTest, ReserveAndShrink)
+{
+    ObjectPool<std::string> pool(4);
+
+    pool.Reserve(10);
+    EXPECT_EQ(pool.GetStats().mIdle, 4u);
+    EXPECT_EQ(pool.GetStats().mCreated, 4u);
+
+    pool.Shrink();
+    EXPECT_EQ(pool.GetStats().mIdle, 0u);
+
+    auto object = pool.Acquire();
+
+    EXPECT_EQ(pool.GetStats().mCreated, 5u);
+}
+
+TEST(ObjectPoolTest, HandleOutlivesPool)
+{
+    ObjectPool<std::string>::Handle object;
+
+    {
+        ObjectPool<std::string> pool(1);
+
+        object  = pool.Acquire();
+        *object = "alive";
+    }
+
+    EXPECT_EQ(*object, "alive");
+    object.reset();
+}
+
+TEST(ObjectPoolTest, ConcurrentAcquireRelease)
+{
+    constexpr auto cThreadCount = 4;
+    constexpr auto cIterations  = 2000;
+    constexpr auto cMaxIdle     = 3u;
+
+    ObjectPool<Buffer>       pool(cMaxIdle);
+    std::vector<std::thread> threads;
+
+    for (auto i = 0; i < cThreadCount; i++) {
+        threads.emplace_back([&]() {
+            for (auto j = 0; j < cIterations; j++) {
+                auto first  = pool.Acquire();
+                auto second = pool.Acquire();
+
+                EXPECT_TRUE(first->mData.empty());
+                first->mData  = "data";
+                second->mData = "data";
+
+                EXPECT_LE(pool.GetStats().mIdle, cMaxIdle);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto stats = pool.GetStats();
+
+    EXPECT_EQ(stats.mReleased, 2u * cThreadCount * cIterations);
+    EXPECT_EQ(stats.mCreated + stats.mReused, stats.mReleased);
+    EXPECT_EQ(stats.mIdle + stats.mDropped + stats.mReused, stats.mReleased);
+    EXPECT_LE(stats.mIdle, cMaxIdle);
+}
+
+} // namespace aos::common::utils
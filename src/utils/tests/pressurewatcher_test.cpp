@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <cstdlib>
+#include <filesystem>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "utils/pressurewatcher.hpp"
+
+using namespace testing;
+
+namespace aos::common::utils {
+
+namespace fs = std::filesystem;
+
+/***********************************************************************************************************************
+ * Suite
+ **********************************************************************************************************************/
+
+class PressureWatcherTest : public Test {
+protected:
+    void SetUp() override
+    {
+        ASSERT_EQ(mWatcher.GetInitError(), 0);
+
+        mDir = fs::temp_directory_path() / ("pressurewatcher_test_" + std::to_string(getpid()));
+
+        fs::remove_all(mDir);
+        fs::create_directories(mDir);
+    }
+
+    void TearDown() override
+    {
+        if (mMasterFD >= 0) {
+            close(mMasterFD);
+        }
+
+        fs::remove_all(mDir);
+    }
+
+    // Fake cgroup: pressure file is a pseudo terminal which fails with EPOLLERR | EPOLLHUP once master is closed, as
+    // pressure file of removed cgroup does.
+    int CreateFakeCGroup(std::string& cgroupPath)
+    {
+        mMasterFD = posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+        if (mMasterFD < 0 || grantpt(mMasterFD) != 0 || unlockpt(mMasterFD) != 0) {
+            return errno;
+        }
+
+        cgroupPath = (mDir / "cgroup").string();
+
+        fs::create_directories(cgroupPath);
+        fs::create_symlink(ptsname(mMasterFD), fs::path(cgroupPath) / "memory.pressure");
+
+        return 0;
+    }
+
+    void RemoveFakeCGroup()
+    {
+        close(mMasterFD);
+        mMasterFD = -1;
+    }
+
+    PressureWatcher mWatcher;
+    fs::path        mDir;
+    int             mMasterFD = -1;
+};
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST_F(PressureWatcherTest, Timeout)
+{
+    std::vector<PressureEvent> events {{"stale"}};
+
+    EXPECT_EQ(mWatcher.Wait(std::chrono::milliseconds(10), events), 0);
+    EXPECT_TRUE(events.empty());
+}
+
+TEST_F(PressureWatcherTest, Interrupt)
+{
+    std::vector<PressureEvent> events;
+
+    std::thread interrupter([this] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        mWatcher.Interrupt();
+    });
+
+    auto start = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(mWatcher.Wait(std::chrono::seconds(10), events), 0);
+    EXPECT_TRUE(events.empty());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+
+    interrupter.join();
+}
+
+TEST_F(PressureWatcherTest, AddAndRemove)
+{
+    EXPECT_EQ(mWatcher.AddCGroupTrigger("missing", (mDir / "missing").string(), {}), ENOENT);
+    EXPECT_EQ(mWatcher.Remove("missing"), ENOENT);
+
+    std::string cgroupPath;
+
+    ASSERT_EQ(CreateFakeCGroup(cgroupPath), 0);
+    ASSERT_EQ(mWatcher.AddCGroupTrigger("service", cgroupPath, {}), 0);
+
+    EXPECT_EQ(mWatcher.Remove("service"), 0);
+    EXPECT_EQ(mWatcher.Remove("service"), ENOENT);
+
+    // Removed trigger is not reported.
+    RemoveFakeCGroup();
+
+    std::vector<PressureEvent> events;
+
+    EXPECT_EQ(mWatcher.Wait(std::chrono::milliseconds(10), events), 0);
+    EXPECT_TRUE(events.empty());
+}
+
+TEST_F(PressureWatcherTest, CGroupRemoved)
+{
+    std::string cgroupPath;
+
+    ASSERT_EQ(CreateFakeCGroup(cgroupPath), 0);
+    ASSERT_EQ(mWatcher.AddCGroupTrigger("service", cgroupPath, {}), 0);
+
+    std::vector<PressureEvent> events;
+
+    EXPECT_EQ(mWatcher.Wait(std::chrono::milliseconds(10), events), 0);
+    EXPECT_TRUE(events.empty());
+
+    RemoveFakeCGroup();
+
+    EXPECT_EQ(mWatcher.Wait(std::chrono::seconds(1), events), 0);
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_EQ(events[0].mID, "service");
+    EXPECT_EQ(events[0].mResource, PressureResource::eMemory);
+    EXPECT_EQ(events[0].mError, ENODEV);
+
+    // Failed trigger is reported once and dropped: next Wait times out instead of spinning.
+    auto start = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(mWatcher.Wait(std::chrono::milliseconds(100), events), 0);
+    EXPECT_TRUE(events.empty());
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(90));
+    EXPECT_EQ(mWatcher.Remove("service"), ENOENT);
+}
+
+} // namespace aos::common::utils
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <filesystem>
+#include <fstream>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "utils/resourcesampler.hpp"
+
+using namespace testing;
+
+namespace aos::common::utils {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/***********************************************************************************************************************
+ * Consts
+ **********************************************************************************************************************/
+
+constexpr size_t cMaxFileSize = 1024 * 1024;
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Suite
+ **********************************************************************************************************************/
+
+class ResourceSamplerTest : public Test {
+protected:
+    void SetUp() override
+    {
+        mCGroup = fs::temp_directory_path() / ("resourcesampler_test_" + std::to_string(getpid()));
+
+        fs::remove_all(mCGroup);
+        fs::create_directories(mCGroup);
+
+        // File content is replaced in place: sampler keeps files open.
+        WriteFile("cpu.stat", "usage_usec 1000000\nuser_usec 600000\nsystem_usec 400000\n");
+        WriteFile("memory.current", "8192\n");
+        WriteFile("io.stat", "8:0 rbytes=100 wbytes=200 rios=1 wios=2\n8:16 rbytes=1000 wbytes=2000 rios=3 wios=4\n");
+    }
+
+    void TearDown() override { fs::remove_all(mCGroup); }
+
+    void WriteFile(const std::string& name, const std::string& content)
+    {
+        std::ofstream(mCGroup / name, std::ios::trunc) << content;
+    }
+
+    fs::path mCGroup;
+};
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST_F(ResourceSamplerTest, CGroup)
+{
+    ResourceSampler             sampler;
+    std::vector<ResourceSample> samples;
+
+    ASSERT_EQ(sampler.AddCGroup("service", mCGroup.string()), 0);
+
+    sampler.Sample(samples);
+
+    ASSERT_EQ(samples.size(), 1);
+    EXPECT_EQ(samples[0].mID, "service");
+    EXPECT_EQ(samples[0].mError, 0);
+    EXPECT_EQ(samples[0].mUsage.mCPUTimeUSec, 1000000);
+    EXPECT_EQ(samples[0].mUsage.mCPU, 0.0);
+    EXPECT_EQ(samples[0].mUsage.mRAM, 8192);
+    EXPECT_EQ(samples[0].mUsage.mIOReadBytes, 1100);
+    EXPECT_EQ(samples[0].mUsage.mIOWriteBytes, 2200);
+
+    WriteFile("cpu.stat", "usage_usec 900000000000\n");
+    usleep(1000);
+
+    sampler.Sample(samples);
+
+    ASSERT_EQ(samples.size(), 1);
+    EXPECT_EQ(samples[0].mError, 0);
+    EXPECT_EQ(samples[0].mUsage.mCPUTimeUSec, 900000000000);
+    EXPECT_GT(samples[0].mUsage.mCPU, 0.0);
+}
+
+TEST_F(ResourceSamplerTest, CGroupWithoutIO)
+{
+    ResourceSampler             sampler;
+    std::vector<ResourceSample> samples;
+
+    fs::remove(mCGroup / "io.stat");
+
+    ASSERT_EQ(sampler.AddCGroup("service", mCGroup.string()), 0);
+
+    sampler.Sample(samples);
+
+    ASSERT_EQ(samples.size(), 1);
+    EXPECT_EQ(samples[0].mError, 0);
+    EXPECT_EQ(samples[0].mUsage.mRAM, 8192);
+    EXPECT_EQ(samples[0].mUsage.mIOReadBytes, 0);
+
+    fs::remove(mCGroup / "memory.current");
+
+    EXPECT_EQ(sampler.AddCGroup("broken", mCGroup.string()), ENOENT);
+    EXPECT_EQ(sampler.AddCGroup("missing", (mCGroup / "missing").string()), ENOENT);
+}
+
+TEST_F(ResourceSamplerTest, InvalidContent)
+{
+    ResourceSampler             sampler;
+    std::vector<ResourceSample> samples;
+
+    ASSERT_EQ(sampler.AddCGroup("service", mCGroup.string()), 0);
+
+    WriteFile("memory.current", "max\n");
+
+    sampler.Sample(samples);
+
+    ASSERT_EQ(samples.size(), 1);
+    EXPECT_EQ(samples[0].mError, EINVAL);
+}
+
+TEST_F(ResourceSamplerTest, LargeFile)
+{
+    ResourceSampler             sampler;
+    std::vector<ResourceSample> samples;
+
+    ASSERT_EQ(sampler.AddCGroup("service", mCGroup.string()), 0);
+
+    // Key at the end of a file bigger than initial buffer.
+    std::string content = "other 1\n";
+
+    content.resize(100000, ' ');
+    content += "\nusage_usec 42\n";
+
+    WriteFile("cpu.stat", content);
+
+    sampler.Sample(samples);
+
+    ASSERT_EQ(samples.size(), 1);
+    EXPECT_EQ(samples[0].mError, 0);
+    EXPECT_EQ(samples[0].mUsage.mCPUTimeUSec, 42);
+
+    // File of exactly max size is read completely.
+    content = "usage_usec 43\n";
+    content.resize(cMaxFileSize, ' ');
+
+    WriteFile("cpu.stat", content);
+
+    sampler.Sample(samples);
+
+    ASSERT_EQ(samples.size(), 1);
+    EXPECT_EQ(samples[0].mError, 0);
+    EXPECT_EQ(samples[0].mUsage.mCPUTimeUSec, 43);
+
+    // Bigger file would be truncated.
+    content += "\n";
+
+    WriteFile("cpu.stat", content);
+
+    sampler.Sample(samples);
+
+    ASSERT_EQ(samples.size(), 1);
+    EXPECT_EQ(samples[0].mError, EFBIG);
+}
+
+TEST_F(ResourceSamplerTest, Process)
+{
+    ResourceSampler             sampler;
+    std::vector<ResourceSample> samples;
+
+    ASSERT_EQ(sampler.AddProcess("self", getpid()), 0);
+    ASSERT_EQ(sampler.AddCGroup("service", mCGroup.string()), 0);
+
+    sampler.Sample(samples);
+
+    ASSERT_EQ(samples.size(), 2);
+    EXPECT_EQ(samples[0].mID, "self");
+    EXPECT_EQ(samples[0].mError, 0);
+    EXPECT_GT(samples[0].mUsage.mRAM, 0);
+
+    EXPECT_EQ(sampler.Remove("self"), 0);
+    EXPECT_EQ(sampler.Remove("self"), ENOENT);
+
+    sampler.Sample(samples);
+
+    ASSERT_EQ(samples.size(), 1);
+    EXPECT_EQ(samples[0].mID, "service");
+}
+
+TEST(ResourceSamplerParsersTest, ParseProcStat)
+{
+    uint64_t cpuTicks = 0, rssPages = 0;
+
+    // Process name with spaces and parentheses.
+    const auto stat = "1234 (my (app) x) S 1 1234 1234 0 -1 4194560 100 0 0 0 250 50 0 0 20 0 1 0 100 10000000 321 "
+                      "18446744073709551615 1 1 0 0 0 0 0 0 0 0 0 0 17\n";
+
+    EXPECT_TRUE(resourcesampler::ParseProcStat(stat, cpuTicks, rssPages));
+    EXPECT_EQ(cpuTicks, 300);
+    EXPECT_EQ(rssPages, 321);
+
+    EXPECT_FALSE(resourcesampler::ParseProcStat("1234 app S 1", cpuTicks, rssPages));
+    EXPECT_FALSE(resourcesampler::ParseProcStat("1234 (app) S 1 2 3", cpuTicks, rssPages));
+}
+
+TEST(ResourceSamplerParsersTest, KeyValues)
+{
+    uint64_t value = 0;
+
+    EXPECT_TRUE(resourcesampler::FindKeyValue("usage_usec_x 1\nusage_usec  7\n", "usage_usec", value));
+    EXPECT_EQ(value, 7);
+    EXPECT_FALSE(resourcesampler::FindKeyValue("usage_usec\n", "usage_usec", value));
+    EXPECT_TRUE(resourcesampler::FindKeyValue("rchar: 5\nread_bytes: 4096\n", "read_bytes:", value));
+    EXPECT_EQ(value, 4096);
+
+    EXPECT_EQ(resourcesampler::SumNestedKeyValue("8:0 rbytes=1 xrbytes=5 wbytes=2\n8:1 rbytes=3\n", "rbytes"), 4);
+    EXPECT_EQ(resourcesampler::SumNestedKeyValue("8:0 rbytes=", "rbytes"), 0);
+}
+
+} // namespace aos::common::utils
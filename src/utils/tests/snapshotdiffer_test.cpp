@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "utils/snapshotdiffer.hpp"
+
+using namespace testing;
+
+namespace aos::common::utils {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+size_t sCopyCount = 0;
+
+struct InstanceStatus {
+    InstanceStatus(std::string id, int state)
+        : mID(std::move(id))
+        , mState(state)
+    {
+    }
+
+    InstanceStatus(const InstanceStatus& other)
+        : mID(other.mID)
+        , mState(other.mState)
+    {
+        sCopyCount++;
+    }
+
+    InstanceStatus(InstanceStatus&&)            = default;
+    InstanceStatus& operator=(InstanceStatus&&) = default;
+
+    InstanceStatus& operator=(const InstanceStatus& other)
+    {
+        mID    = other.mID;
+        mState = other.mState;
+        sCopyCount++;
+
+        return *this;
+    }
+
+    bool operator==(const InstanceStatus& other) const { return mID == other.mID && mState == other.mState; }
+
+    std::string mID;
+    int         mState;
+};
+
+struct InstanceKey {
+    const std::string& operator()(const InstanceStatus& status) const { return status.mID; }
+};
+
+using InstanceDiffer = SnapshotDiffer<std::string, InstanceStatus, InstanceKey>;
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST(SnapshotDifferTest, Diff)
+{
+    InstanceDiffer        differ(0);
+    InstanceDiffer::Delta delta;
+
+    std::vector<InstanceStatus> snapshot {{"a", 1}, {"b", 1}};
+
+    ASSERT_TRUE(differ.Diff(snapshot, delta));
+    EXPECT_TRUE(delta.mFull);
+    EXPECT_EQ(delta.mSequence, 1u);
+    EXPECT_EQ(delta.mUpdated.size(), 2u);
+
+    EXPECT_FALSE(differ.Diff(snapshot, delta));
+
+    snapshot[1].mState = 2;
+    snapshot.emplace_back("c", 1);
+    snapshot.erase(snapshot.begin());
+
+    ASSERT_TRUE(differ.Diff(snapshot, delta));
+    EXPECT_FALSE(delta.mFull);
+    EXPECT_EQ(delta.mSequence, 2u);
+    ASSERT_EQ(delta.mUpdated.size(), 2u);
+    EXPECT_EQ(delta.mUpdated[0], InstanceStatus("b", 2));
+    EXPECT_EQ(delta.mUpdated[1], InstanceStatus("c", 1));
+    EXPECT_EQ(delta.mRemoved, std::vector<std::string> {"a"});
+
+    differ.RequestFull();
+
+    ASSERT_TRUE(differ.Diff(snapshot, delta));
+    EXPECT_TRUE(delta.mFull);
+    EXPECT_EQ(delta.mUpdated.size(), 2u);
+    EXPECT_TRUE(delta.mRemoved.empty());
+}
+
+TEST(SnapshotDifferTest, FullInterval)
+{
+    InstanceDiffer        differ(3);
+    InstanceDiffer::Delta delta;
+
+    std::vector<InstanceStatus> snapshot {{"a", 1}};
+
+    EXPECT_TRUE(differ.Diff(snapshot, delta));
+    EXPECT_FALSE(differ.Diff(snapshot, delta));
+    EXPECT_TRUE(differ.Diff(snapshot, delta));
+    EXPECT_TRUE(delta.mFull);
+}
+
+TEST(SnapshotDifferTest, UnchangedItemsAreNotCopied)
+{
+    InstanceDiffer        differ(0);
+    InstanceDiffer::Delta delta;
+
+    std::vector<InstanceStatus> snapshot;
+
+    for (auto i = 0; i < 100; i++) {
+        snapshot.emplace_back(std::to_string(i), 0);
+    }
+
+    differ.Diff(snapshot, delta);
+
+    sCopyCount = 0;
+
+    EXPECT_FALSE(differ.Diff(snapshot, delta));
+    EXPECT_EQ(sCopyCount, 0u);
+
+    // Changed item is copied into the previous snapshot and into the delta.
+    snapshot[10].mState = 1;
+
+    EXPECT_TRUE(differ.Diff(snapshot, delta));
+    EXPECT_EQ(sCopyCount, 2u);
+}
+
+} // namespace aos::common::utils
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utils/spscqueue.hpp"
+
+using namespace testing;
+
+namespace aos::common::utils {
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST(SPSCQueueTest, TryPushPop)
+{
+    SPSCQueue<int> queue(3);
+
+    ASSERT_EQ(queue.Capacity(), 4u);
+
+    for (auto i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.TryPush(int(i)));
+    }
+
+    EXPECT_FALSE(queue.TryPush(4));
+
+    int item = -1;
+
+    // Wrap around the ring several times.
+    for (auto i = 0; i < 20; i++) {
+        ASSERT_TRUE(queue.TryPop(item));
+        EXPECT_EQ(item, i);
+        ASSERT_TRUE(queue.TryPush(i + 4));
+    }
+
+    for (auto i = 20; i < 24; i++) {
+        ASSERT_TRUE(queue.TryPop(item));
+        EXPECT_EQ(item, i);
+    }
+
+    EXPECT_FALSE(queue.TryPop(item));
+}
+
+TEST(SPSCQueueTest, Batch)
+{
+    SPSCQueue<int>   queue(8);
+    std::vector<int> items {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    EXPECT_EQ(queue.TryPushBatch(items.data(), items.size()), 8u);
+
+    std::vector<int> popped(10, -1);
+
+    EXPECT_EQ(queue.TryPopBatch(popped.data(), 3), 3u);
+    EXPECT_EQ(queue.TryPushBatch(items.data() + 8, 2), 2u);
+    EXPECT_EQ(queue.TryPopBatch(popped.data() + 3, 10), 7u);
+
+    EXPECT_EQ(popped, items);
+    EXPECT_EQ(queue.TryPopBatch(popped.data(), 10), 0u);
+}
+
+TEST(SPSCQueueTest, MoveOnlyItems)
+{
+    SPSCQueue<std::unique_ptr<int>> queue(2);
+
+    ASSERT_TRUE(queue.Push(std::make_unique<int>(42)));
+
+    std::unique_ptr<int> item;
+
+    ASSERT_TRUE(queue.Pop(item));
+    ASSERT_NE(item, nullptr);
+    EXPECT_EQ(*item, 42);
+}
+
+TEST(SPSCQueueTest, CloseDrainsItems)
+{
+    SPSCQueue<int> queue(4);
+
+    ASSERT_TRUE(queue.Push(1));
+    ASSERT_TRUE(queue.Push(2));
+
+    queue.Close();
+
+    EXPECT_TRUE(queue.IsClosed());
+    EXPECT_FALSE(queue.Push(3));
+
+    int item = 0;
+
+    EXPECT_TRUE(queue.Pop(item));
+    EXPECT_EQ(item, 1);
+    EXPECT_TRUE(queue.Pop(item));
+    EXPECT_EQ(item, 2);
+    EXPECT_FALSE(queue.Pop(item));
+}
+
+TEST(SPSCQueueTest, CloseWakesBlockedCalls)
+{
+    SPSCQueue<int> consumerQueue(1);
+    SPSCQueue<int> producerQueue(1);
+
+    ASSERT_TRUE(producerQueue.Push(1));
+
+    std::thread consumer([&]() {
+        int item = 0;
+
+        EXPECT_FALSE(consumerQueue.Pop(item));
+    });
+
+    std::thread producer([&]() { EXPECT_FALSE(producerQueue.Push(2)); });
+
+    // Let both sides go past spinning and sleep.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    consumerQueue.Close();
+    producerQueue.Close();
+
+    consumer.join();
+    producer.join();
+}
+
+TEST(SPSCQueueTest, BlockingTransfer)
+{
+    constexpr size_t cItemCount = 200000;
+
+    SPSCQueue<size_t> queue(64);
+    std::atomic_bool  ordered {true};
+    size_t            received = 0;
+
+    std::thread consumer([&]() {
+        size_t items[16];
+
+        while (auto count = queue.PopBatch(items, 16)) {
+            for (size_t i = 0; i < count; i++) {
+                if (items[i] != received++) {
+                    ordered = false;
+                }
+            }
+        }
+    });
+
+    for (size_t i = 0; i < cItemCount; i++) {
+        // Producer occasionally pauses: consumer goes to sleep and should be woken up.
+        if (i % 50000 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+
+        ASSERT_TRUE(queue.Push(size_t(i)));
+    }
+
+    queue.Close();
+    consumer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(received, cItemCount);
+}
+
+TEST(SPSCQueueTest, SlowConsumer)
+{
+    constexpr size_t cItemCount = 1000;
+
+    SPSCQueue<size_t> queue(4);
+    size_t            received = 0;
+
+    std::thread producer([&]() {
+        for (size_t i = 0; i < cItemCount; i++) {
+            EXPECT_TRUE(queue.Push(size_t(i)));
+        }
+
+        queue.Close();
+    });
+
+    size_t item = 0;
+
+    while (queue.Pop(item)) {
+        EXPECT_EQ(item, received++);
+
+        // Producer waits on full queue and should be woken up.
+        if (received % 250 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+
+    producer.join();
+
+    EXPECT_EQ(received, cItemCount);
+}
+
+} // namespace aos::common::utils
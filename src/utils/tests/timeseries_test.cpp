@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utils/timeseries.hpp"
+
+using namespace testing;
+
+namespace aos::common::utils {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+using namespace std::chrono;
+
+void ExpectPoint(const TimeSeriesPoint& point, int64_t timestampMs, int64_t min, int64_t max, int64_t sum,
+    uint64_t count)
+{
+    EXPECT_EQ(point.mTimestampMs, timestampMs);
+    EXPECT_EQ(point.mMin, min);
+    EXPECT_EQ(point.mMax, max);
+    EXPECT_EQ(point.mSum, sum);
+    EXPECT_EQ(point.mCount, count);
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * Tests
+ **********************************************************************************************************************/
+
+TEST(TimeSeriesTest, Downsampling)
+{
+    TimeSeries series({{milliseconds(0), hours(1)}, {seconds(1), hours(1)}}, 4);
+
+    // 26 samples every 100 ms: two complete 1 s intervals and a pending one.
+    for (int64_t i = 0; i < 26; i++) {
+        ASSERT_EQ(series.Add(i * 100, i), 0);
+    }
+
+    std::vector<TimeSeriesPoint> points;
+
+    series.Query(0, 10000, points);
+    ASSERT_EQ(points.size(), 26);
+
+    for (int64_t i = 0; i < 26; i++) {
+        ExpectPoint(points[i], i * 100, i, i, i, 1);
+    }
+
+    series.Query(0, 10000, points, seconds(1));
+    ASSERT_EQ(points.size(), 3);
+
+    ExpectPoint(points[0], 0, 0, 9, 45, 10);
+    ExpectPoint(points[1], 1000, 10, 19, 145, 10);
+    ExpectPoint(points[2], 2000, 20, 25, 135, 6);
+    EXPECT_DOUBLE_EQ(points[2].Avg(), 22.5);
+
+    series.Query(1000, 1999, points, seconds(1));
+    ASSERT_EQ(points.size(), 1);
+    EXPECT_EQ(points[0].mTimestampMs, 1000);
+
+    // Full blocks are taken from summaries, boundary blocks are decoded.
+    ExpectPoint(series.Aggregate(0, 2500), 0, 0, 25, 325, 26);
+    ExpectPoint(series.Aggregate(150, 450), 150, 2, 4, 9, 3);
+    EXPECT_EQ(series.Aggregate(5000, 6000).mCount, 0);
+
+    EXPECT_EQ(series.Add(2400, 0), EINVAL);
+}
+
+TEST(TimeSeriesTest, Retention)
+{
+    TimeSeries series({{milliseconds(0), seconds(1)}}, 2);
+
+    for (int64_t i = 0; i <= 30; i++) {
+        ASSERT_EQ(series.Add(i * 100, i), 0);
+    }
+
+    std::vector<TimeSeriesPoint> points;
+
+    series.Query(0, 10000, points);
+    ASSERT_FALSE(points.empty());
+    EXPECT_GE(points.front().mTimestampMs, 2000 - 200);
+    EXPECT_EQ(points.back().mTimestampMs, 3000);
+}
+
+TEST(TimeSeriesTest, Merge)
+{
+    TimeSeriesPoint point;
+
+    point.Merge(TimeSeriesPoint {});
+    EXPECT_EQ(point.mCount, 0);
+    EXPECT_EQ(point.Avg(), 0.0);
+
+    point.Merge({0, -5, -5, -5, 1});
+    ExpectPoint(point, 0, -5, -5, -5, 1);
+
+    point.Merge({0, 3, 10, 20, 4});
+    ExpectPoint(point, 0, -5, 10, 15, 5);
+
+    TimeSeriesPoint max {0, INT64_MAX, INT64_MAX, INT64_MAX, 1};
+
+    max.Merge(max);
+    ExpectPoint(max, 0, INT64_MAX, INT64_MAX, INT64_MAX, 2);
+
+    TimeSeriesPoint min {0, INT64_MIN, INT64_MIN, INT64_MIN, 1};
+
+    min.Merge({0, -1, -1, -1, 1});
+    ExpectPoint(min, 0, INT64_MIN, -1, INT64_MIN, 2);
+
+    min.Merge(max);
+    ExpectPoint(min, 0, INT64_MIN, INT64_MAX, -1, 4);
+}
+
+TEST(TimeSeriesTest, ExtremeDeltas)
+{
+    const std::vector<std::pair<int64_t, int64_t>> samples = {
+        {INT64_MIN, INT64_MAX},
+        {INT64_MIN, INT64_MIN},
+        {-1, 0},
+        {0, -1},
+        {1, 1},
+        {INT64_MAX - 1, INT64_MAX},
+        {INT64_MAX, INT64_MIN},
+    };
+
+    TimeSeries series({{milliseconds(0), milliseconds(0)}});
+
+    for (const auto& [timestampMs, value] : samples) {
+        ASSERT_EQ(series.Add(timestampMs, value), 0);
+    }
+
+    std::vector<TimeSeriesPoint> points;
+
+    series.Query(INT64_MIN, INT64_MAX, points);
+    ASSERT_EQ(points.size(), samples.size());
+
+    for (size_t i = 0; i < samples.size(); i++) {
+        ExpectPoint(points[i], samples[i].first, samples[i].second, samples[i].second, samples[i].second, 1);
+    }
+
+    ExpectPoint(series.Aggregate(INT64_MIN, INT64_MAX), INT64_MIN, INT64_MIN, INT64_MAX, -2, samples.size());
+}
+
+TEST(TimeSeriesTest, DownsampledExtremeValues)
+{
+    TimeSeries series({{seconds(1), hours(1)}});
+
+    ASSERT_EQ(series.Add(0, INT64_MAX), 0);
+    ASSERT_EQ(series.Add(1, INT64_MAX), 0);
+    ASSERT_EQ(series.Add(1000, INT64_MIN), 0);
+    ASSERT_EQ(series.Add(1001, INT64_MIN), 0);
+    ASSERT_EQ(series.Add(2000, 0), 0);
+
+    std::vector<TimeSeriesPoint> points;
+
+    series.Query(0, 3000, points, seconds(1));
+    ASSERT_EQ(points.size(), 3);
+
+    ExpectPoint(points[0], 0, INT64_MAX, INT64_MAX, INT64_MAX, 2);
+    ExpectPoint(points[1], 1000, INT64_MIN, INT64_MIN, INT64_MIN, 2);
+    ExpectPoint(points[2], 2000, 0, 0, 0, 1);
+}
+
+TEST(TimeSeriesTest, Store)
+{
+    TimeSeriesStore store({{milliseconds(0), hours(1)}});
+
+    ASSERT_EQ(store.Add("cpu", 0, 10), 0);
+    ASSERT_EQ(store.Add("cpu", 100, 20), 0);
+    EXPECT_EQ(store.Add("cpu", 50, 0), EINVAL);
+
+    std::vector<TimeSeriesPoint> points;
+    TimeSeriesPoint              point;
+
+    ASSERT_EQ(store.Query("cpu", 0, 100, points), 0);
+    EXPECT_EQ(points.size(), 2);
+    ASSERT_EQ(store.Aggregate("cpu", 0, 100, point), 0);
+    EXPECT_EQ(point.mSum, 30);
+    EXPECT_GT(store.GetMemoryUsage(), 0);
+
+    store.Remove("cpu");
+
+    EXPECT_EQ(store.Query("cpu", 0, 100, points), ENOENT);
+    EXPECT_EQ(store.Aggregate("cpu", 0, 100, point), ENOENT);
+}
+
+} // namespace aos::common::utils
@@ -0,0 +1,470 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cerrno>
+
+#include "timeseries.hpp"
+
+namespace aos::common::utils {
+
+namespace {
+
+/***********************************************************************************************************************
+ * Consts
+ **********************************************************************************************************************/
+
+constexpr size_t cRawColumns         = 1;
+constexpr size_t cDownsampledColumns = 4;
+
+/***********************************************************************************************************************
+ * Static
+ **********************************************************************************************************************/
+
+void PutVarint(std::vector<uint8_t>& buffer, int64_t value)
+{
+    // Zigzag encoding keeps small negative deltas short.
+    auto encoded = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+
+    while (encoded >= 0x80) {
+        buffer.push_back(static_cast<uint8_t>(encoded | 0x80));
+        encoded >>= 7;
+    }
+
+    buffer.push_back(static_cast<uint8_t>(encoded));
+}
+
+int64_t GetVarint(const uint8_t*& data)
+{
+    uint64_t encoded = 0;
+    int      shift   = 0;
+
+    while (*data & 0x80) {
+        encoded |= static_cast<uint64_t>(*data++ & 0x7f) << shift;
+        shift += 7;
+    }
+
+    encoded |= static_cast<uint64_t>(*data++) << shift;
+
+    return static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+}
+
+// Deltas are computed modulo 2^64: signed overflow at extreme values is undefined, wrapped delta decodes back exactly.
+int64_t WrapSub(int64_t a, int64_t b)
+{
+    return static_cast<int64_t>(static_cast<uint64_t>(a) - static_cast<uint64_t>(b));
+}
+
+int64_t WrapAdd(int64_t a, int64_t b)
+{
+    return static_cast<int64_t>(static_cast<uint64_t>(a) + static_cast<uint64_t>(b));
+}
+
+int64_t AlignTime(int64_t timestampMs, int64_t resolutionMs)
+{
+    auto rem = timestampMs % resolutionMs;
+
+    return rem < 0 ? timestampMs - rem - resolutionMs : timestampMs - rem;
+}
+
+} // namespace
+
+/***********************************************************************************************************************
+ * TimeSeriesPoint
+ **********************************************************************************************************************/
+
+void TimeSeriesPoint::Merge(const TimeSeriesPoint& point)
+{
+    if (point.mCount == 0) {
+        return;
+    }
+
+    if (mCount == 0) {
+        mMin = point.mMin;
+        mMax = point.mMax;
+    } else {
+        mMin = std::min(mMin, point.mMin);
+        mMax = std::max(mMax, point.mMax);
+    }
+
+    int64_t sum = 0;
+
+    // Point may be this one: check its sum sign before it is overwritten.
+    mSum = __builtin_add_overflow(mSum, point.mSum, &sum) ? (point.mSum < 0 ? INT64_MIN : INT64_MAX) : sum;
+
+    mCount += point.mCount;
+}
+
+const std::vector<TimeSeriesTierConfig>& GetDefaultTimeSeriesTiers()
+{
+    using namespace std::chrono;
+
+    static const std::vector<TimeSeriesTierConfig> sTiers = {
+        {milliseconds(0), hours(1)},
+        {minutes(1), hours(24)},
+        {minutes(10), hours(24 * 7)},
+    };
+
+    return sTiers;
+}
+
+/***********************************************************************************************************************
+ * TimeSeries
+ **********************************************************************************************************************/
+
+TimeSeries::TimeSeries(const std::vector<TimeSeriesTierConfig>& tiers, size_t blockSize)
+    : mBlockSize(std::max<size_t>(blockSize, 1))
+{
+    for (const auto& config : tiers) {
+        mTiers.push_back(Tier {config, {}, {}});
+    }
+}
+
+int TimeSeries::Add(int64_t timestampMs, int64_t value)
+{
+    if (timestampMs < mLastMs) {
+        return EINVAL;
+    }
+
+    mLastMs = timestampMs;
+
+    TimeSeriesPoint point {timestampMs, value, value, value, 1};
+
+    for (auto& tier : mTiers) {
+        if (IsRaw(tier)) {
+            AppendPoint(tier, point);
+
+            continue;
+        }
+
+        auto intervalMs = AlignTime(timestampMs, tier.mConfig.mResolution.count());
+
+        if (tier.mPending.mCount != 0 && tier.mPending.mTimestampMs != intervalMs) {
+            AppendPoint(tier, tier.mPending);
+            tier.mPending = TimeSeriesPoint {};
+        }
+
+        if (tier.mPending.mCount == 0) {
+            tier.mPending.mTimestampMs = intervalMs;
+        }
+
+        tier.mPending.Merge(point);
+    }
+
+    return 0;
+}
+
+void TimeSeries::Query(int64_t fromMs, int64_t toMs, std::vector<TimeSeriesPoint>& points,
+    std::chrono::milliseconds resolution) const
+{
+    points.clear();
+
+    const Tier* selected = nullptr;
+
+    for (const auto& tier : mTiers) {
+        if (tier.mConfig.mResolution < resolution) {
+            continue;
+        }
+
+        selected = &tier;
+
+        if (CoversTime(tier, fromMs)) {
+            break;
+        }
+    }
+
+    if (selected == nullptr) {
+        return;
+    }
+
+    ForEachPoint(*selected, fromMs, toMs, [&points](const TimeSeriesPoint& point) { points.push_back(point); });
+}
+
+TimeSeriesPoint TimeSeries::Aggregate(int64_t fromMs, int64_t toMs) const
+{
+    TimeSeriesPoint result {fromMs};
+
+    const Tier* selected = nullptr;
+
+    for (const auto& tier : mTiers) {
+        selected = &tier;
+
+        if (CoversTime(tier, fromMs)) {
+            break;
+        }
+    }
+
+    if (selected == nullptr) {
+        return result;
+    }
+
+    for (const auto& block : selected->mBlocks) {
+        if (block.mLastMs < fromMs) {
+            continue;
+        }
+
+        if (block.mFirstMs > toMs) {
+            break;
+        }
+
+        if (block.mFirstMs >= fromMs && block.mLastMs <= toMs) {
+            result.Merge(block.mSummary);
+
+            continue;
+        }
+
+        block.ForEach([&](const TimeSeriesPoint& point) {
+            if (point.mTimestampMs >= fromMs && point.mTimestampMs <= toMs) {
+                result.Merge(point);
+            }
+        });
+    }
+
+    const auto& pending = selected->mPending;
+
+    if (pending.mCount != 0 && pending.mTimestampMs >= fromMs && pending.mTimestampMs <= toMs) {
+        result.Merge(pending);
+    }
+
+    return result;
+}
+
+size_t TimeSeries::GetMemoryUsage() const
+{
+    size_t size = sizeof(*this);
+
+    for (const auto& tier : mTiers) {
+        size += sizeof(tier);
+
+        for (const auto& block : tier.mBlocks) {
+            size += block.GetMemoryUsage();
+        }
+    }
+
+    return size;
+}
+
+/***********************************************************************************************************************
+ * TimeSeries private
+ **********************************************************************************************************************/
+
+void TimeSeries::AppendPoint(Tier& tier, const TimeSeriesPoint& point)
+{
+    if (tier.mBlocks.empty() || tier.mBlocks.back().Size() >= mBlockSize) {
+        if (!tier.mBlocks.empty()) {
+            tier.mBlocks.back().Seal();
+        }
+
+        tier.mBlocks.emplace_back(IsRaw(tier) ? cRawColumns : cDownsampledColumns);
+    }
+
+    tier.mBlocks.back().Append(point);
+
+    auto retentionMs = tier.mConfig.mRetention.count();
+    auto expiredMs   = point.mTimestampMs < INT64_MIN + retentionMs ? INT64_MIN : point.mTimestampMs - retentionMs;
+
+    while (tier.mBlocks.size() > 1 && tier.mBlocks.front().mLastMs < expiredMs) {
+        tier.mBlocks.pop_front();
+    }
+}
+
+bool TimeSeries::CoversTime(const Tier& tier, int64_t timestampMs) const
+{
+    if (!tier.mBlocks.empty()) {
+        return tier.mBlocks.front().mFirstMs <= timestampMs;
+    }
+
+    return tier.mPending.mCount != 0 && tier.mPending.mTimestampMs <= timestampMs;
+}
+
+template <typename F>
+void TimeSeries::ForEachPoint(const Tier& tier, int64_t fromMs, int64_t toMs, F&& func) const
+{
+    for (const auto& block : tier.mBlocks) {
+        if (block.mLastMs < fromMs) {
+            continue;
+        }
+
+        if (block.mFirstMs > toMs) {
+            return;
+        }
+
+        block.ForEach([&](const TimeSeriesPoint& point) {
+            if (point.mTimestampMs >= fromMs && point.mTimestampMs <= toMs) {
+                func(point);
+            }
+        });
+    }
+
+    if (tier.mPending.mCount != 0 && tier.mPending.mTimestampMs >= fromMs && tier.mPending.mTimestampMs <= toMs) {
+        func(tier.mPending);
+    }
+}
+
+/***********************************************************************************************************************
+ * TimeSeries::Block
+ **********************************************************************************************************************/
+
+TimeSeries::Block::Block(size_t columns)
+    : mPrevValues(columns)
+    , mColumns(columns)
+{
+}
+
+void TimeSeries::Block::Append(const TimeSeriesPoint& point)
+{
+    if (mCount == 0) {
+        mFirstMs = point.mTimestampMs;
+        PutVarint(mTimestamps, point.mTimestampMs);
+    } else {
+        // Samples usually come at regular interval: delta of delta is mostly zero and takes one byte.
+        auto deltaMs = WrapSub(point.mTimestampMs, mLastMs);
+
+        PutVarint(mTimestamps, WrapSub(deltaMs, mPrevDeltaMs));
+        mPrevDeltaMs = deltaMs;
+    }
+
+    const int64_t values[cDownsampledColumns]
+        = {point.mMin, point.mMax, point.mSum, static_cast<int64_t>(point.mCount)};
+
+    for (size_t i = 0; i < mColumns.size(); i++) {
+        PutVarint(mColumns[i], WrapSub(values[i], mPrevValues[i]));
+        mPrevValues[i] = values[i];
+    }
+
+    mLastMs               = point.mTimestampMs;
+    mSummary.mTimestampMs = mFirstMs;
+    mSummary.Merge(point);
+    mCount++;
+}
+
+void TimeSeries::Block::Seal()
+{
+    mTimestamps.shrink_to_fit();
+
+    for (auto& column : mColumns) {
+        column.shrink_to_fit();
+    }
+}
+
+size_t TimeSeries::Block::GetMemoryUsage() const
+{
+    auto size = sizeof(*this) + mTimestamps.capacity() + mPrevValues.capacity() * sizeof(int64_t);
+
+    for (const auto& column : mColumns) {
+        size += sizeof(column) + column.capacity();
+    }
+
+    return size;
+}
+
+template <typename F>
+void TimeSeries::Block::ForEach(F&& func) const
+{
+    const uint8_t* timestamps = mTimestamps.data();
+
+    std::vector<const uint8_t*> columns;
+
+    for (const auto& column : mColumns) {
+        columns.push_back(column.data());
+    }
+
+    int64_t timestampMs = 0, deltaMs = 0;
+    int64_t values[cDownsampledColumns] {};
+
+    for (size_t i = 0; i < mCount; i++) {
+        if (i == 0) {
+            timestampMs = GetVarint(timestamps);
+        } else {
+            deltaMs     = WrapAdd(deltaMs, GetVarint(timestamps));
+            timestampMs = WrapAdd(timestampMs, deltaMs);
+        }
+
+        for (size_t j = 0; j < columns.size(); j++) {
+            values[j] = WrapAdd(values[j], GetVarint(columns[j]));
+        }
+
+        if (columns.size() == cRawColumns) {
+            func(TimeSeriesPoint {timestampMs, values[0], values[0], values[0], 1});
+        } else {
+            func(TimeSeriesPoint {timestampMs, values[0], values[1], values[2], static_cast<uint64_t>(values[3])});
+        }
+    }
+}
+
+/***********************************************************************************************************************
+ * TimeSeriesStore
+ **********************************************************************************************************************/
+
+TimeSeriesStore::TimeSeriesStore(const std::vector<TimeSeriesTierConfig>& tiers, size_t blockSize)
+    : mTiers(tiers)
+    , mBlockSize(blockSize)
+{
+}
+
+int TimeSeriesStore::Add(const std::string& metric, int64_t timestampMs, int64_t value)
+{
+    std::lock_guard lock {mMutex};
+
+    auto it = mSeries.find(metric);
+    if (it == mSeries.end()) {
+        it = mSeries.emplace(metric, TimeSeries(mTiers, mBlockSize)).first;
+    }
+
+    return it->second.Add(timestampMs, value);
+}
+
+int TimeSeriesStore::Query(const std::string& metric, int64_t fromMs, int64_t toMs,
+    std::vector<TimeSeriesPoint>& points, std::chrono::milliseconds resolution) const
+{
+    std::lock_guard lock {mMutex};
+
+    auto it = mSeries.find(metric);
+    if (it == mSeries.end()) {
+        return ENOENT;
+    }
+
+    it->second.Query(fromMs, toMs, points, resolution);
+
+    return 0;
+}
+
+int TimeSeriesStore::Aggregate(const std::string& metric, int64_t fromMs, int64_t toMs, TimeSeriesPoint& point) const
+{
+    std::lock_guard lock {mMutex};
+
+    auto it = mSeries.find(metric);
+    if (it == mSeries.end()) {
+        return ENOENT;
+    }
+
+    point = it->second.Aggregate(fromMs, toMs);
+
+    return 0;
+}
+
+void TimeSeriesStore::Remove(const std::string& metric)
+{
+    std::lock_guard lock {mMutex};
+
+    mSeries.erase(metric);
+}
+
+size_t TimeSeriesStore::GetMemoryUsage() const
+{
+    std::lock_guard lock {mMutex};
+
+    size_t size = 0;
+
+    for (const auto& [metric, series] : mSeries) {
+        size += metric.capacity() + series.GetMemoryUsage();
+    }
+
+    return size;
+}
+
+} // namespace aos::common::utils
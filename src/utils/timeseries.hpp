@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2024 Renesas Electronics Corporation.
+ * Copyright (C) 2024 EPAM Systems, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TIMESERIES_HPP_
+#define TIMESERIES_HPP_
+
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace aos::common::utils {
+
+/**
+ * Time series point.
+ *
+ * Raw points have min = max = sum and count = 1, downsampled points aggregate all raw samples of their interval.
+ */
+struct TimeSeriesPoint {
+    int64_t  mTimestampMs = 0;
+    int64_t  mMin         = 0;
+    int64_t  mMax         = 0;
+    int64_t  mSum         = 0;
+    uint64_t mCount       = 0;
+
+    /**
+     * Returns average value.
+     *
+     * @return double.
+     */
+    double Avg() const { return mCount != 0 ? static_cast<double>(mSum) / static_cast<double>(mCount) : 0.0; }
+
+    /**
+     * Merges other point into this one.
+     *
+     * Sum saturates at int64 limits instead of overflowing, so average of points near the limits is approximate.
+     *
+     * @param point point to merge.
+     */
+    void Merge(const TimeSeriesPoint& point);
+};
+
+/**
+ * Time series tier config.
+ */
+struct TimeSeriesTierConfig {
+    // Zero resolution means raw samples.
+    std::chrono::milliseconds mResolution;
+    std::chrono::milliseconds mRetention;
+};
+
+/**
+ * Default tiers: raw samples for 1 hour, 1 minute for 24 hours, 10 minutes for 7 days.
+ */
+const std::vector<TimeSeriesTierConfig>& GetDefaultTimeSeriesTiers();
+
+/**
+ * Compact single metric time series.
+ *
+ * Samples are stored per tier in blocks of delta-of-delta encoded timestamps and delta encoded values (zigzag
+ * varints), one byte stream per column. Each block keeps its time range and value summary, so range queries skip
+ * blocks outside the range and aggregations use summaries of fully covered blocks without decoding them. Each sample
+ * is also accumulated into downsampled tiers; blocks older than tier retention are dropped.
+ *
+ * Not thread safe, see TimeSeriesStore.
+ */
+class TimeSeries {
+public:
+    /**
+     * Creates time series.
+     *
+     * @param tiers tiers ordered from finest to coarsest resolution.
+     * @param blockSize max number of points in one block.
+     */
+    explicit TimeSeries(
+        const std::vector<TimeSeriesTierConfig>& tiers = GetDefaultTimeSeriesTiers(), size_t blockSize = 128);
+
+    /**
+     * Adds sample.
+     *
+     * @param timestampMs sample timestamp, must not be less than previous sample timestamp.
+     * @param value sample value.
+     * @return int 0 on success or EINVAL for out of order sample.
+     */
+    int Add(int64_t timestampMs, int64_t value);
+
+    /**
+     * Returns points in [fromMs, toMs] range.
+     *
+     * Points are taken from the finest tier which still holds fromMs and has resolution not less than requested.
+     *
+     * @param fromMs range start.
+     * @param toMs range end.
+     * @param[out] points points.
+     * @param resolution min requested resolution.
+     */
+    void Query(int64_t fromMs, int64_t toMs, std::vector<TimeSeriesPoint>& points,
+        std::chrono::milliseconds resolution = std::chrono::milliseconds(0)) const;
+
+    /**
+     * Aggregates points in [fromMs, toMs] range into one point.
+     *
+     * @param fromMs range start.
+     * @param toMs range end.
+     * @return TimeSeriesPoint.
+     */
+    TimeSeriesPoint Aggregate(int64_t fromMs, int64_t toMs) const;
+
+    /**
+     * Returns approximate memory used by encoded data.
+     *
+     * @return size_t.
+     */
+    size_t GetMemoryUsage() const;
+
+private:
+    class Block {
+    public:
+        explicit Block(size_t columns);
+
+        void   Append(const TimeSeriesPoint& point);
+        void   Seal();
+        size_t Size() const { return mCount; }
+        size_t GetMemoryUsage() const;
+
+        template <typename F>
+        void ForEach(F&& func) const;
+
+        int64_t         mFirstMs = 0;
+        int64_t         mLastMs  = 0;
+        TimeSeriesPoint mSummary;
+
+    private:
+        size_t                            mCount       = 0;
+        int64_t                           mPrevDeltaMs = 0;
+        std::vector<int64_t>              mPrevValues;
+        std::vector<uint8_t>              mTimestamps;
+        std::vector<std::vector<uint8_t>> mColumns;
+    };
+
+    struct Tier {
+        TimeSeriesTierConfig mConfig;
+        std::deque<Block>    mBlocks;
+        // Not yet completed downsampled interval.
+        TimeSeriesPoint mPending;
+    };
+
+    static bool IsRaw(const Tier& tier) { return tier.mConfig.mResolution.count() == 0; }
+
+    void AppendPoint(Tier& tier, const TimeSeriesPoint& point);
+    bool CoversTime(const Tier& tier, int64_t timestampMs) const;
+
+    template <typename F>
+    void ForEachPoint(const Tier& tier, int64_t fromMs, int64_t toMs, F&& func) const;
+
+    size_t            mBlockSize;
+    std::vector<Tier> mTiers;
+    int64_t           mLastMs = INT64_MIN;
+};
+
+/**
+ * Thread-safe collection of named time series.
+ */
+class TimeSeriesStore {
+public:
+    /**
+     * Creates time series store.
+     *
+     * @param tiers tiers used for all metrics.
+     * @param blockSize max number of points in one block.
+     */
+    explicit TimeSeriesStore(
+        const std::vector<TimeSeriesTierConfig>& tiers = GetDefaultTimeSeriesTiers(), size_t blockSize = 128);
+
+    /**
+     * Adds metric sample.
+     *
+     * @param metric metric name.
+     * @param timestampMs sample timestamp.
+     * @param value sample value.
+     * @return int.
+     */
+    int Add(const std::string& metric, int64_t timestampMs, int64_t value);
+
+    /**
+     * Returns metric points in [fromMs, toMs] range.
+     *
+     * @param metric metric name.
+     * @param fromMs range start.
+     * @param toMs range end.
+     * @param[out] points points.
+     * @param resolution min requested resolution.
+     * @return int 0 on success or ENOENT if metric not found.
+     */
+    int Query(const std::string& metric, int64_t fromMs, int64_t toMs, std::vector<TimeSeriesPoint>& points,
+        std::chrono::milliseconds resolution = std::chrono::milliseconds(0)) const;
+
+    /**
+     * Aggregates metric points in [fromMs, toMs] range.
+     *
+     * @param metric metric name.
+     * @param fromMs range start.
+     * @param toMs range end.
+     * @param[out] point aggregated point.
+     * @return int 0 on success or ENOENT if metric not found.
+     */
+    int Aggregate(const std::string& metric, int64_t fromMs, int64_t toMs, TimeSeriesPoint& point) const;
+
+    /**
+     * Removes metric.
+     *
+     * @param metric metric name.
+     */
+    void Remove(const std::string& metric);
+
+    /**
+     * Returns approximate memory used by all metrics.
+     *
+     * @return size_t.
+     */
+    size_t GetMemoryUsage() const;
+
+private:
+    std::vector<TimeSeriesTierConfig> mTiers;
+    size_t                            mBlockSize;
+    mutable std::mutex                mMutex;
+    std::map<std::string, TimeSeries> mSeries;
+};
+
+} // namespace aos::common::utils
+
+#endif